@@ -75,6 +75,94 @@
  */
 #define CJ_CONTRAST_MAX_ITERATIONS 1
 
+/**
+ * Hot-path statistics (compiled out by default).
+ *
+ * Built with -DCJ_ENABLE_STATS, cj_journey_sample() times its four stages
+ * and the discrete path counts delta searches, fallbacks and contrast
+ * adjustments into a thread-local CJ_Stats (see cj_stats_snapshot). Thread
+ * storage uses the compiler's __thread / __declspec(thread) extension; this
+ * is the only non-C99 code and only exists in the stats build. Without the
+ * flag every CJ_STATS_* macro expands to nothing.
+ */
+#ifdef CJ_ENABLE_STATS
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define CJ_THREAD_LOCAL __declspec(thread)
+#else
+#define CJ_THREAD_LOCAL __thread
+#endif
+#include <time.h>
+
+static CJ_THREAD_LOCAL CJ_Stats cj_stats;
+
+static inline uint64_t cj_stats_ticks(void) {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    return __rdtsc();
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    return __builtin_ia32_rdtsc();
+#elif defined(__GNUC__) && defined(__aarch64__)
+    uint64_t ticks;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return (uint64_t)clock();
+#endif
+}
+
+#define CJ_STATS_ADD(field, n) (cj_stats.field += (uint64_t)(n))
+#define CJ_STATS_TIMER_START(timer) uint64_t timer = cj_stats_ticks()
+#define CJ_STATS_STAGE(stage, timer) do { \
+        const uint64_t cj_now = cj_stats_ticks(); \
+        cj_stats.stage_ticks[stage] += cj_now - (timer); \
+        (timer) = cj_now; \
+    } while (0)
+#else
+#define CJ_STATS_ADD(field, n) ((void)0)
+#define CJ_STATS_TIMER_START(timer) ((void)0)
+#define CJ_STATS_STAGE(stage, timer) ((void)0)
+#endif
+
+/**
+ * USDT tracepoints (compiled out by default).
+ *
+ * Built with -DCJ_ENABLE_USDT (needs <sys/sdt.h>, e.g. systemtap-sdt-dev),
+ * the library carries static probes under the "colorjourney" provider:
+ *
+ *   journey__create(journey, config_hash, anchor_count, waypoint_count)
+ *   journey__destroy(journey, config_hash)
+ *   discrete__start(journey, config_hash, kind, start, count)
+ *   discrete__end(journey, config_hash, kind, start, count)
+ *   delta__fallback(journey, config_hash, index, t_base_micro, best_de_micro)
+ *
+ * kind is 0 for cj_journey_discrete, 1 for cj_journey_discrete_at and 2 for
+ * cj_journey_discrete_range. config_hash is an FNV-1a hash of the config
+ * fields, computed once in cj_journey_create, so the same configuration
+ * hashes the same in every process. Float arguments are passed as integer
+ * millionths. An unattached probe is a single nop, e.g.
+ *
+ *   bpftrace -e 'usdt:./libcolorjourney.so:colorjourney:discrete__start
+ *       { @start[tid] = nsecs; @cfg[tid] = arg1; }
+ *     usdt:./libcolorjourney.so:colorjourney:discrete__end /@start[tid]/
+ *       { @ns[@cfg[tid]] = hist(nsecs - @start[tid]); delete(@start[tid]); }'
+ *
+ * Without the flag every CJ_PROBE* macro expands to nothing.
+ */
+#ifdef CJ_ENABLE_USDT
+#include <sys/sdt.h>
+#define CJ_PROBE2(name, a, b) DTRACE_PROBE2(colorjourney, name, a, b)
+#define CJ_PROBE4(name, a, b, c, d) DTRACE_PROBE4(colorjourney, name, a, b, c, d)
+#define CJ_PROBE5(name, a, b, c, d, e) DTRACE_PROBE5(colorjourney, name, a, b, c, d, e)
+#else
+#define CJ_PROBE2(name, a, b) ((void)0)
+#define CJ_PROBE4(name, a, b, c, d) ((void)0)
+#define CJ_PROBE5(name, a, b, c, d, e) ((void)0)
+#endif
+
+#define CJ_PROBE_DISCRETE 0
+#define CJ_PROBE_DISCRETE_AT 1
+#define CJ_PROBE_DISCRETE_RANGE 2
+
 /* ========================================================================
  * Fast Math Helpers
  * ======================================================================== */
@@ -297,6 +385,11 @@ typedef struct CJ_Journey_Impl {
     
     /* Variation state */
     uint64_t rng_state;
+
+#ifdef CJ_ENABLE_USDT
+    /* Configuration identity reported by the tracepoints */
+    uint64_t config_hash;
+#endif
 } CJ_Journey_Impl;
 
 /* ========================================================================
@@ -403,6 +496,38 @@ static void build_waypoints(CJ_Journey journey) {
     }
 }
 
+#ifdef CJ_ENABLE_USDT
+static uint64_t fnv1a(uint64_t hash, const void* data, size_t size) {
+    const unsigned char* bytes = (const unsigned char*)data;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+/* Field by field so struct padding does not leak into the hash. */
+static uint64_t config_hash(const CJ_Config* config) {
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    hash = fnv1a(hash, &config->anchor_count, sizeof(config->anchor_count));
+    hash = fnv1a(hash, config->anchors, sizeof(CJ_RGB) * (size_t)config->anchor_count);
+    hash = fnv1a(hash, &config->lightness_bias, sizeof(config->lightness_bias));
+    hash = fnv1a(hash, &config->lightness_custom_weight, sizeof(config->lightness_custom_weight));
+    hash = fnv1a(hash, &config->chroma_bias, sizeof(config->chroma_bias));
+    hash = fnv1a(hash, &config->chroma_custom_multiplier, sizeof(config->chroma_custom_multiplier));
+    hash = fnv1a(hash, &config->contrast_level, sizeof(config->contrast_level));
+    hash = fnv1a(hash, &config->contrast_custom_threshold, sizeof(config->contrast_custom_threshold));
+    hash = fnv1a(hash, &config->mid_journey_vibrancy, sizeof(config->mid_journey_vibrancy));
+    hash = fnv1a(hash, &config->temperature_bias, sizeof(config->temperature_bias));
+    hash = fnv1a(hash, &config->loop_mode, sizeof(config->loop_mode));
+    hash = fnv1a(hash, &config->variation_dimensions, sizeof(config->variation_dimensions));
+    hash = fnv1a(hash, &config->variation_strength, sizeof(config->variation_strength));
+    hash = fnv1a(hash, &config->variation_custom_magnitude, sizeof(config->variation_custom_magnitude));
+    hash = fnv1a(hash, &config->variation_seed, sizeof(config->variation_seed));
+    hash = fnv1a(hash, &config->variation_enabled, sizeof(config->variation_enabled));
+    return hash;
+}
+#endif
+
 CJ_Journey cj_journey_create(const CJ_Config* config) {
     CJ_Journey_Impl* j = (CJ_Journey_Impl*)malloc(sizeof(CJ_Journey_Impl));
     if (!j) return NULL;
@@ -419,6 +544,11 @@ CJ_Journey cj_journey_create(const CJ_Config* config) {
     
     /* Build designed waypoints */
     build_waypoints((CJ_Journey)j);
+
+#ifdef CJ_ENABLE_USDT
+    j->config_hash = config_hash(config);
+#endif
+    CJ_PROBE4(journey__create, j, j->config_hash, j->anchor_count, j->waypoint_count);
     
     return (CJ_Journey)j;
 }
@@ -426,6 +556,7 @@ CJ_Journey cj_journey_create(const CJ_Config* config) {
 void cj_journey_destroy(CJ_Journey journey) {
     if (!journey) return;
     CJ_Journey_Impl* j = (CJ_Journey_Impl*)journey;
+    CJ_PROBE2(journey__destroy, j, j->config_hash);
     free(j);
 }
 
@@ -607,21 +738,27 @@ static CJ_LCh apply_variation(CJ_Journey_Impl* j, CJ_LCh color, float t) {
 
 CJ_RGB cj_journey_sample(CJ_Journey journey, float t) {
     CJ_Journey_Impl* j = (CJ_Journey_Impl*)journey;
+    CJ_STATS_ADD(samples, 1);
+    CJ_STATS_TIMER_START(timer);
     
     /* Interpolate waypoints */
     CJ_LCh lch = interpolate_waypoints(j, t);
+    CJ_STATS_STAGE(CJ_STAGE_INTERPOLATE, timer);
     
     /* Apply dynamics */
     lch = apply_dynamics(j, lch, t);
+    CJ_STATS_STAGE(CJ_STAGE_DYNAMICS, timer);
     
     /* Apply variation */
     lch = apply_variation(j, lch, t);
+    CJ_STATS_STAGE(CJ_STAGE_VARIATION, timer);
     
     /* Convert to RGB */
     CJ_Lab lab = cj_lch_to_oklab(lch);
-    CJ_RGB rgb = cj_oklab_to_rgb(lab);
+    CJ_RGB rgb = cj_rgb_clamp(cj_oklab_to_rgb(lab));
+    CJ_STATS_STAGE(CJ_STAGE_CONVERT, timer);
     
-    return cj_rgb_clamp(rgb);
+    return rgb;
 }
 
 /* ========================================================================
@@ -721,8 +858,10 @@ static float binary_search_delta_position(CJ_Journey_Impl* j,
                                          bool increase_distance) {
     float tolerance = CJ_DELTA_TOLERANCE;
     int max_iterations = CJ_DELTA_MAX_ITERATIONS;
+    CJ_STATS_ADD(delta_searches, 1);
     
     for (int iteration = 0; iteration < max_iterations; iteration++) {
+        CJ_STATS_ADD(delta_search_iterations, 1);
         float t_mid = (t_min + t_max) * 0.5f;
         
         /* Sample color at midpoint */
@@ -798,6 +937,7 @@ static float enforce_delta_range(CJ_Journey_Impl* j,
     if (!previous || index <= 0) {
         return t_base;
     }
+    CJ_STATS_ADD(delta_checks, 1);
     
     /* Step 1-2: Get base color and convert to OKLab */
     CJ_RGB base_color = cj_journey_sample((CJ_Journey)j, t_base);
@@ -877,6 +1017,9 @@ static float enforce_delta_range(CJ_Journey_Impl* j,
     
     /* Last resort: move forward in t-space by a fixed amount */
     /* This ensures we at least try to get different colors */
+    CJ_STATS_ADD(delta_fallbacks, 1);
+    CJ_PROBE5(delta__fallback, j, j->config_hash, index,
+              (int64_t)(t_base * 1e6f), (int64_t)(best_de * 1e6f));
     return fmodf(t_base + 0.05f, 1.0f);
 }
 
@@ -901,6 +1044,7 @@ static CJ_RGB apply_minimum_contrast(CJ_RGB color,
                                      const CJ_RGB* previous,
                                      float min_delta_e) {
     if (!previous) return color;
+    CJ_STATS_ADD(contrast_checks, 1);
 
     CJ_Lab prev_lab = cj_rgb_to_oklab(*previous);
     CJ_Lab curr_lab = cj_rgb_to_oklab(color);
@@ -913,6 +1057,7 @@ static CJ_RGB apply_minimum_contrast(CJ_RGB color,
     }
     
     /* Calculate how much contrast we need */
+    CJ_STATS_ADD(contrast_adjustments, 1);
     float shortfall = min_delta_e - dE;
     
     /* Determine adjustment direction: push away from previous */
@@ -962,13 +1107,16 @@ CJ_RGB cj_journey_discrete_at(CJ_Journey journey, int index) {
 
     CJ_RGB previous;
     bool has_previous = false;
+    CJ_PROBE5(discrete__start, j, j->config_hash, CJ_PROBE_DISCRETE_AT, index, 1);
 
     for (int i = 0; i < index; i++) {
         previous = discrete_color_at_index(j, i, has_previous ? &previous : NULL, min_delta_e);
         has_previous = true;
     }
 
-    return discrete_color_at_index(j, index, has_previous ? &previous : NULL, min_delta_e);
+    CJ_RGB color = discrete_color_at_index(j, index, has_previous ? &previous : NULL, min_delta_e);
+    CJ_PROBE5(discrete__end, j, j->config_hash, CJ_PROBE_DISCRETE_AT, index, 1);
+    return color;
 }
 
 void cj_journey_discrete_range(CJ_Journey journey, int start, int count, CJ_RGB* out_colors) {
@@ -980,6 +1128,7 @@ void cj_journey_discrete_range(CJ_Journey journey, int start, int count, CJ_RGB*
 
     CJ_RGB previous;
     bool has_previous = false;
+    CJ_PROBE5(discrete__start, j, j->config_hash, CJ_PROBE_DISCRETE_RANGE, start, count);
 
     for (int i = 0; i < start; i++) {
         previous = discrete_color_at_index(j, i, has_previous ? &previous : NULL, min_delta_e);
@@ -992,6 +1141,7 @@ void cj_journey_discrete_range(CJ_Journey journey, int start, int count, CJ_RGB*
         previous = out_colors[i];
         has_previous = true;
     }
+    CJ_PROBE5(discrete__end, j, j->config_hash, CJ_PROBE_DISCRETE_RANGE, start, count);
 }
 
 void cj_journey_discrete(CJ_Journey journey, int count, CJ_RGB* out_colors) {
@@ -1001,6 +1151,7 @@ void cj_journey_discrete(CJ_Journey journey, int count, CJ_RGB* out_colors) {
 
     /* Determine contrast threshold */
     float min_delta_e = discrete_min_delta_e(j);
+    CJ_PROBE5(discrete__start, j, j->config_hash, CJ_PROBE_DISCRETE, 0, count);
     
     /* Generate evenly spaced samples using loop-mode-aware positioning */
     for (int i = 0; i < count; i++) {
@@ -1015,4 +1166,1561 @@ void cj_journey_discrete(CJ_Journey journey, int count, CJ_RGB* out_colors) {
 
         out_colors[i] = color;
     }
+    CJ_PROBE5(discrete__end, j, j->config_hash, CJ_PROBE_DISCRETE, 0, count);
+}
+
+/* ========================================================================
+ * Image Gradient Mapping
+ *
+ * Per pixel only OKLab L is needed, and only to pick one of
+ * CJ_GRADIENT_TABLE_SIZE entries (a step of ~1e-3 in L). The three cube
+ * roots dominate the cost of cj_rgb_to_oklab, so the mapper uses a float
+ * cube root from an exponent-bit estimate refined by two Newton steps
+ * (relative error ~1e-6, far below the table step). The row loop has no
+ * data-dependent branches, so compilers can vectorize the arithmetic.
+ * Tests/Accuracy/verify_accuracy.c checks the result over all sRGB8 inputs.
+ * ======================================================================== */
+
+static inline float fast_cbrtf(float x) {
+    uint32_t bits;
+    float y;
+    x = x > 1e-30f ? x : 1e-30f;
+    memcpy(&bits, &x, sizeof(bits));
+    bits = bits / 3u + 0x2A514067u;
+    memcpy(&y, &bits, sizeof(y));
+    y = (2.0f * y + x / (y * y)) * (1.0f / 3.0f);
+    y = (2.0f * y + x / (y * y)) * (1.0f / 3.0f);
+    return y;
+}
+
+/* cj_rgb_to_oklab in float with fast_cbrtf, for bulk analysis paths. */
+static inline CJ_Lab fast_rgb_to_oklab(float r, float g, float b) {
+    float l_ = fast_cbrtf(0.4122214708f * r + 0.5363325363f * g + 0.0514459929f * b);
+    float m_ = fast_cbrtf(0.2119034982f * r + 0.6806995451f * g + 0.1073969566f * b);
+    float s_ = fast_cbrtf(0.0883024619f * r + 0.2817188376f * g + 0.6299787005f * b);
+    CJ_Lab lab = {
+        0.2104542553f * l_ + 0.7936177850f * m_ - 0.0040720468f * s_,
+        1.9779984951f * l_ - 2.4285922050f * m_ + 0.4505937099f * s_,
+        0.0259040371f * l_ + 0.7827717662f * m_ - 0.8086757660f * s_
+    };
+    return lab;
+}
+
+/*
+ * 8-bit pixels are sRGB-encoded; CJ_RGB is linear. Bytes decode through a
+ * table of the exact sRGB curve. Encoding interpolates the curve (scaled
+ * to 255) along 32 segments per octave of [2^-9, 1), indexed by the float's
+ * exponent and top mantissa bits, with each chord shifted to halve its
+ * error. It is within 0.003 of the exact value, so it rounds to the same
+ * byte except at half-step ties, and every byte survives a decode/encode
+ * round trip. Below 2^-9 the curve is the linear 12.92 * x segment.
+ */
+static const float srgb8_to_linear[256] = {
+    0.0f, 0.000303526984f, 0.000607053967f, 0.000910580951f, 0.00121410793f, 0.00151763492f,
+    0.0018211619f, 0.00212468888f, 0.00242821587f, 0.00273174285f, 0.00303526984f, 0.00334653576f,
+    0.00367650732f, 0.00402471702f, 0.00439144204f, 0.00477695348f, 0.0051815167f, 0.00560539162f,
+    0.00604883302f, 0.00651209079f, 0.00699541019f, 0.00749903204f, 0.00802319299f, 0.00856812562f,
+    0.0091340587f, 0.00972121732f, 0.010329823f, 0.010960094f, 0.0116122452f, 0.0122864884f,
+    0.0129830323f, 0.013702083f, 0.0144438436f, 0.0152085144f, 0.0159962934f, 0.0168073758f,
+    0.0176419545f, 0.0185002201f, 0.019382361f, 0.0202885631f, 0.0212190104f, 0.0221738848f,
+    0.0231533662f, 0.0241576324f, 0.0251868596f, 0.0262412219f, 0.0273208916f, 0.0284260395f,
+    0.0295568344f, 0.0307134437f, 0.0318960331f, 0.0331047666f, 0.0343398068f, 0.0356013149f,
+    0.0368894504f, 0.0382043716f, 0.0395462353f, 0.0409151969f, 0.0423114106f, 0.0437350293f,
+    0.0451862044f, 0.0466650863f, 0.0481718242f, 0.049706566f, 0.0512694584f, 0.052860647f,
+    0.0544802764f, 0.05612849f, 0.0578054302f, 0.0595112382f, 0.0612460542f, 0.0630100177f,
+    0.0648032667f, 0.0666259386f, 0.0684781698f, 0.0703600957f, 0.0722718507f, 0.0742135684f,
+    0.0761853815f, 0.0781874218f, 0.0802198203f, 0.0822827071f, 0.0843762115f, 0.086500462f,
+    0.0886555863f, 0.0908417112f, 0.0930589628f, 0.0953074666f, 0.0975873471f, 0.0998987282f,
+    0.102241733f, 0.104616484f, 0.107023103f, 0.109461711f, 0.111932428f, 0.114435374f,
+    0.116970668f, 0.119538428f, 0.122138772f, 0.124771818f, 0.12743768f, 0.130136477f,
+    0.132868322f, 0.13563333f, 0.138431615f, 0.141263291f, 0.144128471f, 0.147027266f,
+    0.14995979f, 0.152926152f, 0.155926464f, 0.158960835f, 0.162029376f, 0.165132195f,
+    0.1682694f, 0.171441101f, 0.174647404f, 0.177888416f, 0.181164244f, 0.184474995f,
+    0.187820772f, 0.191201683f, 0.19461783f, 0.19806932f, 0.201556254f, 0.205078736f,
+    0.20863687f, 0.212230757f, 0.2158605f, 0.2195262f, 0.223227957f, 0.226965874f,
+    0.230740049f, 0.234550582f, 0.238397574f, 0.242281122f, 0.246201327f, 0.250158285f,
+    0.254152094f, 0.258182853f, 0.262250658f, 0.266355605f, 0.270497791f, 0.274677312f,
+    0.278894263f, 0.28314874f, 0.287440838f, 0.29177065f, 0.296138271f, 0.300543794f,
+    0.304987314f, 0.309468923f, 0.313988713f, 0.318546778f, 0.323143209f, 0.327778098f,
+    0.332451536f, 0.337163615f, 0.341914425f, 0.346704056f, 0.3515326f, 0.356400144f,
+    0.36130678f, 0.366252596f, 0.37123768f, 0.376262123f, 0.381326011f, 0.386429434f,
+    0.391572478f, 0.396755231f, 0.40197778f, 0.407240212f, 0.412542613f, 0.417885071f,
+    0.42326767f, 0.428690497f, 0.434153636f, 0.439657174f, 0.445201195f, 0.450785783f,
+    0.456411023f, 0.462077f, 0.467783796f, 0.473531496f, 0.479320183f, 0.48514994f,
+    0.49102085f, 0.496932995f, 0.502886458f, 0.508881321f, 0.514917665f, 0.520995573f,
+    0.527115126f, 0.533276404f, 0.539479489f, 0.545724461f, 0.552011402f, 0.55834039f,
+    0.564711506f, 0.571124829f, 0.57758044f, 0.584078418f, 0.590618841f, 0.597201788f,
+    0.603827339f, 0.610495571f, 0.617206562f, 0.623960392f, 0.630757136f, 0.637596874f,
+    0.644479682f, 0.651405637f, 0.658374817f, 0.665387298f, 0.672443157f, 0.67954247f,
+    0.686685312f, 0.693871761f, 0.701101892f, 0.70837578f, 0.715693501f, 0.723055129f,
+    0.73046074f, 0.737910409f, 0.74540421f, 0.752942217f, 0.760524505f, 0.768151147f,
+    0.775822218f, 0.783537792f, 0.79129794f, 0.799102738f, 0.806952258f, 0.814846572f,
+    0.822785754f, 0.830769877f, 0.838799012f, 0.846873232f, 0.854992608f, 0.863157213f,
+    0.871367119f, 0.879622397f, 0.887923118f, 0.896269353f, 0.904661174f, 0.913098652f,
+    0.921581856f, 0.930110858f, 0.938685728f, 0.947306537f, 0.955973353f, 0.964686248f,
+    0.97344529f, 0.98225055f, 0.991102097f, 1.0f
+};
+
+static const float srgb_encode_base[289] = {
+    6.43476563f, 6.63585205f, 6.83693848f, 7.0380249f, 7.23911133f, 7.44019775f,
+    7.64128418f, 7.84237061f, 8.04345703f, 8.24454346f, 8.44562988f, 8.64671631f,
+    8.84780273f, 9.04888916f, 9.24997559f, 9.45106201f, 9.65214844f, 9.85323486f,
+    10.0543213f, 10.2558377f, 10.4536875f, 10.6487367f, 10.8416508f, 11.0324921f,
+    11.2213201f, 11.4081913f, 11.5931598f, 11.7762773f, 11.9575933f, 12.137155f,
+    12.3150077f, 12.4911949f, 12.6660469f, 13.010447f, 13.3488126f, 13.6814222f,
+    14.0085342f, 14.3303884f, 14.6472079f, 14.9592011f, 15.2665623f, 15.5694737f,
+    15.8681058f, 16.1626188f, 16.4531634f, 16.7398814f, 17.0229067f, 17.3023655f,
+    17.5783773f, 17.851055f, 18.1205058f, 18.3868312f, 18.6501277f, 18.910487f,
+    19.1679965f, 19.4227391f, 19.6747942f, 19.9242374f, 20.1711407f, 20.4155733f,
+    20.657601f, 20.8972871f, 21.134692f, 21.3698737f, 21.6032731f, 22.0629921f,
+    22.514656f, 22.9586366f, 23.3952787f, 23.8249025f, 24.2478059f, 24.6642668f,
+    25.0745448f, 25.4788829f, 25.8775089f, 26.2706366f, 26.6584672f, 27.0411899f,
+    27.4189833f, 27.7920161f, 28.1604475f, 28.5244286f, 28.8841022f, 29.239604f,
+    29.5910627f, 29.9386007f, 30.2823346f, 30.6223752f, 30.9588284f, 31.2917951f,
+    31.6213715f, 31.9476498f, 32.2707181f, 32.5906606f, 32.9075582f, 33.2214881f,
+    33.5330389f, 34.1466902f, 34.7495891f, 35.3422321f, 35.9250794f, 36.4985583f,
+    37.0630666f, 37.6189752f, 38.1666307f, 38.7063573f, 39.2384592f, 39.7632217f,
+    40.2809134f, 40.7917869f, 41.2960806f, 41.7940196f, 42.2858167f, 42.7716731f,
+    43.2517798f, 43.7263177f, 44.1954587f, 44.6593664f, 45.118196f, 45.5720958f,
+    46.021207f, 46.4656641f, 46.9055959f, 47.3411252f, 47.7723696f, 48.1994416f,
+    48.6224491f, 49.0414953f, 49.4573657f, 50.2764919f, 51.0812654f, 51.8723489f,
+    52.6503567f, 53.4158592f, 54.1693874f, 54.9114363f, 55.6424687f, 56.3629173f,
+    57.0731881f, 57.7736621f, 58.4646975f, 59.1466318f, 59.8197832f, 60.484452f,
+    61.1409223f, 61.7894628f, 62.4303283f, 63.0637605f, 63.6899886f, 64.309231f,
+    64.9216952f, 65.5275787f, 66.1270702f, 66.7203493f, 67.3075877f, 67.8889496f,
+    68.4645918f, 69.0346646f, 69.5993118f, 70.1586714f, 70.7137918f, 71.807194f,
+    72.8814377f, 73.9374076f, 74.9759234f, 75.9977466f, 77.0035861f, 77.9941026f,
+    78.9699137f, 79.9315973f, 80.8796951f, 81.8147156f, 82.7371372f, 83.6474103f,
+    84.5459596f, 85.4331861f, 86.3094687f, 87.1751665f, 88.0306193f, 88.8761498f,
+    89.7120641f, 90.5386535f, 91.3561951f, 92.1649526f, 92.9651777f, 93.7571102f,
+    94.5409795f, 95.3170045f, 96.0853947f, 96.8463506f, 97.6000642f, 98.3467196f,
+    99.0877165f, 100.547233f, 101.981177f, 103.390727f, 104.77698f, 106.14095f,
+    107.483585f, 108.805766f, 110.108317f, 111.392011f, 112.657569f, 113.905672f,
+    115.136957f, 116.352026f, 117.551445f, 118.735751f, 119.905448f, 121.061015f,
+    122.202908f, 123.331556f, 124.447368f, 125.550732f, 126.642019f, 127.721581f,
+    128.789753f, 129.846856f, 130.893196f, 131.929065f, 132.954743f, 133.970497f,
+    134.976584f, 135.97325f, 136.962362f, 138.910583f, 140.824668f, 142.706192f,
+    144.556617f, 146.377299f, 148.169501f, 149.934401f, 151.673099f, 153.386624f,
+    155.075942f, 156.74196f, 158.385528f, 160.00745f, 161.608483f, 163.189341f,
+    164.750699f, 166.293197f, 167.817441f, 169.324005f, 170.813435f, 172.28625f,
+    173.742943f, 175.183985f, 176.609824f, 178.020888f, 179.417584f, 180.800303f,
+    182.169419f, 183.525288f, 184.868253f, 186.198642f, 187.518948f, 190.119512f,
+    192.674508f, 195.186042f, 197.656063f, 200.086382f, 202.478684f, 204.834543f,
+    207.155426f, 209.442708f, 211.697677f, 213.921543f, 216.115444f, 218.280451f,
+    220.417573f, 222.527765f, 224.611928f, 226.670916f, 228.705537f, 230.716559f,
+    232.704709f, 234.670681f, 236.615134f, 238.538694f, 240.441961f, 242.325505f,
+    244.189871f, 246.035579f, 247.86313f, 249.672998f, 251.465641f, 253.241497f,
+    255.0f
+};
+
+static const float srgb_encode_step[289] = {
+    0.201086426f, 0.201086426f, 0.201086426f, 0.201086426f, 0.201086426f, 0.201086426f,
+    0.201086426f, 0.201086426f, 0.201086426f, 0.201086426f, 0.201086426f, 0.201086426f,
+    0.201086426f, 0.201086426f, 0.201086426f, 0.201086426f, 0.201086426f, 0.201086426f,
+    0.201086426f, 0.19814435f, 0.195053117f, 0.192917914f, 0.190844987f, 0.188831428f,
+    0.186874509f, 0.184971678f, 0.183120537f, 0.181318833f, 0.179564448f, 0.177855387f,
+    0.176189771f, 0.174565826f, 0.344418221f, 0.338382331f, 0.332625208f, 0.327126439f,
+    0.321867626f, 0.316832143f, 0.312004918f, 0.307372254f, 0.302921674f, 0.298641783f,
+    0.294522153f, 0.290553217f, 0.286726185f, 0.28303296f, 0.279466075f, 0.276018627f,
+    0.272684224f, 0.269456942f, 0.266331277f, 0.26330211f, 0.260364674f, 0.25751452f,
+    0.254747495f, 0.252059715f, 0.249447542f, 0.246907568f, 0.24443659f, 0.242031604f,
+    0.239689782f, 0.237408459f, 0.235185129f, 0.233017422f, 0.459743168f, 0.451686222f,
+    0.444001384f, 0.436661408f, 0.429641735f, 0.422920172f, 0.416476599f, 0.410292735f,
+    0.404351923f, 0.398638955f, 0.393139907f, 0.387842014f, 0.382733539f, 0.377803676f,
+    0.373042455f, 0.368440663f, 0.36398977f, 0.359681865f, 0.355509603f, 0.351466151f,
+    0.347545143f, 0.343740644f, 0.340047109f, 0.336459353f, 0.332972521f, 0.329582061f,
+    0.326283703f, 0.323073431f, 0.319947473f, 0.316902273f, 0.313934483f, 0.311040942f,
+    0.613683503f, 0.602928771f, 0.592670743f, 0.58287305f, 0.573502911f, 0.5645307f,
+    0.555929563f, 0.547675094f, 0.539745062f, 0.532119164f, 0.524778817f, 0.517706977f,
+    0.510887981f, 0.504307403f, 0.497951936f, 0.491809281f, 0.485868052f, 0.480117689f,
+    0.474548387f, 0.469151025f, 0.463917108f, 0.458838711f, 0.453908434f, 0.449119354f,
+    0.444464992f, 0.439939271f, 0.43553649f, 0.431251292f, 0.427078638f, 0.423013784f,
+    0.41905226f, 0.415189846f, 0.819169198f, 0.804813352f, 0.791120528f, 0.778042176f,
+    0.765534542f, 0.753558077f, 0.742076936f, 0.731058543f, 0.72047322f, 0.710293867f,
+    0.700495679f, 0.691055906f, 0.681953638f, 0.673169621f, 0.66468609f, 0.65648663f,
+    0.648556039f, 0.640880226f, 0.6334461f, 0.626241486f, 0.619255045f, 0.612476199f,
+    0.605895068f, 0.599502413f, 0.593289585f, 0.587248472f, 0.581371465f, 0.575651412f,
+    0.570081587f, 0.564655658f, 0.559367657f, 0.554211953f, 1.09345969f, 1.07429694f,
+    1.05601921f, 1.03856171f, 1.02186602f, 1.00587935f, 0.990553869f, 0.975846079f,
+    0.961716368f, 0.948128562f, 0.93504955f, 0.922448964f, 0.910298894f, 0.898573638f,
+    0.887249484f, 0.876304517f, 0.865718449f, 0.855472467f, 0.845549099f, 0.835932094f,
+    0.826606314f, 0.81755764f, 0.808772884f, 0.800239714f, 0.791946583f, 0.783882665f,
+    0.776037801f, 0.768402447f, 0.760967623f, 0.753724877f, 0.746666242f, 0.739784203f,
+    1.45959358f, 1.43401437f, 1.40961653f, 1.38631356f, 1.36402748f, 1.34268785f,
+    1.32223078f, 1.30259824f, 1.28373734f, 1.26559979f, 1.24814141f, 1.23132164f,
+    1.21510324f, 1.1994519f, 1.18433597f, 1.16972619f, 1.15559549f, 1.14191874f,
+    1.12867264f, 1.11583547f, 1.10338705f, 1.09130852f, 1.07958228f, 1.06819186f,
+    1.05712186f, 1.04635782f, 1.03588619f, 1.02569421f, 1.01576991f, 1.006102f,
+    0.996679857f, 0.987493437f, 1.94832368f, 1.91417953f, 1.88161232f, 1.85050658f,
+    1.82075825f, 1.79227325f, 1.76496634f, 1.73876004f, 1.71358376f, 1.68937304f,
+    1.66606889f, 1.6436172f, 1.62196824f, 1.6010762f, 1.58089886f, 1.56139714f,
+    1.54253491f, 1.52427865f, 1.50659722f, 1.48946166f, 1.47284501f, 1.45672211f,
+    1.44106945f, 1.42586507f, 1.41108839f, 1.39672012f, 1.38274216f, 1.36913751f,
+    1.35589016f, 1.34298505f, 1.330408f, 1.3181456f, 2.60070009f, 2.55512312f,
+    2.51165112f, 2.47012994f, 2.43042068f, 2.39239777f, 2.35594742f, 2.3209662f,
+    2.2873599f, 2.25504246f, 2.22393516f, 2.19396574f, 2.16506784f, 2.13718033f,
+    2.1102468f, 2.08421513f, 2.05903708f, 2.03466789f, 2.01106601f, 1.98819279f,
+    1.96601222f, 1.94449072f, 1.92359694f, 1.90330152f, 1.88357702f, 1.86439769f,
+    1.84573935f, 1.82757931f, 1.80989622f, 1.79266997f, 1.77588161f, 1.75951327f,
+    0.0f
+};
+
+#define CJ_SRGB_ENCODE_FIRST (118u << 5) /* Exponent and top 5 mantissa bits of 2^-9 */
+
+static inline uint8_t linear_to_srgb8(float x) {
+    x = x > 0.0f ? x : 0.0f; /* NaN-safe: NaN encodes as 0 */
+    x = x < 1.0f ? x : 1.0f;
+    if (x < 0.001953125f) return (uint8_t)(x * (12.92f * 255.0f) + 0.5f);
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    const uint32_t i = (bits >> 18) - CJ_SRGB_ENCODE_FIRST;
+    const float frac = (float)(bits & 0x3FFFFu) * (1.0f / 262144.0f);
+    return (uint8_t)(srgb_encode_base[i] + srgb_encode_step[i] * frac + 0.5f);
+}
+
+void cj_gradient_table_bake(CJ_Journey journey, CJ_GradientTable* out) {
+    if (!journey || !out) return;
+
+    for (int i = 0; i < CJ_GRADIENT_TABLE_SIZE; i++) {
+        float t = (float)i / (float)(CJ_GRADIENT_TABLE_SIZE - 1);
+        CJ_RGB c = cj_rgb_clamp(cj_journey_sample(journey, t));
+        out->rgb[i][0] = linear_to_srgb8(c.r);
+        out->rgb[i][1] = linear_to_srgb8(c.g);
+        out->rgb[i][2] = linear_to_srgb8(c.b);
+    }
+}
+
+#define CJ_GRADIENT_CHUNK 64
+
+/*
+ * Called with constant channel layouts so each format gets its own loop.
+ * Works in chunks: decode sRGB bytes to linear float lanes, compute table
+ * indices in a pure arithmetic loop (the one compilers vectorize), then look
+ * up and store.
+ */
+static inline void gradient_map_row(const uint8_t* src,
+                                    uint8_t* dst,
+                                    int width,
+                                    int channels,
+                                    int r_offset,
+                                    int b_offset,
+                                    bool preserve_alpha,
+                                    const CJ_GradientTable* table) {
+    const float last = (float)(CJ_GRADIENT_TABLE_SIZE - 1);
+    float r[CJ_GRADIENT_CHUNK], g[CJ_GRADIENT_CHUNK], b[CJ_GRADIENT_CHUNK];
+    int index[CJ_GRADIENT_CHUNK];
+
+    for (int x0 = 0; x0 < width; x0 += CJ_GRADIENT_CHUNK) {
+        const int n = (width - x0 < CJ_GRADIENT_CHUNK) ? width - x0 : CJ_GRADIENT_CHUNK;
+        const uint8_t* p = src + (size_t)x0 * (size_t)channels;
+        uint8_t* q = dst + (size_t)x0 * (size_t)channels;
+
+        for (int i = 0; i < n; i++) {
+            r[i] = srgb8_to_linear[p[i * channels + r_offset]];
+            g[i] = srgb8_to_linear[p[i * channels + 1]];
+            b[i] = srgb8_to_linear[p[i * channels + b_offset]];
+        }
+        for (int i = 0; i < n; i++) {
+            float l_ = fast_cbrtf(0.4122214708f * r[i] + 0.5363325363f * g[i] + 0.0514459929f * b[i]);
+            float m_ = fast_cbrtf(0.2119034982f * r[i] + 0.6806995451f * g[i] + 0.1073969566f * b[i]);
+            float s_ = fast_cbrtf(0.0883024619f * r[i] + 0.2817188376f * g[i] + 0.6299787005f * b[i]);
+            float L = 0.2104542553f * l_ + 0.7936177850f * m_ - 0.0040720468f * s_;
+            index[i] = (int)(clampf(L, 0.0f, 1.0f) * last + 0.5f);
+        }
+        for (int i = 0; i < n; i++) {
+            const uint8_t* color = table->rgb[index[i]];
+            uint8_t* out = q + i * channels;
+            uint8_t alpha = (channels == 4 && preserve_alpha) ? p[i * channels + 3] : 255;
+            out[r_offset] = color[0];
+            out[1] = color[1];
+            out[b_offset] = color[2];
+            if (channels == 4) out[3] = alpha;
+        }
+    }
+}
+
+void cj_image_gradient_map(CJ_Journey journey,
+                           const uint8_t* src,
+                           uint8_t* dst,
+                           int width,
+                           int height,
+                           int stride,
+                           CJ_PixelFormat format,
+                           const CJ_GradientMapOptions* options) {
+    if (!src || !dst || width <= 0 || height <= 0) return;
+
+    const int channels = (format == CJ_PIXEL_RGB8) ? 3 : 4;
+    if (stride < width * channels) return;
+
+    bool preserve_alpha = options ? options->preserve_alpha : true;
+    const CJ_GradientTable* table = options ? options->table : NULL;
+    CJ_GradientTable baked;
+    if (!table) {
+        if (!journey) return;
+        cj_gradient_table_bake(journey, &baked);
+        table = &baked;
+    }
+
+    for (int y = 0; y < height; y++) {
+        const uint8_t* src_row = src + (size_t)y * (size_t)stride;
+        uint8_t* dst_row = dst + (size_t)y * (size_t)stride;
+        switch (format) {
+            case CJ_PIXEL_BGRA8:
+                gradient_map_row(src_row, dst_row, width, 4, 2, 0, preserve_alpha, table);
+                break;
+            case CJ_PIXEL_RGB8:
+                gradient_map_row(src_row, dst_row, width, 3, 0, 2, preserve_alpha, table);
+                break;
+            case CJ_PIXEL_RGBA8:
+            default:
+                gradient_map_row(src_row, dst_row, width, 4, 0, 2, preserve_alpha, table);
+                break;
+        }
+    }
+}
+
+/* ========================================================================
+ * Nearest Palette Color
+ *
+ * The k-d tree is implicit: palette points are reordered so that every
+ * range [lo, hi) has its splitting point at mid = (lo + hi) / 2, with
+ * smaller coordinates on the split axis to the left. Each node splits on
+ * the axis of widest spread in its range. Everything (points, grid) lives
+ * in the single allocation made by cj_palette_index_create.
+ * ======================================================================== */
+
+/* Ranges this small are scanned linearly instead of split further */
+#define CJ_PALETTE_LEAF_SIZE 8
+
+typedef struct {
+    float p[3];  /* OKLab L, a, b */
+    int index;   /* Position in the caller's palette */
+    int axis;    /* Split axis when this point is a node's median */
+} CJ_PaletteNode;
+
+typedef struct CJ_PaletteIndex_Impl {
+    int count;
+    int grid_resolution;
+    CJ_PaletteNode* nodes;
+    int32_t* grid;  /* grid_resolution³ palette positions, or NULL */
+} CJ_PaletteIndex_Impl;
+
+static void palette_swap(CJ_PaletteNode* a, CJ_PaletteNode* b) {
+    CJ_PaletteNode tmp = *a;
+    *a = *b;
+    *b = tmp;
+}
+
+/* Quickselect: place the k-th smallest (by axis) at k, smaller ones before it. */
+static void palette_select(CJ_PaletteNode* nodes, int lo, int hi, int k, int axis) {
+    hi--;
+    while (lo < hi) {
+        float pivot = nodes[(lo + hi) / 2].p[axis];
+        int i = lo;
+        int j = hi;
+        while (i <= j) {
+            while (nodes[i].p[axis] < pivot) i++;
+            while (nodes[j].p[axis] > pivot) j--;
+            if (i <= j) {
+                palette_swap(&nodes[i], &nodes[j]);
+                i++;
+                j--;
+            }
+        }
+        if (k <= j) {
+            hi = j;
+        } else if (k >= i) {
+            lo = i;
+        } else {
+            return;
+        }
+    }
+}
+
+static void palette_build(CJ_PaletteNode* nodes, int lo, int hi) {
+    if (hi - lo <= CJ_PALETTE_LEAF_SIZE) return;
+
+    float min[3] = {INFINITY, INFINITY, INFINITY};
+    float max[3] = {-INFINITY, -INFINITY, -INFINITY};
+    for (int i = lo; i < hi; i++) {
+        for (int a = 0; a < 3; a++) {
+            if (nodes[i].p[a] < min[a]) min[a] = nodes[i].p[a];
+            if (nodes[i].p[a] > max[a]) max[a] = nodes[i].p[a];
+        }
+    }
+    int axis = 0;
+    for (int a = 1; a < 3; a++) {
+        if (max[a] - min[a] > max[axis] - min[axis]) axis = a;
+    }
+
+    int mid = (lo + hi) / 2;
+    palette_select(nodes, lo, hi, mid, axis);
+    nodes[mid].axis = axis;
+    palette_build(nodes, lo, mid);
+    palette_build(nodes, mid + 1, hi);
+}
+
+typedef struct {
+    float q[3];
+    float best_d2;
+    int best_index;
+} CJ_PaletteQuery;
+
+static inline void palette_visit(const CJ_PaletteNode* node, CJ_PaletteQuery* query) {
+    float dL = query->q[0] - node->p[0];
+    float da = query->q[1] - node->p[1];
+    float db = query->q[2] - node->p[2];
+    float d2 = dL * dL + da * da + db * db;
+    if (d2 < query->best_d2 || (d2 == query->best_d2 && node->index < query->best_index)) {
+        query->best_d2 = d2;
+        query->best_index = node->index;
+    }
+}
+
+static void palette_search(const CJ_PaletteNode* nodes, int lo, int hi, CJ_PaletteQuery* query) {
+    while (hi - lo > CJ_PALETTE_LEAF_SIZE) {
+        int mid = (lo + hi) / 2;
+        const CJ_PaletteNode* node = &nodes[mid];
+        palette_visit(node, query);
+
+        float diff = query->q[node->axis] - node->p[node->axis];
+        int near_lo = diff < 0.0f ? lo : mid + 1;
+        int near_hi = diff < 0.0f ? mid : hi;
+        int far_lo = diff < 0.0f ? mid + 1 : lo;
+        int far_hi = diff < 0.0f ? hi : mid;
+
+        /* <= so an equally distant entry with a lower position is still found */
+        if (diff * diff <= query->best_d2) {
+            palette_search(nodes, near_lo, near_hi, query);
+            lo = far_lo;
+            hi = far_hi;
+            if (diff * diff > query->best_d2) return;
+        } else {
+            lo = near_lo;
+            hi = near_hi;
+        }
+    }
+    for (int i = lo; i < hi; i++) {
+        palette_visit(&nodes[i], query);
+    }
+}
+
+static int palette_nearest_lab(const CJ_PaletteIndex_Impl* impl, CJ_Lab lab, float* out_d2) {
+    CJ_PaletteQuery query = {{lab.L, lab.a, lab.b}, INFINITY, -1};
+    palette_search(impl->nodes, 0, impl->count, &query);
+    if (out_d2) *out_d2 = query.best_d2;
+    return query.best_index;
+}
+
+/*
+ * Grid axes are uniform in sRGB-encoded bytes rather than linear values, so
+ * cells stay perceptually small near black. Cell i of n covers the bytes v
+ * with v * n / 256 == i; its center is the middle of that byte range.
+ */
+static inline int palette_grid_coordinate(float v, int resolution) {
+    return ((int)linear_to_srgb8(v) * resolution) >> 8;
+}
+
+static float palette_grid_center(int cell, int resolution) {
+    int lo = (256 * cell + resolution - 1) / resolution;
+    int hi = (256 * (cell + 1) + resolution - 1) / resolution - 1;
+    float encoded = (float)(lo + hi) * (0.5f / 255.0f);
+    return encoded <= 0.04045f ? encoded / 12.92f : powf((encoded + 0.055f) / 1.055f, 2.4f);
+}
+
+CJ_PaletteIndex cj_palette_index_create(const CJ_RGB* palette, int count, int grid_resolution) {
+    if (!palette || count <= 0 || grid_resolution < 0 || grid_resolution > CJ_PALETTE_GRID_MAX) return NULL;
+
+    size_t cells = (size_t)grid_resolution * (size_t)grid_resolution * (size_t)grid_resolution;
+    size_t size = sizeof(CJ_PaletteIndex_Impl) + sizeof(CJ_PaletteNode) * (size_t)count + sizeof(int32_t) * cells;
+    CJ_PaletteIndex_Impl* impl = (CJ_PaletteIndex_Impl*)malloc(size);
+    if (!impl) return NULL;
+
+    impl->count = count;
+    impl->grid_resolution = grid_resolution;
+    impl->nodes = (CJ_PaletteNode*)(impl + 1);
+    impl->grid = cells ? (int32_t*)(impl->nodes + count) : NULL;
+
+    for (int i = 0; i < count; i++) {
+        CJ_Lab lab = cj_rgb_to_oklab(palette[i]);
+        impl->nodes[i].p[0] = lab.L;
+        impl->nodes[i].p[1] = lab.a;
+        impl->nodes[i].p[2] = lab.b;
+        impl->nodes[i].index = i;
+        impl->nodes[i].axis = 0;
+    }
+    palette_build(impl->nodes, 0, count);
+
+    /* Each cell holds the exact answer for its center */
+    float centers[CJ_PALETTE_GRID_MAX];
+    for (int i = 0; i < grid_resolution; i++) {
+        centers[i] = palette_grid_center(i, grid_resolution);
+    }
+    for (int r = 0; r < grid_resolution; r++) {
+        for (int g = 0; g < grid_resolution; g++) {
+            for (int b = 0; b < grid_resolution; b++) {
+                CJ_RGB center = {centers[r], centers[g], centers[b]};
+                size_t cell = ((size_t)r * (size_t)grid_resolution + (size_t)g) * (size_t)grid_resolution + (size_t)b;
+                impl->grid[cell] = palette_nearest_lab(impl, cj_rgb_to_oklab(center), NULL);
+            }
+        }
+    }
+
+    return (CJ_PaletteIndex)impl;
+}
+
+void cj_palette_index_destroy(CJ_PaletteIndex index) {
+    free(index);
+}
+
+int cj_palette_index_nearest(CJ_PaletteIndex index, CJ_RGB color, float* out_delta_e) {
+    const CJ_PaletteIndex_Impl* impl = (const CJ_PaletteIndex_Impl*)index;
+    if (!impl) return -1;
+
+    float d2;
+    int nearest = palette_nearest_lab(impl, cj_rgb_to_oklab(color), &d2);
+    if (out_delta_e) *out_delta_e = sqrtf(d2);
+    return nearest;
+}
+
+int cj_palette_index_nearest_approx(CJ_PaletteIndex index, CJ_RGB color) {
+    const CJ_PaletteIndex_Impl* impl = (const CJ_PaletteIndex_Impl*)index;
+    if (!impl) return -1;
+    if (!impl->grid) return cj_palette_index_nearest(index, color, NULL);
+
+    const int n = impl->grid_resolution;
+    size_t cell = ((size_t)palette_grid_coordinate(color.r, n) * (size_t)n +
+                   (size_t)palette_grid_coordinate(color.g, n)) * (size_t)n +
+                  (size_t)palette_grid_coordinate(color.b, n);
+    return impl->grid[cell];
+}
+
+void cj_palette_index_nearest_batch(CJ_PaletteIndex index,
+                                    const CJ_RGB* colors,
+                                    int count,
+                                    int* out_indices,
+                                    bool approximate) {
+    if (!index || !colors || !out_indices || count <= 0) return;
+
+    for (int i = 0; i < count; i++) {
+        out_indices[i] = approximate ? cj_palette_index_nearest_approx(index, colors[i])
+                                     : cj_palette_index_nearest(index, colors[i], NULL);
+    }
+}
+
+/* ========================================================================
+ * Anchor Extraction
+ *
+ * Samples are kept as separate L, a, b arrays. Seeding updates a running
+ * minimum distance per sample, one center at a time, in a branch-free loop
+ * over contiguous floats. Each Lloyd iteration is a single pass: every
+ * sample finds its nearest center (at most 8, held in registers) and is
+ * added to that center's sums, so no per-sample labels are stored.
+ * Decoding uses the gradient mapper's sRGB table and fast cube root
+ * (k-means moves centers by far more than its error).
+ * ======================================================================== */
+
+#define CJ_EXTRACT_MAX_K 8
+#define CJ_EXTRACT_ITERATIONS 16
+#define CJ_EXTRACT_SEED 0x123456789ABCDEF0ULL
+
+/* Squared distance from every sample to a new center, kept where smaller. */
+static void extract_nearer(const float* L, const float* a, const float* b, int n,
+                           const float center[3], float* best) {
+    for (int i = 0; i < n; i++) {
+        float dL = L[i] - center[0];
+        float da = a[i] - center[1];
+        float db = b[i] - center[2];
+        float d2 = dL * dL + da * da + db * db;
+        best[i] = d2 < best[i] ? d2 : best[i];
+    }
+}
+
+int cj_extract_anchors(const uint8_t* pixels,
+                       int width,
+                       int height,
+                       int stride,
+                       CJ_PixelFormat format,
+                       int k,
+                       CJ_RGB* out_anchors) {
+    if (!pixels || !out_anchors || width <= 0 || height <= 0 || k < 1 || k > CJ_EXTRACT_MAX_K) return 0;
+
+    const int channels = (format == CJ_PIXEL_RGB8) ? 3 : 4;
+    const int r_offset = (format == CJ_PIXEL_BGRA8) ? 2 : 0;
+    const int b_offset = 2 - r_offset;
+    if (stride < width * channels) return 0;
+
+    /* Square grid step so that at most CJ_EXTRACT_MAX_SAMPLES pixels are read */
+    const double total = (double)width * (double)height;
+    int step = (int)ceil(sqrt(total / (double)CJ_EXTRACT_MAX_SAMPLES));
+    if (step < 1) step = 1;
+    while ((double)((width + step - 1) / step) * (double)((height + step - 1) / step) > CJ_EXTRACT_MAX_SAMPLES) {
+        step++;
+    }
+    /* Center each sample in its cell, but never past the last row or column:
+     * a 1-pixel-high strip still needs its only row read */
+    const int offset_x = step / 2 < width ? step / 2 : width - 1;
+    const int offset_y = step / 2 < height ? step / 2 : height - 1;
+    const size_t capacity = (size_t)((width - offset_x + step - 1) / step) *
+                            (size_t)((height - offset_y + step - 1) / step);
+
+    float* L = (float*)malloc(capacity * 4 * sizeof(float));
+    if (!L) return 0;
+    float* a = L + capacity;
+    float* b = a + capacity;
+    float* best = b + capacity;
+
+    int n = 0;
+    for (int y = offset_y; y < height; y += step) {
+        const uint8_t* row = pixels + (size_t)y * (size_t)stride;
+        for (int x = offset_x; x < width; x += step) {
+            const uint8_t* p = row + (size_t)x * (size_t)channels;
+            if (channels == 4 && p[3] == 0) continue;
+            CJ_Lab lab = fast_rgb_to_oklab(srgb8_to_linear[p[r_offset]], srgb8_to_linear[p[1]],
+                                           srgb8_to_linear[p[b_offset]]);
+            L[n] = lab.L;
+            a[n] = lab.a;
+            b[n] = lab.b;
+            n++;
+        }
+    }
+    if (n == 0) {
+        free(L);
+        return 0;
+    }
+
+    /* k-means++ seeding: each new center drawn with probability ∝ squared distance */
+    uint64_t rng = CJ_EXTRACT_SEED;
+    float centers[CJ_EXTRACT_MAX_K][3];
+    int first = (int)(xoshiro_float(&rng) * (float)n);
+    centers[0][0] = L[first];
+    centers[0][1] = a[first];
+    centers[0][2] = b[first];
+    for (int i = 0; i < n; i++) {
+        best[i] = INFINITY;
+    }
+    extract_nearer(L, a, b, n, centers[0], best);
+
+    int clusters = 1;
+    while (clusters < k) {
+        double sum = 0.0;
+        for (int i = 0; i < n; i++) sum += best[i];
+        if (sum <= 0.0) break; /* Every sample sits on a center: fewer distinct colors than k */
+
+        double target = xoshiro_float(&rng) * sum;
+        int pick = -1;
+        for (int i = 0; i < n; i++) {
+            if (best[i] <= 0.0f) continue;
+            pick = i;
+            target -= best[i];
+            if (target < 0.0) break;
+        }
+        centers[clusters][0] = L[pick];
+        centers[clusters][1] = a[pick];
+        centers[clusters][2] = b[pick];
+        extract_nearer(L, a, b, n, centers[clusters], best);
+        clusters++;
+    }
+
+    /* Lloyd iterations: assign and accumulate in one pass, then move the centers */
+    int population[CJ_EXTRACT_MAX_K];
+    for (int iteration = 0; iteration < CJ_EXTRACT_ITERATIONS; iteration++) {
+        double sums[CJ_EXTRACT_MAX_K][3] = {{0.0}};
+        memset(population, 0, sizeof(population));
+        for (int i = 0; i < n; i++) {
+            float nearest_d2 = INFINITY;
+            int nearest = 0;
+            for (int c = 0; c < clusters; c++) {
+                float dL = L[i] - centers[c][0];
+                float da = a[i] - centers[c][1];
+                float db = b[i] - centers[c][2];
+                float d2 = dL * dL + da * da + db * db;
+                if (d2 < nearest_d2) {
+                    nearest_d2 = d2;
+                    nearest = c;
+                }
+            }
+            sums[nearest][0] += L[i];
+            sums[nearest][1] += a[i];
+            sums[nearest][2] += b[i];
+            population[nearest]++;
+        }
+
+        float moved = 0.0f;
+        for (int c = 0; c < clusters; c++) {
+            if (population[c] == 0) continue; /* Keep an emptied center where it was */
+            float next[3] = {
+                (float)(sums[c][0] / population[c]),
+                (float)(sums[c][1] / population[c]),
+                (float)(sums[c][2] / population[c])
+            };
+            moved = fmaxf(moved, fabsf(next[0] - centers[c][0]) + fabsf(next[1] - centers[c][1]) +
+                                 fabsf(next[2] - centers[c][2]));
+            memcpy(centers[c], next, sizeof(next));
+        }
+        if (moved < 1e-5f) break;
+    }
+    free(L);
+
+    /* Largest cluster first; empty clusters are dropped */
+    int written = 0;
+    bool used[CJ_EXTRACT_MAX_K] = {false};
+    for (int out = 0; out < clusters; out++) {
+        int largest = -1;
+        for (int c = 0; c < clusters; c++) {
+            if (!used[c] && population[c] > 0 && (largest < 0 || population[c] > population[largest])) largest = c;
+        }
+        if (largest < 0) break;
+        used[largest] = true;
+        CJ_Lab center = {centers[largest][0], centers[largest][1], centers[largest][2]};
+        out_anchors[written++] = cj_rgb_clamp(cj_oklab_to_rgb(center));
+    }
+    return written;
+}
+
+/* ========================================================================
+ * Color Vision Deficiency
+ *
+ * Machado et al. (2009) severity-1.0 matrices, in linear RGB. Rows sum to
+ * ~1, so neutral grays are unchanged. The palette check converts simulated
+ * colors with the fast float cube root; its ~1e-6 relative error is far
+ * below any contrast threshold.
+ * ======================================================================== */
+
+static const float cvd_matrices[3][3][3] = {
+    { /* Protanopia */
+        { 0.152286f,  1.052583f, -0.204868f},
+        { 0.114503f,  0.786281f,  0.099216f},
+        {-0.003882f, -0.048116f,  1.051998f}
+    },
+    { /* Deuteranopia */
+        { 0.367322f,  0.860646f, -0.227968f},
+        { 0.280085f,  0.672501f,  0.047413f},
+        {-0.011820f,  0.042940f,  0.968881f}
+    },
+    { /* Tritanopia */
+        { 1.255528f, -0.076749f, -0.178779f},
+        {-0.078411f,  0.930809f,  0.147602f},
+        { 0.004733f,  0.691367f,  0.303900f}
+    }
+};
+
+/* Unknown types fall back to protan rather than reading past the table */
+static inline int cvd_kind(CJ_CVDType type) {
+    return (type == CJ_CVD_DEUTAN || type == CJ_CVD_TRITAN) ? (int)type : (int)CJ_CVD_PROTAN;
+}
+
+static inline CJ_RGB cvd_apply(const float m[3][3], CJ_RGB c) {
+    CJ_RGB out = {
+        m[0][0] * c.r + m[0][1] * c.g + m[0][2] * c.b,
+        m[1][0] * c.r + m[1][1] * c.g + m[1][2] * c.b,
+        m[2][0] * c.r + m[2][1] * c.g + m[2][2] * c.b
+    };
+    return cj_rgb_clamp(out);
+}
+
+/* Simulated color in OKLab, via the fast cube root (~1e-6 relative error) */
+static inline CJ_Lab cvd_oklab(const float m[3][3], CJ_RGB c) {
+    CJ_RGB simulated = cvd_apply(m, c);
+    return fast_rgb_to_oklab(simulated.r, simulated.g, simulated.b);
+}
+
+CJ_RGB cj_cvd_simulate(CJ_RGB color, CJ_CVDType type) {
+    return cvd_apply(cvd_matrices[cvd_kind(type)], color);
+}
+
+void cj_cvd_simulate_batch(const CJ_RGB* colors, int count, CJ_CVDType type, CJ_RGB* out) {
+    if (!colors || !out || count <= 0) return;
+
+    const int kind = cvd_kind(type);
+    for (int i = 0; i < count; i++) {
+        out[i] = cvd_apply(cvd_matrices[kind], colors[i]);
+    }
+}
+
+float cj_palette_cvd_min_delta_e(const CJ_RGB* palette, int count, CJ_CVDType type, bool all_pairs) {
+    if (!palette || count < 2) return 0.0f;
+
+    const float (*m)[3] = cvd_matrices[cvd_kind(type)];
+
+    if (!all_pairs) {
+        CJ_Lab previous = cvd_oklab(m, palette[0]);
+        float min_de = INFINITY;
+        for (int i = 1; i < count; i++) {
+            CJ_Lab current = cvd_oklab(m, palette[i]);
+            min_de = fminf(min_de, cj_delta_e(previous, current));
+            previous = current;
+        }
+        return min_de;
+    }
+
+    CJ_Lab* labs = (CJ_Lab*)malloc(sizeof(CJ_Lab) * (size_t)count);
+    if (!labs) return 0.0f;
+    for (int i = 0; i < count; i++) {
+        labs[i] = cvd_oklab(m, palette[i]);
+    }
+
+    /* Compare squared distances; one sqrt at the end */
+    float min_d2 = INFINITY;
+    for (int i = 0; i < count - 1; i++) {
+        const CJ_Lab p = labs[i];
+        for (int j = i + 1; j < count; j++) {
+            float dL = p.L - labs[j].L;
+            float da = p.a - labs[j].a;
+            float db = p.b - labs[j].b;
+            float d2 = dL * dL + da * da + db * db;
+            min_d2 = d2 < min_d2 ? d2 : min_d2;
+        }
+    }
+    free(labs);
+    return sqrtf(min_d2);
+}
+
+/* ========================================================================
+ * Contrast Evaluation
+ *
+ * Both metrics split into a per-color term and a cheap per-pair formula.
+ * Backgrounds are processed in chunks of CJ_CONTRAST_CHUNK whose terms sit
+ * on the stack, so nothing is allocated; each color's term is computed
+ * once per chunk, and the pair loop over a chunk is branch-light arithmetic.
+ * ======================================================================== */
+
+#define CJ_CONTRAST_CHUNK 64
+
+static inline float wcag_luminance(CJ_RGB c) {
+    c = cj_rgb_clamp(c);
+    return 0.2126f * c.r + 0.7152f * c.g + 0.0722f * c.b;
+}
+
+void cj_contrast_wcag_batch(const CJ_RGB* colors,
+                            int color_count,
+                            const CJ_RGB* backgrounds,
+                            int background_count,
+                            float* out_ratios,
+                            float min_ratio,
+                            bool* out_pass) {
+    if (!colors || !backgrounds || color_count <= 0 || background_count <= 0) return;
+    if (!out_ratios && !out_pass) return;
+
+    float bg[CJ_CONTRAST_CHUNK];
+    for (int j0 = 0; j0 < background_count; j0 += CJ_CONTRAST_CHUNK) {
+        const int m = (background_count - j0 < CJ_CONTRAST_CHUNK) ? background_count - j0 : CJ_CONTRAST_CHUNK;
+        for (int j = 0; j < m; j++) {
+            bg[j] = wcag_luminance(backgrounds[j0 + j]) + 0.05f;
+        }
+        for (int i = 0; i < color_count; i++) {
+            const float fg = wcag_luminance(colors[i]) + 0.05f;
+            const size_t row = (size_t)i * (size_t)background_count + (size_t)j0;
+            for (int j = 0; j < m; j++) {
+                float ratio = fg > bg[j] ? fg / bg[j] : bg[j] / fg;
+                if (out_ratios) out_ratios[row + j] = ratio;
+                if (out_pass) out_pass[row + j] = ratio >= min_ratio;
+            }
+        }
+    }
+}
+
+/* APCA 0.0.98G-4g constants */
+#define APCA_BLACK_THRESHOLD 0.022f
+#define APCA_BLACK_CLAMP 1.414f
+#define APCA_DELTA_Y_MIN 0.0005f
+#define APCA_SCALE 1.14f
+#define APCA_OFFSET 0.027f
+#define APCA_LOW_CLIP 0.1f
+
+/* Per-color APCA terms: screen luminance and its four polarity powers */
+typedef struct {
+    float y;
+    float normal_bg, normal_text;    /* y^0.56, y^0.57 (dark text on light) */
+    float reverse_bg, reverse_text;  /* y^0.65, y^0.62 (light text on dark) */
+} CJ_APCATerms;
+
+static inline float srgb_encode(float x) {
+    return x <= 0.0031308f ? 12.92f * x : 1.055f * powf(x, 1.0f / 2.4f) - 0.055f;
+}
+
+static CJ_APCATerms apca_terms(CJ_RGB c) {
+    c = cj_rgb_clamp(c);
+    float y = 0.2126729f * powf(srgb_encode(c.r), 2.4f) +
+              0.7151522f * powf(srgb_encode(c.g), 2.4f) +
+              0.0721750f * powf(srgb_encode(c.b), 2.4f);
+    /* Soft clamp near black, for flare */
+    if (y < APCA_BLACK_THRESHOLD) y += powf(APCA_BLACK_THRESHOLD - y, APCA_BLACK_CLAMP);
+
+    CJ_APCATerms terms = {y, powf(y, 0.56f), powf(y, 0.57f), powf(y, 0.65f), powf(y, 0.62f)};
+    return terms;
+}
+
+static inline float apca_lc(const CJ_APCATerms* text, const CJ_APCATerms* bg) {
+    if (fabsf(bg->y - text->y) < APCA_DELTA_Y_MIN) return 0.0f;
+
+    if (bg->y > text->y) {
+        float sapc = (bg->normal_bg - text->normal_text) * APCA_SCALE;
+        return sapc < APCA_LOW_CLIP ? 0.0f : (sapc - APCA_OFFSET) * 100.0f;
+    }
+    float sapc = (bg->reverse_bg - text->reverse_text) * APCA_SCALE;
+    return sapc > -APCA_LOW_CLIP ? 0.0f : (sapc + APCA_OFFSET) * 100.0f;
+}
+
+void cj_contrast_apca_batch(const CJ_RGB* colors,
+                            int color_count,
+                            const CJ_RGB* backgrounds,
+                            int background_count,
+                            float* out_lc,
+                            float min_lc,
+                            bool* out_pass) {
+    if (!colors || !backgrounds || color_count <= 0 || background_count <= 0) return;
+    if (!out_lc && !out_pass) return;
+
+    CJ_APCATerms bg[CJ_CONTRAST_CHUNK];
+    for (int j0 = 0; j0 < background_count; j0 += CJ_CONTRAST_CHUNK) {
+        const int m = (background_count - j0 < CJ_CONTRAST_CHUNK) ? background_count - j0 : CJ_CONTRAST_CHUNK;
+        for (int j = 0; j < m; j++) {
+            bg[j] = apca_terms(backgrounds[j0 + j]);
+        }
+        for (int i = 0; i < color_count; i++) {
+            const CJ_APCATerms text = apca_terms(colors[i]);
+            const size_t row = (size_t)i * (size_t)background_count + (size_t)j0;
+            for (int j = 0; j < m; j++) {
+                float lc = apca_lc(&text, &bg[j]);
+                if (out_lc) out_lc[row + j] = lc;
+                if (out_pass) out_pass[row + j] = fabsf(lc) >= min_lc;
+            }
+        }
+    }
+}
+
+/* ========================================================================
+ * Colormaps
+ *
+ * Like the gradient mapper: one baked CJ_GradientTable, then chunks of
+ * values go through an index loop (one per normalization, selected
+ * outside the loop) and a store loop. Special values get negative codes
+ * in the index loop. NaN is detected on the bits, which -ffast-math (the
+ * Makefile's flags) cannot fold away, and replaced by vmin before
+ * normalization, so every float-to-int conversion is defined.
+ * ======================================================================== */
+
+#define CJ_COLORMAP_CHUNK 256
+#define CJ_COLORMAP_NAN (-1)
+#define CJ_COLORMAP_UNDER (-2)
+#define CJ_COLORMAP_OVER (-3)
+
+void cj_colormap_options_init(CJ_ColormapOptions* options) {
+    if (!options) return;
+    memset(options, 0, sizeof(*options));
+    options->normalization = CJ_NORM_LINEAR;
+    options->symlog_scale = 1.0f;
+    options->clip = false;
+}
+
+/* Bitwise, so it holds under -ffast-math */
+static inline bool colormap_is_nan(float v) {
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    return (bits & 0x7FFFFFFFu) > 0x7F800000u;
+}
+
+/* v, or fallback for NaN */
+static inline float colormap_finite(float v, float fallback) {
+    return colormap_is_nan(v) ? fallback : v;
+}
+
+/* Position in [0, last] */
+static inline int colormap_index(float t, float last) {
+    t = t > 0.0f ? t : 0.0f;
+    t = t < last ? t : last;
+    return (int)(t + 0.5f);
+}
+
+/* Histogram bin of a position in [0, CJ_COLORMAP_HISTOGRAM_BINS) */
+static inline int colormap_bin(float position) {
+    const float last = (float)(CJ_COLORMAP_HISTOGRAM_BINS - 1);
+    position = position > 0.0f ? position : 0.0f;
+    position = position < last ? position : last;
+    return (int)position;
+}
+
+static inline float symlog(float v, float scale) {
+    float magnitude = log1pf(fabsf(v) / scale);
+    return v < 0.0f ? -magnitude : magnitude;
+}
+
+void cj_colormap_equalize(const float* values, size_t count, float vmin, float vmax, CJ_ColormapEqualization* out) {
+    if (!out) return;
+    out->vmin = vmin;
+    out->vmax = vmax;
+
+    uint32_t histogram[CJ_COLORMAP_HISTOGRAM_BINS] = {0};
+    uint64_t total = 0;
+    if (values && !colormap_is_nan(vmin) && !colormap_is_nan(vmax) && vmax > vmin) {
+        const float scale = (float)CJ_COLORMAP_HISTOGRAM_BINS / (vmax - vmin);
+        for (size_t i = 0; i < count; i++) {
+            float v = values[i];
+            if (colormap_is_nan(v) || v < vmin || v > vmax) continue;
+            histogram[colormap_bin((v - vmin) * scale)]++;
+            total++;
+        }
+    }
+
+    /* Each bin maps to the cumulative share of values up to its midpoint */
+    const float last = (float)(CJ_GRADIENT_TABLE_SIZE - 1);
+    uint64_t below = 0;
+    for (int b = 0; b < CJ_COLORMAP_HISTOGRAM_BINS; b++) {
+        float t = total ? ((float)below + 0.5f * (float)histogram[b]) / (float)total
+                        : ((float)b + 0.5f) / (float)CJ_COLORMAP_HISTOGRAM_BINS;
+        out->entry[b] = (uint16_t)colormap_index(t * last, last);
+        below += histogram[b];
+    }
+}
+
+static void colormap_store(const int* index,
+                           int n,
+                           uint8_t* out,
+                           int channels,
+                           int r_offset,
+                           int b_offset,
+                           const CJ_GradientTable* table,
+                           const CJ_ColormapOptions* options) {
+    for (int i = 0; i < n; i++) {
+        uint8_t rgba[4];
+        const int k = index[i];
+        if (k >= 0) {
+            rgba[0] = table->rgb[k][0];
+            rgba[1] = table->rgb[k][1];
+            rgba[2] = table->rgb[k][2];
+            rgba[3] = 255;
+        } else {
+            const uint8_t* special = (k == CJ_COLORMAP_NAN) ? options->nan_color
+                                   : (k == CJ_COLORMAP_UNDER) ? options->under_color
+                                   : options->over_color;
+            memcpy(rgba, special, 4);
+        }
+        uint8_t* q = out + (size_t)i * (size_t)channels;
+        q[r_offset] = rgba[0];
+        q[1] = rgba[1];
+        q[b_offset] = rgba[2];
+        if (channels == 4) q[3] = rgba[3];
+    }
+}
+
+void cj_colormap_apply(CJ_Journey journey,
+                       const float* values,
+                       size_t count,
+                       float vmin,
+                       float vmax,
+                       uint8_t* out,
+                       CJ_PixelFormat format,
+                       const CJ_ColormapOptions* options) {
+    if (!values || !out || count == 0) return;
+    if (colormap_is_nan(vmin) || colormap_is_nan(vmax) || !(vmax > vmin)) return;
+
+    CJ_ColormapOptions defaults;
+    if (!options) {
+        cj_colormap_options_init(&defaults);
+        options = &defaults;
+    }
+    const CJ_Normalization mode = options->normalization;
+    if (mode == CJ_NORM_LOG && !(vmin > 0.0f)) return;
+    if (mode == CJ_NORM_SYMLOG && (colormap_is_nan(options->symlog_scale) || !(options->symlog_scale > 0.0f))) return;
+
+    const CJ_GradientTable* table = options->table;
+    CJ_GradientTable baked;
+    if (!table) {
+        if (!journey) return;
+        cj_gradient_table_bake(journey, &baked);
+        table = &baked;
+    }
+    const CJ_ColormapEqualization* equalization = options->equalization;
+    CJ_ColormapEqualization equalized;
+    if (mode == CJ_NORM_HISTOGRAM && !equalization) {
+        cj_colormap_equalize(values, count, vmin, vmax, &equalized);
+        equalization = &equalized;
+    }
+
+    const int channels = (format == CJ_PIXEL_RGB8) ? 3 : 4;
+    const int r_offset = (format == CJ_PIXEL_BGRA8) ? 2 : 0;
+    const int b_offset = 2 - r_offset;
+    const float last = (float)(CJ_GRADIENT_TABLE_SIZE - 1);
+    const bool clip = options->clip;
+    const int under = clip ? CJ_COLORMAP_UNDER : 0;
+    const int over = clip ? CJ_COLORMAP_OVER : CJ_GRADIENT_TABLE_SIZE - 1;
+
+    /* Per-mode offset and scale to table positions */
+    float origin = vmin;
+    float scale = last / (vmax - vmin);
+    if (mode == CJ_NORM_LOG) {
+        origin = log2f(vmin);
+        scale = last / (log2f(vmax) - origin);
+    } else if (mode == CJ_NORM_SYMLOG) {
+        origin = symlog(vmin, options->symlog_scale);
+        scale = last / (symlog(vmax, options->symlog_scale) - origin);
+    } else if (mode == CJ_NORM_HISTOGRAM) {
+        origin = equalization->vmin;
+        scale = (equalization->vmax > equalization->vmin)
+              ? (float)CJ_COLORMAP_HISTOGRAM_BINS / (equalization->vmax - equalization->vmin)
+              : 0.0f;
+    }
+
+    int index[CJ_COLORMAP_CHUNK];
+    for (size_t x0 = 0; x0 < count; x0 += CJ_COLORMAP_CHUNK) {
+        const int n = (count - x0 < CJ_COLORMAP_CHUNK) ? (int)(count - x0) : CJ_COLORMAP_CHUNK;
+        const float* v = values + x0;
+
+        switch (mode) {
+            case CJ_NORM_LOG:
+                for (int i = 0; i < n; i++) {
+                    const float x = colormap_finite(v[i], vmin);
+                    index[i] = colormap_index((log2f(x > vmin ? x : vmin) - origin) * scale, last);
+                }
+                break;
+            case CJ_NORM_SYMLOG:
+                for (int i = 0; i < n; i++) {
+                    index[i] = colormap_index((symlog(colormap_finite(v[i], vmin), options->symlog_scale) - origin) * scale, last);
+                }
+                break;
+            case CJ_NORM_HISTOGRAM:
+                for (int i = 0; i < n; i++) {
+                    index[i] = equalization->entry[colormap_bin((colormap_finite(v[i], vmin) - origin) * scale)];
+                }
+                break;
+            case CJ_NORM_LINEAR:
+            default:
+                for (int i = 0; i < n; i++) {
+                    index[i] = colormap_index((colormap_finite(v[i], vmin) - origin) * scale, last);
+                }
+                break;
+        }
+        /* Out of range and NaN override the normalized index */
+        for (int i = 0; i < n; i++) {
+            int k = index[i];
+            k = v[i] < vmin ? under : k;
+            k = v[i] > vmax ? over : k;
+            index[i] = colormap_is_nan(v[i]) ? CJ_COLORMAP_NAN : k;
+        }
+
+        colormap_store(index, n, out + x0 * (size_t)channels, channels, r_offset, b_offset, table, options);
+    }
+}
+
+/* ========================================================================
+ * Inverse Lookup
+ *
+ * The polyline is stored as OKLab segments with their direction and
+ * inverse squared length precomputed, so a projection needs no division.
+ * The bounding volume hierarchy is a segment tree over index ranges: node
+ * i covers segments [lo, hi) with children 2i+1 and 2i+2 splitting at the
+ * midpoint. Consecutive segments are close together, so index ranges make
+ * tight boxes without any spatial sort. Queries visit the nearer child
+ * first and skip boxes farther than the best segment so far.
+ * ======================================================================== */
+
+#define CJ_INVERSE_MAX_SAMPLES 65536
+#define CJ_INVERSE_LEAF_SEGMENTS 4
+
+typedef struct {
+    float origin[3];
+    float direction[3];
+    float inv_length2; /* 0 for a degenerate segment */
+} CJ_InverseSegment;
+
+typedef struct {
+    float min[3];
+    float max[3];
+} CJ_InverseBox;
+
+typedef struct CJ_JourneyInverse_Impl {
+    int segment_count;
+    CJ_InverseSegment* segments;
+    CJ_InverseBox* boxes;
+} CJ_JourneyInverse_Impl;
+
+static void inverse_build(CJ_JourneyInverse_Impl* impl, int node, int lo, int hi) {
+    CJ_InverseBox* box = &impl->boxes[node];
+    if (hi - lo <= CJ_INVERSE_LEAF_SEGMENTS) {
+        for (int a = 0; a < 3; a++) {
+            box->min[a] = INFINITY;
+            box->max[a] = -INFINITY;
+        }
+        for (int k = lo; k < hi; k++) {
+            const CJ_InverseSegment* segment = &impl->segments[k];
+            for (int a = 0; a < 3; a++) {
+                const float start = segment->origin[a];
+                const float end = segment->origin[a] + segment->direction[a];
+                box->min[a] = fminf(box->min[a], fminf(start, end));
+                box->max[a] = fmaxf(box->max[a], fmaxf(start, end));
+            }
+        }
+        return;
+    }
+
+    int mid = (lo + hi) / 2;
+    inverse_build(impl, 2 * node + 1, lo, mid);
+    inverse_build(impl, 2 * node + 2, mid, hi);
+    for (int a = 0; a < 3; a++) {
+        box->min[a] = fminf(impl->boxes[2 * node + 1].min[a], impl->boxes[2 * node + 2].min[a]);
+        box->max[a] = fmaxf(impl->boxes[2 * node + 1].max[a], impl->boxes[2 * node + 2].max[a]);
+    }
+}
+
+CJ_JourneyInverse cj_journey_inverse_create(CJ_Journey journey, int samples) {
+    if (!journey || samples < 2 || samples > CJ_INVERSE_MAX_SAMPLES) return NULL;
+
+    /* A segment tree over n segments needs fewer than 4n nodes */
+    const int segment_count = samples - 1;
+    size_t size = sizeof(CJ_JourneyInverse_Impl) + sizeof(CJ_InverseSegment) * (size_t)segment_count +
+                  sizeof(CJ_InverseBox) * 4 * (size_t)segment_count;
+    CJ_JourneyInverse_Impl* impl = (CJ_JourneyInverse_Impl*)malloc(size);
+    if (!impl) return NULL;
+
+    impl->segment_count = segment_count;
+    impl->segments = (CJ_InverseSegment*)(impl + 1);
+    impl->boxes = (CJ_InverseBox*)(impl->segments + segment_count);
+
+    CJ_Lab start = cj_rgb_to_oklab(cj_journey_sample(journey, 0.0f));
+    for (int k = 0; k < segment_count; k++) {
+        const float t = (float)(k + 1) / (float)segment_count;
+        const CJ_Lab end = cj_rgb_to_oklab(cj_journey_sample(journey, t));
+        CJ_InverseSegment* segment = &impl->segments[k];
+        segment->origin[0] = start.L;
+        segment->origin[1] = start.a;
+        segment->origin[2] = start.b;
+        segment->direction[0] = end.L - start.L;
+        segment->direction[1] = end.a - start.a;
+        segment->direction[2] = end.b - start.b;
+        const float length2 = segment->direction[0] * segment->direction[0] +
+                              segment->direction[1] * segment->direction[1] +
+                              segment->direction[2] * segment->direction[2];
+        segment->inv_length2 = length2 > 0.0f ? 1.0f / length2 : 0.0f;
+        start = end;
+    }
+    inverse_build(impl, 0, 0, segment_count);
+
+    return (CJ_JourneyInverse)impl;
+}
+
+void cj_journey_inverse_destroy(CJ_JourneyInverse inverse) {
+    free(inverse);
+}
+
+typedef struct {
+    float q[3];
+    float best_d2;
+    float best_t;
+} CJ_InverseQuery;
+
+/*
+ * max(x, 0) is written (x + |x|) / 2 here: GCC does not if-convert the
+ * float selects, and mispredicted branches dominate the query otherwise.
+ */
+static inline float inverse_box_distance2(const CJ_InverseBox* box, const float q[3]) {
+    float d2 = 0.0f;
+    for (int a = 0; a < 3; a++) {
+        /* At most one of below/above is positive */
+        const float below = box->min[a] - q[a];
+        const float above = q[a] - box->max[a];
+        const float d = 0.5f * (below + fabsf(below) + above + fabsf(above));
+        d2 += d * d;
+    }
+    return d2;
+}
+
+static void inverse_segment(const CJ_JourneyInverse_Impl* impl, int k, CJ_InverseQuery* query) {
+    const CJ_InverseSegment* segment = &impl->segments[k];
+    const float aq[3] = {query->q[0] - segment->origin[0], query->q[1] - segment->origin[1],
+                         query->q[2] - segment->origin[2]};
+    const float u = clampf((aq[0] * segment->direction[0] + aq[1] * segment->direction[1] +
+                            aq[2] * segment->direction[2]) * segment->inv_length2,
+                           0.0f, 1.0f);
+
+    const float d[3] = {aq[0] - u * segment->direction[0], aq[1] - u * segment->direction[1],
+                        aq[2] - u * segment->direction[2]};
+    const float d2 = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+    const float t = ((float)k + u) / (float)impl->segment_count;
+    if (d2 < query->best_d2 || (d2 == query->best_d2 && t < query->best_t)) {
+        query->best_d2 = d2;
+        query->best_t = t;
+    }
+}
+
+static void inverse_search(const CJ_JourneyInverse_Impl* impl, int node, int lo, int hi, CJ_InverseQuery* query) {
+    if (hi - lo <= CJ_INVERSE_LEAF_SEGMENTS) {
+        for (int k = lo; k < hi; k++) {
+            inverse_segment(impl, k, query);
+        }
+        return;
+    }
+
+    const int mid = (lo + hi) / 2;
+    const int left = 2 * node + 1;
+    const int right = 2 * node + 2;
+    const float left_d2 = inverse_box_distance2(&impl->boxes[left], query->q);
+    const float right_d2 = inverse_box_distance2(&impl->boxes[right], query->q);
+
+    /* <= so an equally distant segment at a smaller t is still considered */
+    if (left_d2 <= right_d2) {
+        if (left_d2 <= query->best_d2) inverse_search(impl, left, lo, mid, query);
+        if (right_d2 <= query->best_d2) inverse_search(impl, right, mid, hi, query);
+    } else {
+        if (right_d2 <= query->best_d2) inverse_search(impl, right, mid, hi, query);
+        if (left_d2 <= query->best_d2) inverse_search(impl, left, lo, mid, query);
+    }
+}
+
+float cj_journey_inverse_query(CJ_JourneyInverse inverse, CJ_RGB color, float* out_delta_e) {
+    const CJ_JourneyInverse_Impl* impl = (const CJ_JourneyInverse_Impl*)inverse;
+    if (!impl) return -1.0f;
+
+    CJ_Lab lab = cj_rgb_to_oklab(color);
+    CJ_InverseQuery query = {{lab.L, lab.a, lab.b}, INFINITY, 0.0f};
+    inverse_search(impl, 0, 0, impl->segment_count, &query);
+    if (out_delta_e) *out_delta_e = sqrtf(query.best_d2);
+    return query.best_t;
+}
+
+void cj_journey_inverse_query_batch(CJ_JourneyInverse inverse,
+                                    const CJ_RGB* colors,
+                                    int count,
+                                    float* out_t,
+                                    float* out_delta_e) {
+    if (!inverse || !colors || !out_t || count <= 0) return;
+
+    for (int i = 0; i < count; i++) {
+        out_t[i] = cj_journey_inverse_query(inverse, colors[i], out_delta_e ? &out_delta_e[i] : NULL);
+    }
+}
+
+/* ========================================================================
+ * Journey Fields
+ *
+ * A field is a columns x rows lattice of OKLab nodes. Both interpolation
+ * modes are written as four taps per axis with clamped indices: bilinear
+ * puts its weights on the middle two taps, Catmull-Rom uses all four. A
+ * sample is then separable: blend four lattice rows in v, then four
+ * values of the blended row in u. Rasterization computes the u taps of a
+ * column chunk once and blends each image row in v once into a stack
+ * buffer, which leaves a 4-tap blend and a conversion per pixel.
+ * ======================================================================== */
+
+#define CJ_FIELD_CHUNK 256
+
+typedef struct CJ_JourneyField_Impl {
+    int columns;
+    int rows;
+    CJ_FieldInterpolation interpolation;
+    CJ_Lab* nodes; /* nodes[row * columns + column] */
+} CJ_JourneyField_Impl;
+
+static CJ_JourneyField_Impl* field_alloc(int columns, int rows, CJ_FieldInterpolation interpolation) {
+    CJ_JourneyField_Impl* impl = (CJ_JourneyField_Impl*)malloc(
+        sizeof(CJ_JourneyField_Impl) + sizeof(CJ_Lab) * (size_t)columns * (size_t)rows);
+    if (!impl) return NULL;
+
+    impl->columns = columns;
+    impl->rows = rows;
+    impl->interpolation = interpolation == CJ_FIELD_BICUBIC ? CJ_FIELD_BICUBIC : CJ_FIELD_BILINEAR;
+    impl->nodes = (CJ_Lab*)(impl + 1);
+    return impl;
+}
+
+CJ_JourneyField cj_journey_field_create(const CJ_Journey* journeys, int count, CJ_FieldInterpolation interpolation) {
+    if (!journeys || count < 2 || count > CJ_FIELD_MAX_LATTICE) return NULL;
+    for (int j = 0; j < count; j++) {
+        if (!journeys[j]) return NULL;
+    }
+
+    CJ_JourneyField_Impl* impl = field_alloc(CJ_FIELD_JOURNEY_COLUMNS, count, interpolation);
+    if (!impl) return NULL;
+
+    for (int j = 0; j < count; j++) {
+        for (int i = 0; i < CJ_FIELD_JOURNEY_COLUMNS; i++) {
+            float t = (float)i / (float)(CJ_FIELD_JOURNEY_COLUMNS - 1);
+            impl->nodes[j * CJ_FIELD_JOURNEY_COLUMNS + i] = cj_rgb_to_oklab(cj_journey_sample(journeys[j], t));
+        }
+    }
+    return (CJ_JourneyField)impl;
+}
+
+CJ_JourneyField cj_journey_field_create_grid(const CJ_RGB* anchors,
+                                             int columns,
+                                             int rows,
+                                             CJ_FieldInterpolation interpolation) {
+    if (!anchors || columns < 2 || rows < 2 || columns > CJ_FIELD_MAX_LATTICE || rows > CJ_FIELD_MAX_LATTICE) {
+        return NULL;
+    }
+
+    CJ_JourneyField_Impl* impl = field_alloc(columns, rows, interpolation);
+    if (!impl) return NULL;
+
+    for (int n = 0; n < columns * rows; n++) {
+        impl->nodes[n] = cj_rgb_to_oklab(anchors[n]);
+    }
+    return (CJ_JourneyField)impl;
+}
+
+void cj_journey_field_destroy(CJ_JourneyField field) {
+    free(field);
+}
+
+/* Clamped tap indices and weights for coordinate s over n nodes */
+static inline void field_taps(float s, int n, CJ_FieldInterpolation interpolation, int tap[4], float weight[4]) {
+    s = s >= 0.0f ? s : 0.0f; /* Also maps NaN to 0 */
+    s = s <= 1.0f ? s : 1.0f;
+    const float x = s * (float)(n - 1);
+    int i = (int)x;
+    if (i > n - 2) i = n - 2;
+    const float f = x - (float)i;
+
+    for (int k = 0; k < 4; k++) {
+        int index = i - 1 + k;
+        tap[k] = index < 0 ? 0 : (index > n - 1 ? n - 1 : index);
+    }
+    if (interpolation == CJ_FIELD_BICUBIC) {
+        const float f2 = f * f;
+        const float f3 = f2 * f;
+        weight[0] = 0.5f * (-f3 + 2.0f * f2 - f);
+        weight[1] = 0.5f * (3.0f * f3 - 5.0f * f2 + 2.0f);
+        weight[2] = 0.5f * (-3.0f * f3 + 4.0f * f2 + f);
+        weight[3] = 0.5f * (f3 - f2);
+    } else {
+        weight[0] = 0.0f;
+        weight[1] = 1.0f - f;
+        weight[2] = f;
+        weight[3] = 0.0f;
+    }
+}
+
+static inline CJ_Lab field_blend(const CJ_Lab* values, const int tap[4], const float weight[4], int step) {
+    CJ_Lab out = {0.0f, 0.0f, 0.0f};
+    for (int k = 0; k < 4; k++) {
+        const CJ_Lab c = values[tap[k] * step];
+        out.L += weight[k] * c.L;
+        out.a += weight[k] * c.a;
+        out.b += weight[k] * c.b;
+    }
+    return out;
+}
+
+CJ_RGB cj_journey_field_sample(CJ_JourneyField field, float u, float v) {
+    const CJ_JourneyField_Impl* impl = (const CJ_JourneyField_Impl*)field;
+    CJ_RGB black = {0.0f, 0.0f, 0.0f};
+    if (!impl) return black;
+
+    int u_tap[4], v_tap[4];
+    float u_weight[4], v_weight[4];
+    field_taps(u, impl->columns, impl->interpolation, u_tap, u_weight);
+    field_taps(v, impl->rows, impl->interpolation, v_tap, v_weight);
+
+    /* Blend the four columns in v, then those in u */
+    CJ_Lab column[4];
+    for (int k = 0; k < 4; k++) {
+        column[k] = field_blend(impl->nodes + u_tap[k], v_tap, v_weight, impl->columns);
+    }
+    const int identity[4] = {0, 1, 2, 3};
+    return cj_rgb_clamp(cj_oklab_to_rgb(field_blend(column, identity, u_weight, 1)));
+}
+
+void cj_journey_field_sample_batch(CJ_JourneyField field, const float* u, const float* v, int count, CJ_RGB* out) {
+    if (!field || !u || !v || !out || count <= 0) return;
+
+    for (int i = 0; i < count; i++) {
+        out[i] = cj_journey_field_sample(field, u[i], v[i]);
+    }
+}
+
+/* cj_oklab_to_rgb in float and inline; 8-bit output does not need doubles */
+static inline CJ_RGB field_oklab_to_rgb(CJ_Lab c) {
+    float l_ = c.L + 0.3963377774f * c.a + 0.2158037573f * c.b;
+    float m_ = c.L - 0.1055613458f * c.a - 0.0638541728f * c.b;
+    float s_ = c.L - 0.0894841775f * c.a - 1.2914855480f * c.b;
+    float l = l_ * l_ * l_;
+    float m = m_ * m_ * m_;
+    float s = s_ * s_ * s_;
+    CJ_RGB rgb = {
+        +4.0767416621f * l - 3.3077115913f * m + 0.2309699292f * s,
+        -1.2684380046f * l + 2.6097574011f * m - 0.3413193965f * s,
+        -0.0041960863f * l - 0.7034186147f * m + 1.7076147010f * s
+    };
+    return rgb;
+}
+
+void cj_journey_field_rasterize(CJ_JourneyField field,
+                                uint8_t* pixels,
+                                int width,
+                                int height,
+                                int stride,
+                                CJ_PixelFormat format,
+                                int row_begin,
+                                int row_end) {
+    const CJ_JourneyField_Impl* impl = (const CJ_JourneyField_Impl*)field;
+    if (!impl || !pixels || width <= 0 || height <= 0) return;
+
+    const int channels = (format == CJ_PIXEL_RGB8) ? 3 : 4;
+    const int r_offset = (format == CJ_PIXEL_BGRA8) ? 2 : 0;
+    const int b_offset = 2 - r_offset;
+    if (stride < width * channels) return;
+    if (row_begin < 0) row_begin = 0;
+    if (row_end > height) row_end = height;
+
+    const float u_scale = width > 1 ? 1.0f / (float)(width - 1) : 0.0f;
+    const float v_scale = height > 1 ? 1.0f / (float)(height - 1) : 0.0f;
+    int u_tap[CJ_FIELD_CHUNK][4];
+    float u_weight[CJ_FIELD_CHUNK][4];
+    CJ_Lab row[CJ_FIELD_MAX_LATTICE];
+
+    /* Column chunks outermost, so u taps are computed once per chunk, not per row */
+    for (int x0 = 0; x0 < width; x0 += CJ_FIELD_CHUNK) {
+        const int n = (width - x0 < CJ_FIELD_CHUNK) ? width - x0 : CJ_FIELD_CHUNK;
+        for (int i = 0; i < n; i++) {
+            field_taps((float)(x0 + i) * u_scale, impl->columns, impl->interpolation, u_tap[i], u_weight[i]);
+        }
+        /* Taps are ascending, so the chunk reads lattice columns [first, last] */
+        const int first = u_tap[0][0];
+        const int last = u_tap[n - 1][3];
+
+        for (int y = row_begin; y < row_end; y++) {
+            int v_tap[4];
+            float v_weight[4];
+            field_taps((float)y * v_scale, impl->rows, impl->interpolation, v_tap, v_weight);
+            for (int i = first; i <= last; i++) {
+                row[i] = field_blend(impl->nodes + i, v_tap, v_weight, impl->columns);
+            }
+
+            uint8_t* out = pixels + (size_t)y * (size_t)stride + (size_t)x0 * (size_t)channels;
+            for (int i = 0; i < n; i++, out += channels) {
+                CJ_RGB c = field_oklab_to_rgb(field_blend(row, u_tap[i], u_weight[i], 1));
+                out[r_offset] = linear_to_srgb8(c.r);
+                out[1] = linear_to_srgb8(c.g);
+                out[b_offset] = linear_to_srgb8(c.b);
+                if (channels == 4) out[3] = 255;
+            }
+        }
+    }
+}
+
+/* ========================================================================
+ * Hot-Path Statistics
+ * ======================================================================== */
+
+bool cj_stats_enabled(void) {
+#ifdef CJ_ENABLE_STATS
+    return true;
+#else
+    return false;
+#endif
+}
+
+void cj_stats_snapshot(CJ_Stats* out) {
+    if (!out) return;
+#ifdef CJ_ENABLE_STATS
+    *out = cj_stats;
+#else
+    memset(out, 0, sizeof(*out));
+#endif
+}
+
+void cj_stats_reset(void) {
+#ifdef CJ_ENABLE_STATS
+    memset(&cj_stats, 0, sizeof(cj_stats));
+#endif
 }
@@ -7,6 +7,7 @@
 #ifndef COLORJOURNEY_H
 #define COLORJOURNEY_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -881,6 +882,750 @@ bool cj_is_readable(CJ_Lab c);
  */
 CJ_Lab cj_enforce_contrast(CJ_Lab color, CJ_Lab reference, float min_delta_e);
 
+/* ========================================================================
+ * Image Gradient Mapping
+ * ======================================================================== */
+
+/**
+ * @enum CJ_PixelFormat
+ * @brief 8-bit pixel layouts accepted by @ref cj_image_gradient_map.
+ *
+ * Channels are 8-bit sRGB-encoded, as in ordinary image files. They are
+ * decoded to linear RGB (@ref CJ_RGB) on input and sRGB-encoded on output.
+ */
+typedef enum {
+    CJ_PIXEL_RGBA8 = 0,  ///< R, G, B, A bytes
+    CJ_PIXEL_BGRA8 = 1,  ///< B, G, R, A bytes
+    CJ_PIXEL_RGB8 = 2    ///< R, G, B bytes (no alpha)
+} CJ_PixelFormat;
+
+/// Entries in a baked gradient table (t = i / (CJ_GRADIENT_TABLE_SIZE - 1)).
+#define CJ_GRADIENT_TABLE_SIZE 1024
+
+/**
+ * @struct CJ_GradientTable
+ * @brief A journey baked into 8-bit colors for @ref cj_image_gradient_map.
+ *
+ * Entry i holds cj_journey_sample(journey, i / 1023), clamped and
+ * sRGB-encoded to 8 bits. Adjacent entries are well below one JND apart, so mapping a pixel
+ * to its nearest entry is visually identical to sampling the journey.
+ */
+typedef struct {
+    uint8_t rgb[CJ_GRADIENT_TABLE_SIZE][3];  ///< R, G, B per entry
+} CJ_GradientTable;
+
+/**
+ * @brief Bake a journey into a gradient table.
+ *
+ * Costs CJ_GRADIENT_TABLE_SIZE samples. Bake once and pass the table through
+ * @ref CJ_GradientMapOptions when mapping many images or many row bands.
+ *
+ * @param journey Journey handle
+ * @param out Destination table (must not be NULL)
+ */
+void cj_gradient_table_bake(CJ_Journey journey, CJ_GradientTable* out);
+
+/**
+ * @struct CJ_GradientMapOptions
+ * @brief Options for @ref cj_image_gradient_map.
+ */
+typedef struct {
+    /// Copy source alpha to the destination (4-channel formats). If false, alpha is set to 255.
+    bool preserve_alpha;
+    /// Pre-baked table for the same journey, or NULL to bake one per call.
+    const CJ_GradientTable* table;
+} CJ_GradientMapOptions;
+
+/**
+ * @brief Recolor an image through a journey by OKLab lightness.
+ *
+ * Each pixel's OKLab L selects the journey color at t = L (0 = black end,
+ * 1 = white end). Equivalent to cj_journey_sample(journey,
+ * cj_rgb_to_oklab(pixel).L) per sRGB-decoded pixel, sRGB-encoded back to
+ * 8 bits, but uses a decode table, a baked journey table and a fast cube
+ * root, so the per-pixel cost is a few multiplies and two lookups.
+ *
+ * **Threading:** the function keeps no state, so images can be split into
+ * row bands and mapped in parallel. Bake the table once and pass it to every
+ * band:
+ * ```c
+ * CJ_GradientTable table;
+ * cj_gradient_table_bake(journey, &table);
+ * CJ_GradientMapOptions options = { true, &table };
+ * // worker k of n, rows [y0, y1):
+ * cj_image_gradient_map(journey, src + y0 * stride, dst + y0 * stride,
+ *                       width, y1 - y0, stride, CJ_PIXEL_RGBA8, &options);
+ * ```
+ *
+ * @param journey Journey handle (only used when options->table is NULL)
+ * @param src Source pixels
+ * @param dst Destination pixels; may equal @p src for in-place mapping
+ * @param width Pixels per row
+ * @param height Rows
+ * @param stride Bytes from one row to the next, for both @p src and @p dst
+ * @param format Pixel layout of both @p src and @p dst
+ * @param options Options, or NULL for preserve_alpha = true and no pre-baked table
+ *
+ * @note Does nothing if a pointer is NULL, a dimension is not positive, or
+ *       the stride is shorter than a row.
+ */
+void cj_image_gradient_map(CJ_Journey journey,
+                           const uint8_t* src,
+                           uint8_t* dst,
+                           int width,
+                           int height,
+                           int stride,
+                           CJ_PixelFormat format,
+                           const CJ_GradientMapOptions* options);
+
+/* ========================================================================
+ * Nearest Palette Color
+ * ======================================================================== */
+
+/**
+ * @brief Opaque handle to a nearest-color index over a fixed palette.
+ *
+ * Built once from a palette (e.g. the output of @ref cj_journey_discrete),
+ * then queried for the entry with the smallest OKLab ΔE to any color.
+ * Queries never modify the index, so one index can serve many threads;
+ * split large batches into ranges and query them in parallel.
+ */
+typedef struct CJ_PaletteIndex_Impl* CJ_PaletteIndex;
+
+/// Largest accepted grid_resolution for @ref cj_palette_index_create.
+#define CJ_PALETTE_GRID_MAX 128
+
+/**
+ * @brief Build a nearest-color index for a palette.
+ *
+ * Exact queries use a k-d tree over the palette in OKLab: O(log n) per
+ * query for typical palettes instead of n ΔE computations.
+ *
+ * With @p grid_resolution > 0 the index also precomputes the nearest entry
+ * for the center of every cell of a grid_resolution³ grid over the RGB cube,
+ * for @ref cj_palette_index_nearest_approx. The axes are spaced evenly in
+ * sRGB-encoded values, so cells near black are not perceptually larger.
+ * Cost: grid_resolution³ exact queries at build time and 4 bytes per cell
+ * (32 → 128 KB). Colors near a boundary between two entries may get the
+ * other one; at 32 the returned entry is at most ~0.03 ΔE farther than the
+ * nearest (see Tests/Accuracy).
+ *
+ * @param palette Palette colors (copied; the array may be freed afterwards)
+ * @param count Number of colors (≥ 1)
+ * @param grid_resolution Cells per RGB axis for approximate queries, 0 for none,
+ *                        at most @ref CJ_PALETTE_GRID_MAX
+ *
+ * @return Index handle, or NULL on invalid arguments or allocation failure.
+ *         Release with @ref cj_palette_index_destroy.
+ *
+ * **Example:**
+ * ```c
+ * CJ_RGB palette[16];
+ * cj_journey_discrete(journey, 16, palette);
+ * CJ_PaletteIndex index = cj_palette_index_create(palette, 16, 32);
+ * int nearest = cj_palette_index_nearest(index, pixel, NULL);
+ * cj_palette_index_destroy(index);
+ * ```
+ */
+CJ_PaletteIndex cj_palette_index_create(const CJ_RGB* palette, int count, int grid_resolution);
+
+/**
+ * @brief Release a palette index. NULL is ignored.
+ */
+void cj_palette_index_destroy(CJ_PaletteIndex index);
+
+/**
+ * @brief Find the palette entry nearest to a color by OKLab ΔE (exact).
+ *
+ * Ties resolve to the lowest palette position.
+ *
+ * @param index Palette index
+ * @param color Query color
+ * @param out_delta_e Optional: receives the ΔE to the returned entry
+ *
+ * @return Palette position in [0, count), or -1 if @p index is NULL
+ */
+int cj_palette_index_nearest(CJ_PaletteIndex index, CJ_RGB color, float* out_delta_e);
+
+/**
+ * @brief Find the palette entry nearest to a color using the grid (O(1)).
+ *
+ * Returns the precomputed entry for the grid cell containing the clamped
+ * color. Falls back to @ref cj_palette_index_nearest when the index was
+ * built without a grid.
+ *
+ * @return Palette position in [0, count), or -1 if @p index is NULL
+ */
+int cj_palette_index_nearest_approx(CJ_PaletteIndex index, CJ_RGB color);
+
+/**
+ * @brief Query many colors at once.
+ *
+ * @param index Palette index
+ * @param colors Query colors
+ * @param count Number of colors
+ * @param out_indices Receives one palette position per color
+ * @param approximate Use the grid (@ref cj_palette_index_nearest_approx) instead of exact queries
+ */
+void cj_palette_index_nearest_batch(CJ_PaletteIndex index,
+                                    const CJ_RGB* colors,
+                                    int count,
+                                    int* out_indices,
+                                    bool approximate);
+
+/* ========================================================================
+ * Anchor Extraction
+ * ======================================================================== */
+
+/// At most this many pixels, on a regular grid, are clustered by @ref cj_extract_anchors.
+#define CJ_EXTRACT_MAX_SAMPLES 65536
+
+/**
+ * @brief Find the dominant colors of an image, for use as journey anchors.
+ *
+ * Subsamples the image to at most @ref CJ_EXTRACT_MAX_SAMPLES pixels on a
+ * regular grid, then runs k-means in OKLab with k-means++ seeding from a
+ * fixed seed, so the same image always gives the same anchors. Fully
+ * transparent pixels (alpha 0) are skipped. Anchors are sorted by cluster
+ * size, largest first. Cost barely depends on image size, since only the
+ * sampled pixels are read: about 10 ms even for a 24-megapixel image.
+ *
+ * @param pixels Image in @p format, 8-bit sRGB-encoded channels
+ *               (anchors are returned as linear @ref CJ_RGB)
+ * @param width Image width in pixels
+ * @param height Image height in pixels
+ * @param stride Bytes between row starts
+ * @param format Pixel layout
+ * @param k Number of anchors wanted, 1-8 (the capacity of CJ_Config.anchors)
+ * @param out_anchors Receives up to @p k colors
+ *
+ * @return Number of anchors written: @p k, fewer if the image has fewer
+ *         distinct colors, or 0 on invalid arguments.
+ *
+ * **Example:**
+ * ```c
+ * CJ_Config config;
+ * cj_config_init(&config);
+ * config.anchor_count = cj_extract_anchors(pixels, w, h, w * 4, CJ_PIXEL_RGBA8, 3, config.anchors);
+ * ```
+ */
+int cj_extract_anchors(const uint8_t* pixels,
+                       int width,
+                       int height,
+                       int stride,
+                       CJ_PixelFormat format,
+                       int k,
+                       CJ_RGB* out_anchors);
+
+/* ========================================================================
+ * Color Vision Deficiency
+ * ======================================================================== */
+
+/**
+ * @enum CJ_CVDType
+ * @brief Kind of color vision deficiency to simulate.
+ */
+typedef enum {
+    CJ_CVD_PROTAN = 0,  ///< Missing or anomalous L cones (red-green, reds darkened)
+    CJ_CVD_DEUTAN,      ///< Missing or anomalous M cones (red-green, most common)
+    CJ_CVD_TRITAN       ///< Missing or anomalous S cones (blue-yellow, rare)
+} CJ_CVDType;
+
+/**
+ * @brief Simulate how a color appears with a color vision deficiency.
+ *
+ * Applies the Machado, Oliveira & Fernandes (2009) model for dichromacy
+ * (severity 1.0) as one 3×3 matrix in linear RGB. Dichromacy is the worst
+ * case, so a palette that stays distinguishable here also does for the
+ * milder anomalous trichromacies. The result is clamped to [0, 1].
+ *
+ * @param color Input color (linear RGB)
+ * @param type Deficiency to simulate
+ *
+ * @return The simulated color
+ *
+ * **Reference**: Machado, G. M., Oliveira, M. M., & Fernandes, L. A. F. (2009).
+ * A Physiologically-based Model for Simulation of Color Vision Deficiency.
+ */
+CJ_RGB cj_cvd_simulate(CJ_RGB color, CJ_CVDType type);
+
+/**
+ * @brief Simulate a deficiency for many colors at once.
+ *
+ * Same result as @ref cj_cvd_simulate per color. @p out may equal @p colors.
+ */
+void cj_cvd_simulate_batch(const CJ_RGB* colors, int count, CJ_CVDType type, CJ_RGB* out);
+
+/**
+ * @brief Smallest OKLab ΔE between palette colors as seen with a deficiency.
+ *
+ * Simulates every color, then returns the minimum ΔE over adjacent pairs
+ * (i, i+1) or, with @p all_pairs, over every pair. Compare the result with
+ * a contrast threshold (e.g. 0.05) to check that a palette stays
+ * distinguishable. Adjacent mode costs one simulation and one OKLab
+ * conversion per color and allocates nothing, so it is cheap enough to run
+ * on every generated palette; all-pairs mode allocates one OKLab buffer
+ * and is O(n²).
+ *
+ * @param palette Colors in order (e.g. from @ref cj_journey_discrete)
+ * @param count Number of colors
+ * @param type Deficiency to simulate
+ * @param all_pairs Check every pair instead of neighbours only
+ *
+ * @return Minimum ΔE, or 0 for fewer than 2 colors, invalid arguments or
+ *         allocation failure
+ *
+ * **Example:**
+ * ```c
+ * CJ_RGB palette[8];
+ * cj_journey_discrete(journey, 8, palette);
+ * bool ok = cj_palette_cvd_min_delta_e(palette, 8, CJ_CVD_DEUTAN, true) >= 0.05f;
+ * ```
+ */
+float cj_palette_cvd_min_delta_e(const CJ_RGB* palette, int count, CJ_CVDType type, bool all_pairs);
+
+/* ========================================================================
+ * Contrast Evaluation
+ * ======================================================================== */
+
+/**
+ * @brief WCAG 2.x contrast ratio of every color against every background.
+ *
+ * Relative luminance is Y = 0.2126 R + 0.7152 G + 0.0722 B on the linear
+ * channels (clamped to [0, 1]); the ratio is (Y_light + 0.05) / (Y_dark + 0.05),
+ * from 1 (no contrast) to 21 (black on white). WCAG AA asks for 4.5 for
+ * body text and 3 for large text and UI components.
+ *
+ * Results are row-major: entry [i * background_count + j] is color i on
+ * background j. Luminance is computed once per color and background; the
+ * pair loop is plain arithmetic, so large batches stay cheap.
+ *
+ * @param colors Foreground colors (linear RGB)
+ * @param color_count Number of colors
+ * @param backgrounds Background colors (linear RGB)
+ * @param background_count Number of backgrounds
+ * @param out_ratios Optional: color_count × background_count ratios
+ * @param min_ratio Threshold for @p out_pass
+ * @param out_pass Optional: color_count × background_count flags, true where ratio ≥ @p min_ratio
+ *
+ * **Example:**
+ * ```c
+ * bool pass[16 * 2];
+ * CJ_RGB backgrounds[2] = {{1, 1, 1}, {0.01f, 0.01f, 0.01f}};
+ * cj_contrast_wcag_batch(palette, 16, backgrounds, 2, NULL, 4.5f, pass);
+ * ```
+ */
+void cj_contrast_wcag_batch(const CJ_RGB* colors,
+                            int color_count,
+                            const CJ_RGB* backgrounds,
+                            int background_count,
+                            float* out_ratios,
+                            float min_ratio,
+                            bool* out_pass);
+
+/**
+ * @brief APCA lightness contrast (Lc) of every color against every background.
+ *
+ * Implements APCA 0.0.98G-4g (the WCAG 3 draft candidate). Lc is positive for
+ * dark text on a light background, negative for light text on a dark one,
+ * and roughly ±108 at most. Common targets: |Lc| ≥ 75 for body text, 60
+ * for large text, 45 for headlines, 30 for non-text elements.
+ *
+ * APCA's luminance works on gamma-encoded sRGB, so colors are encoded
+ * first. Layout and cost are as for @ref cj_contrast_wcag_batch, including
+ * the per-color terms being computed once.
+ *
+ * @param colors Text colors (linear RGB)
+ * @param color_count Number of colors
+ * @param backgrounds Background colors (linear RGB)
+ * @param background_count Number of backgrounds
+ * @param out_lc Optional: color_count × background_count signed Lc values
+ * @param min_lc Threshold for @p out_pass, compared with |Lc|
+ * @param out_pass Optional: color_count × background_count flags, true where |Lc| ≥ @p min_lc
+ *
+ * **Reference**: Somers, A. APCA. https://github.com/Myndex/apca-w3
+ */
+void cj_contrast_apca_batch(const CJ_RGB* colors,
+                            int color_count,
+                            const CJ_RGB* backgrounds,
+                            int background_count,
+                            float* out_lc,
+                            float min_lc,
+                            bool* out_pass);
+
+/* ========================================================================
+ * Colormaps
+ * ======================================================================== */
+
+/**
+ * @enum CJ_Normalization
+ * @brief How data values are mapped to journey positions by @ref cj_colormap_apply.
+ */
+typedef enum {
+    CJ_NORM_LINEAR = 0,  ///< t = (v - vmin) / (vmax - vmin)
+    CJ_NORM_LOG,         ///< Linear in log(v); needs vmin > 0, values ≤ 0 count as under
+    CJ_NORM_SYMLOG,      ///< Linear in sign(v)·log(1 + |v| / symlog_scale); handles zero and negatives
+    CJ_NORM_HISTOGRAM    ///< Histogram-equalized: each color covers about the same number of values
+} CJ_Normalization;
+
+/// Histogram resolution of @ref CJ_ColormapEqualization (bins over [vmin, vmax]).
+#define CJ_COLORMAP_HISTOGRAM_BINS 4096
+
+/**
+ * @brief Histogram equalization for @ref CJ_NORM_HISTOGRAM, mapping each bin to a table entry.
+ *
+ * Built by @ref cj_colormap_equalize. Pass the same equalization to every
+ * call when a dataset is mapped in parts (e.g. split across threads), so
+ * all parts use one histogram.
+ */
+typedef struct {
+    float vmin;
+    float vmax;
+    uint16_t entry[CJ_COLORMAP_HISTOGRAM_BINS];
+} CJ_ColormapEqualization;
+
+/**
+ * @brief Options for @ref cj_colormap_apply. Initialize with @ref cj_colormap_options_init.
+ */
+typedef struct {
+    CJ_Normalization normalization;
+    /// Values in (-symlog_scale, symlog_scale) are mapped nearly linearly (CJ_NORM_SYMLOG).
+    float symlog_scale;
+    /// When true, values below vmin / above vmax get under_color / over_color;
+    /// when false (default) they take the first / last journey color.
+    bool clip;
+    uint8_t nan_color[4];    ///< sRGB RGBA for NaN values (default transparent black)
+    uint8_t under_color[4];  ///< sRGB RGBA below range when @c clip is set
+    uint8_t over_color[4];   ///< sRGB RGBA above range when @c clip is set
+    /// Optional pre-baked journey table; NULL bakes one per call.
+    const CJ_GradientTable* table;
+    /// Optional shared histogram for CJ_NORM_HISTOGRAM; NULL equalizes over this call's values.
+    const CJ_ColormapEqualization* equalization;
+} CJ_ColormapOptions;
+
+/**
+ * @brief Initialize colormap options: linear, clamp out-of-range values,
+ *        NaN transparent black, symlog_scale 1, no pre-baked tables.
+ */
+void cj_colormap_options_init(CJ_ColormapOptions* options);
+
+/**
+ * @brief Build a histogram equalization over [vmin, vmax] from data values.
+ *
+ * NaN and out-of-range values are ignored. If no value is in range the
+ * mapping is linear.
+ */
+void cj_colormap_equalize(const float* values, size_t count, float vmin, float vmax, CJ_ColormapEqualization* out);
+
+/**
+ * @brief Map data values to 8-bit colors through a journey.
+ *
+ * Replaces a per-value @ref cj_journey_sample loop. The journey is sampled
+ * once into a @ref CJ_GradientTable (1024 entries, or the caller's
+ * options->table), then each value is normalized to a table index in
+ * chunks, with branch-free index arithmetic for the compiler to
+ * vectorize. The call is stateless: to use several threads, split @p values
+ * into ranges and map each with the same table (and equalization).
+ *
+ * @param journey Journey to map through (may be NULL when options->table is set)
+ * @param values Data values
+ * @param count Number of values
+ * @param vmin Value mapped to the start of the journey
+ * @param vmax Value mapped to the end; must be > vmin, else nothing is written
+ * @param out count pixels in @p format, sRGB-encoded like the table entries
+ * @param format Output pixel layout; table colors are opaque
+ * @param options Options, or NULL for defaults
+ *
+ * **Example:**
+ * ```c
+ * CJ_ColormapOptions options;
+ * cj_colormap_options_init(&options);
+ * options.normalization = CJ_NORM_LOG;
+ * cj_colormap_apply(journey, values, count, 1.0f, 1e6f, rgba, CJ_PIXEL_RGBA8, &options);
+ * ```
+ */
+void cj_colormap_apply(CJ_Journey journey,
+                       const float* values,
+                       size_t count,
+                       float vmin,
+                       float vmax,
+                       uint8_t* out,
+                       CJ_PixelFormat format,
+                       const CJ_ColormapOptions* options);
+
+/* ========================================================================
+ * Inverse Lookup
+ * ======================================================================== */
+
+/**
+ * @brief Opaque handle for projecting colors back onto a journey.
+ *
+ * Holds the journey sampled as a dense polyline in OKLab plus a bounding
+ * box hierarchy over its segments. It does not reference the journey, so
+ * the journey may be destroyed afterwards. Queries never modify the
+ * inverse; threads can share one and split batches.
+ */
+typedef struct CJ_JourneyInverse_Impl* CJ_JourneyInverse;
+
+/**
+ * @brief Build an inverse lookup for a journey.
+ *
+ * Samples the journey at @p samples evenly spaced t values (1024 is a good
+ * default). Query results are exact for the polyline; its deviation from
+ * the true journey shrinks with the square of the sample spacing.
+ *
+ * @param journey Journey to invert
+ * @param samples Polyline points, 2 to 65536
+ *
+ * @return Inverse handle, or NULL on invalid arguments or allocation failure.
+ *         Release with @ref cj_journey_inverse_destroy.
+ *
+ * **Example:**
+ * ```c
+ * CJ_JourneyInverse inverse = cj_journey_inverse_create(journey, 1024);
+ * float distance;
+ * float t = cj_journey_inverse_query(inverse, legend_color, &distance);
+ * cj_journey_inverse_destroy(inverse);
+ * ```
+ */
+CJ_JourneyInverse cj_journey_inverse_create(CJ_Journey journey, int samples);
+
+/**
+ * @brief Release an inverse lookup. NULL is ignored.
+ */
+void cj_journey_inverse_destroy(CJ_JourneyInverse inverse);
+
+/**
+ * @brief Find the journey position whose color is nearest (OKLab ΔE).
+ *
+ * Ties resolve to the smallest t.
+ *
+ * @param inverse Inverse lookup
+ * @param color Query color
+ * @param out_delta_e Optional: receives the ΔE between @p color and the journey at the returned t
+ *
+ * @return t in [0, 1], or -1 if @p inverse is NULL
+ */
+float cj_journey_inverse_query(CJ_JourneyInverse inverse, CJ_RGB color, float* out_delta_e);
+
+/**
+ * @brief Project many colors at once.
+ *
+ * @param inverse Inverse lookup
+ * @param colors Query colors
+ * @param count Number of colors
+ * @param out_t Receives t per color
+ * @param out_delta_e Optional: receives ΔE per color
+ */
+void cj_journey_inverse_query_batch(CJ_JourneyInverse inverse,
+                                    const CJ_RGB* colors,
+                                    int count,
+                                    float* out_t,
+                                    float* out_delta_e);
+
+/* ========================================================================
+ * Journey Fields (Bivariate Colormaps)
+ * ======================================================================== */
+
+/**
+ * @enum CJ_FieldInterpolation
+ * @brief How a @ref CJ_JourneyField blends between lattice nodes (in OKLab).
+ */
+typedef enum {
+    CJ_FIELD_BILINEAR = 0,  ///< Linear in u and v; never overshoots the nodes
+    CJ_FIELD_BICUBIC = 1    ///< Catmull-Rom in u and v; smooth across node rows
+} CJ_FieldInterpolation;
+
+/// Samples baked per journey by @ref cj_journey_field_create (u = i / 255).
+#define CJ_FIELD_JOURNEY_COLUMNS 256
+
+/// Largest lattice dimension (journeys, or anchor columns/rows).
+#define CJ_FIELD_MAX_LATTICE 1024
+
+/**
+ * @brief Opaque handle to a two-dimensional color field over (u, v) in [0, 1]².
+ *
+ * The field is a lattice of OKLab nodes, interpolated with
+ * @ref CJ_FieldInterpolation. It is immutable after creation, so threads
+ * can share one.
+ */
+typedef struct CJ_JourneyField_Impl* CJ_JourneyField;
+
+/**
+ * @brief Build a field that blends between journeys.
+ *
+ * Journey k becomes the lattice row at v = k / (count - 1), baked at
+ * @ref CJ_FIELD_JOURNEY_COLUMNS positions along u = t. The journeys are
+ * not referenced afterwards and may be destroyed.
+ *
+ * @param journeys Journeys from v = 0 to v = 1
+ * @param count Number of journeys, 2 to @ref CJ_FIELD_MAX_LATTICE
+ * @param interpolation Blending between rows (and baked columns)
+ *
+ * @return Field handle, or NULL on invalid arguments or allocation failure.
+ *         Release with @ref cj_journey_field_destroy.
+ *
+ * **Example:** value along u, uncertainty along v
+ * ```c
+ * CJ_Journey rows[2] = { vivid_journey, washed_out_journey };
+ * CJ_JourneyField field = cj_journey_field_create(rows, 2, CJ_FIELD_BILINEAR);
+ * CJ_RGB c = cj_journey_field_sample(field, value, uncertainty);
+ * cj_journey_field_destroy(field);
+ * ```
+ */
+CJ_JourneyField cj_journey_field_create(const CJ_Journey* journeys, int count, CJ_FieldInterpolation interpolation);
+
+/**
+ * @brief Build a field from a grid of anchor colors.
+ *
+ * Anchor (column i, row j) sits at u = i / (columns - 1),
+ * v = j / (rows - 1).
+ *
+ * @param anchors Row-major anchors: anchors[j * columns + i]
+ * @param columns Anchors per row, 2 to @ref CJ_FIELD_MAX_LATTICE
+ * @param rows Rows, 2 to @ref CJ_FIELD_MAX_LATTICE
+ * @param interpolation Blending between anchors
+ *
+ * @return Field handle, or NULL on invalid arguments or allocation failure.
+ */
+CJ_JourneyField cj_journey_field_create_grid(const CJ_RGB* anchors,
+                                             int columns,
+                                             int rows,
+                                             CJ_FieldInterpolation interpolation);
+
+/**
+ * @brief Release a field. NULL is ignored.
+ */
+void cj_journey_field_destroy(CJ_JourneyField field);
+
+/**
+ * @brief Sample the field.
+ *
+ * @param field Field handle
+ * @param u Horizontal coordinate, clamped to [0, 1] (NaN reads as 0)
+ * @param v Vertical coordinate, clamped to [0, 1] (NaN reads as 0)
+ *
+ * @return Color clamped to [0, 1], or black if @p field is NULL
+ */
+CJ_RGB cj_journey_field_sample(CJ_JourneyField field, float u, float v);
+
+/**
+ * @brief Sample the field at many (u, v) pairs.
+ *
+ * @param field Field handle
+ * @param u Horizontal coordinates
+ * @param v Vertical coordinates
+ * @param count Number of pairs
+ * @param out Receives one color per pair
+ */
+void cj_journey_field_sample_batch(CJ_JourneyField field, const float* u, const float* v, int count, CJ_RGB* out);
+
+/**
+ * @brief Rasterize the field into an 8-bit sRGB image.
+ *
+ * Pixel (x, y) shows u = x / (width - 1), v = y / (height - 1) (0 for a
+ * single column or row), so row 0 is v = 0. Colors are clamped and
+ * sRGB-encoded as described for @ref CJ_PixelFormat. Only rows
+ * [@p row_begin, @p row_end) are written; @p pixels always points at row 0.
+ * Each row is blended in v once and then interpolated along u, and nothing
+ * is allocated.
+ *
+ * **Threading:** the function keeps no state, so workers can rasterize
+ * disjoint row ranges of the same image:
+ * ```c
+ * // worker k of n:
+ * int y0 = height * k / n, y1 = height * (k + 1) / n;
+ * cj_journey_field_rasterize(field, pixels, width, height, stride,
+ *                            CJ_PIXEL_RGBA8, y0, y1);
+ * ```
+ *
+ * @param field Field handle
+ * @param pixels Destination image (row 0)
+ * @param width Pixels per row
+ * @param height Rows in the whole image
+ * @param stride Bytes from one row to the next
+ * @param format Pixel layout; alpha is set to 255
+ * @param row_begin First row to write
+ * @param row_end One past the last row to write (clamped to @p height)
+ *
+ * @note Does nothing if a pointer is NULL, a dimension is not positive, or
+ *       the stride is shorter than a row.
+ */
+void cj_journey_field_rasterize(CJ_JourneyField field,
+                                uint8_t* pixels,
+                                int width,
+                                int height,
+                                int stride,
+                                CJ_PixelFormat format,
+                                int row_begin,
+                                int row_end);
+
+/* ========================================================================
+ * Hot-Path Statistics (optional)
+ * ======================================================================== */
+
+/**
+ * @enum CJ_Stage
+ * @brief Stages of @ref cj_journey_sample timed by the statistics build.
+ */
+typedef enum {
+    CJ_STAGE_INTERPOLATE = 0,  ///< Waypoint interpolation
+    CJ_STAGE_DYNAMICS = 1,     ///< Lightness/chroma/temperature dynamics
+    CJ_STAGE_VARIATION = 2,    ///< Seeded variation
+    CJ_STAGE_CONVERT = 3,      ///< LCh → OKLab → RGB and clamp
+    CJ_STAGE_COUNT = 4
+} CJ_Stage;
+
+/**
+ * @struct CJ_Stats
+ * @brief Hot-path counters collected when built with @c CJ_ENABLE_STATS.
+ *
+ * Tick units are platform-specific (TSC cycles on x86, the virtual counter
+ * on ARM64, clock() ticks elsewhere); compare them within one machine only.
+ */
+typedef struct {
+    uint64_t samples;                          ///< cj_journey_sample calls
+    uint64_t stage_ticks[CJ_STAGE_COUNT];      ///< Accumulated ticks per CJ_Stage
+    uint64_t delta_checks;                     ///< enforce_delta_range calls with a previous color
+    uint64_t delta_searches;                   ///< Binary searches started (up to two per violation)
+    uint64_t delta_search_iterations;          ///< Binary search iterations across all searches
+    uint64_t delta_fallbacks;                  ///< Violations resolved by the last-resort t + 0.05 step
+    uint64_t contrast_checks;                  ///< apply_minimum_contrast calls with a previous color
+    uint64_t contrast_adjustments;             ///< Colors whose lightness was adjusted for contrast
+} CJ_Stats;
+
+/**
+ * @brief Report whether this build collects statistics.
+ *
+ * @return true if the library was compiled with @c CJ_ENABLE_STATS.
+ */
+bool cj_stats_enabled(void);
+
+/**
+ * @brief Copy the calling thread's counters.
+ *
+ * Counters are thread-local so concurrent callers never share a cache line;
+ * read them from the thread that generated the colors. Without
+ * @c CJ_ENABLE_STATS the snapshot is all zeros.
+ *
+ * **Example:**
+ * ```c
+ * cj_stats_reset();
+ * cj_journey_discrete(journey, 100, palette);
+ * CJ_Stats stats;
+ * cj_stats_snapshot(&stats);
+ * printf("%.1f samples per color\n", stats.samples / 100.0);
+ * ```
+ *
+ * @param out Destination (must not be NULL)
+ */
+void cj_stats_snapshot(CJ_Stats* out);
+
+/**
+ * @brief Zero the calling thread's counters.
+ */
+void cj_stats_reset(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,432 @@
+/**
+ * colorjourney_accuracy - exhaustive accuracy verifier for the conversion kernels
+ *
+ * Every kernel in kernels[] is compared against a double-precision reference
+ * written straight from Ottosson's OKLab definition, over one of two domains:
+ *
+ * - RGB8: all 256^3 inputs k/255 per channel (--rgb-step to thin it out).
+ * - LCh grid: L in [0, 1], C in [0, 0.4], h in [0, 2pi) on a dense grid
+ *   (--grid L,C,h points per axis, default 257,201,720).
+ *
+ * The error of one input is the OKLab Euclidean distance (delta E) between
+ * the kernel's result and the reference, measured in OKLab even for kernels
+ * that return RGB or LCh. For each kernel the verifier prints the point
+ * count, max and mean error, the worst input and its bound; the exit status
+ * is 1 if any maximum exceeds its bound, so a fast kernel cannot land while
+ * it is less accurate than its bound allows. Work is split across --threads
+ * (default: online CPUs) by the outermost axis.
+ *
+ * To verify a new fast path, add it to kernels[] with the bound it
+ * promises; the library functions it replaces stay available as reference.
+ *
+ * Usage: colorjourney_accuracy [--threads <n>] [--rgb-step <k>] [--grid L,C,h]
+ *                              [--kernel <substring>] [--json <path|->]
+ */
+
+#include "ColorJourney.h"
+
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/* ---- Reference ------------------------------------------------------- */
+
+typedef struct {
+    double L, a, b;
+} RefLab;
+
+static RefLab ref_rgb_to_oklab(double r, double g, double b) {
+    const double l = cbrt(0.4122214708 * r + 0.5363325363 * g + 0.0514459929 * b);
+    const double m = cbrt(0.2119034982 * r + 0.6806995451 * g + 0.1073969566 * b);
+    const double s = cbrt(0.0883024619 * r + 0.2817188376 * g + 0.6299787005 * b);
+    RefLab lab = {
+        0.2104542553 * l + 0.7936177850 * m - 0.0040720468 * s,
+        1.9779984951 * l - 2.4285922050 * m + 0.4505937099 * s,
+        0.0259040371 * l + 0.7827717662 * m - 0.8086757660 * s,
+    };
+    return lab;
+}
+
+/* sRGB-encoded [0, 1] to linear, for the 8-bit pixel kernels */
+static double ref_srgb_decode(double v) {
+    return v <= 0.04045 ? v / 12.92 : pow((v + 0.055) / 1.055, 2.4);
+}
+
+static RefLab ref_lch_to_oklab(double L, double C, double h) {
+    RefLab lab = {L, C * cos(h), C * sin(h)};
+    return lab;
+}
+
+static double ref_delta_e(RefLab x, double L, double a, double b) {
+    const double dL = x.L - L;
+    const double da = x.a - a;
+    const double db = x.b - b;
+    return sqrt(dL * dL + da * da + db * db);
+}
+
+/* ---- Kernels under test ---------------------------------------------- */
+
+typedef enum { DOMAIN_RGB8, DOMAIN_LCH } Domain;
+
+/* One input: RGB in [0, 1] for DOMAIN_RGB8, (L, C, h) for DOMAIN_LCH. */
+typedef double (*KernelError)(const double in[3]);
+
+typedef struct {
+    const char* name;
+    Domain domain;
+    KernelError error;
+    double bound; /* max delta E */
+} Kernel;
+
+static double error_rgb_to_oklab(const double in[3]) {
+    const CJ_RGB rgb = {(float)in[0], (float)in[1], (float)in[2]};
+    const CJ_Lab lab = cj_rgb_to_oklab(rgb);
+    return ref_delta_e(ref_rgb_to_oklab(in[0], in[1], in[2]), lab.L, lab.a, lab.b);
+}
+
+/* Invert the reference Lab of each RGB8 color, then measure the result in OKLab. */
+static double error_oklab_to_rgb(const double in[3]) {
+    const RefLab exact = ref_rgb_to_oklab(in[0], in[1], in[2]);
+    const CJ_Lab lab = {(float)exact.L, (float)exact.a, (float)exact.b};
+    const CJ_RGB rgb = cj_oklab_to_rgb(lab);
+    const RefLab back = ref_rgb_to_oklab(rgb.r, rgb.g, rgb.b);
+    return ref_delta_e(exact, back.L, back.a, back.b);
+}
+
+static double error_lch_to_oklab(const double in[3]) {
+    const CJ_LCh lch = {(float)in[0], (float)in[1], (float)in[2]};
+    const CJ_Lab lab = cj_lch_to_oklab(lch);
+    return ref_delta_e(ref_lch_to_oklab(in[0], in[1], in[2]), lab.L, lab.a, lab.b);
+}
+
+static double error_oklab_to_lch(const double in[3]) {
+    const RefLab exact = ref_lch_to_oklab(in[0], in[1], in[2]);
+    const CJ_Lab lab = {(float)exact.L, (float)exact.a, (float)exact.b};
+    const CJ_LCh lch = cj_oklab_to_lch(lab);
+    const RefLab back = ref_lch_to_oklab(lch.L, lch.C, lch.h);
+    return ref_delta_e(exact, back.L, back.a, back.b);
+}
+
+/*
+ * Gradient map of one pixel through a fixed journey baked in main(). The
+ * RGB8 input k/255 is the sRGB-encoded pixel byte k; table entries and
+ * mapped pixels are sRGB-encoded too.
+ */
+static CJ_Journey gradient_journey;
+static CJ_GradientTable gradient_table;
+
+static RefLab decode_entry(const uint8_t rgb[3]) {
+    return ref_rgb_to_oklab(ref_srgb_decode(rgb[0] / 255.0), ref_srgb_decode(rgb[1] / 255.0),
+                            ref_srgb_decode(rgb[2] / 255.0));
+}
+
+static double pixel_lightness(const double in[3]) {
+    return ref_rgb_to_oklab(ref_srgb_decode(in[0]), ref_srgb_decode(in[1]), ref_srgb_decode(in[2])).L;
+}
+
+static void map_pixel(const double in[3], uint8_t out[3]) {
+    const uint8_t pixel[3] = {(uint8_t)lround(in[0] * 255.0), (uint8_t)lround(in[1] * 255.0),
+                              (uint8_t)lround(in[2] * 255.0)};
+    const CJ_GradientMapOptions options = {true, &gradient_table};
+    cj_image_gradient_map(gradient_journey, pixel, out, 1, 1, 3, CJ_PIXEL_RGB8, &options);
+}
+
+/* Fast lightness only: the entry picked vs the entry the exact L picks. */
+static double error_gradient_map_lookup(const double in[3]) {
+    uint8_t out[3];
+    map_pixel(in, out);
+    const double L = pixel_lightness(in);
+    const double clamped = L < 0.0 ? 0.0 : (L > 1.0 ? 1.0 : L);
+    const RefLab exact = decode_entry(gradient_table.rgb[lround(clamped * (CJ_GRADIENT_TABLE_SIZE - 1))]);
+    const RefLab mapped = decode_entry(out);
+    return ref_delta_e(exact, mapped.L, mapped.a, mapped.b);
+}
+
+/* End to end: the mapped pixel vs cj_journey_sample at the exact L (table and 8-bit rounding included). */
+static double error_gradient_map_sample(const double in[3]) {
+    uint8_t out[3];
+    map_pixel(in, out);
+    const double L = pixel_lightness(in);
+    const CJ_RGB sample = cj_rgb_clamp(cj_journey_sample(gradient_journey, (float)(L > 1.0 ? 1.0 : L)));
+    const RefLab exact = ref_rgb_to_oklab(sample.r, sample.g, sample.b);
+    const RefLab mapped = decode_entry(out);
+    return ref_delta_e(exact, mapped.L, mapped.a, mapped.b);
+}
+
+/* Nearest palette entry for a 16-color palette of the same journey, built in main(). */
+#define PALETTE_COUNT 16
+static CJ_RGB palette[PALETTE_COUNT];
+static RefLab palette_lab[PALETTE_COUNT];
+static CJ_PaletteIndex palette_index;
+
+/* How much farther the chosen entry is than the true nearest one. */
+static double palette_excess(const double in[3], int chosen) {
+    const RefLab query = ref_rgb_to_oklab(in[0], in[1], in[2]);
+    double nearest = INFINITY;
+    for (int i = 0; i < PALETTE_COUNT; i++) {
+        const double de = ref_delta_e(query, palette_lab[i].L, palette_lab[i].a, palette_lab[i].b);
+        if (de < nearest) nearest = de;
+    }
+    const RefLab picked = palette_lab[chosen];
+    return ref_delta_e(query, picked.L, picked.a, picked.b) - nearest;
+}
+
+static double error_palette_exact(const double in[3]) {
+    const CJ_RGB color = {(float)in[0], (float)in[1], (float)in[2]};
+    return palette_excess(in, cj_palette_index_nearest(palette_index, color, NULL));
+}
+
+static double error_palette_grid(const double in[3]) {
+    const CJ_RGB color = {(float)in[0], (float)in[1], (float)in[2]};
+    return palette_excess(in, cj_palette_index_nearest_approx(palette_index, color));
+}
+
+/* The same grid queried with decoded 8-bit pixels, which crowd toward black. */
+static double error_palette_grid_px(const double in[3]) {
+    const double linear[3] = {ref_srgb_decode(in[0]), ref_srgb_decode(in[1]), ref_srgb_decode(in[2])};
+    const CJ_RGB color = {(float)linear[0], (float)linear[1], (float)linear[2]};
+    return palette_excess(linear, cj_palette_index_nearest_approx(palette_index, color));
+}
+
+/* Float kernels: a few float ULPs (~1e-7) per component is the floor. */
+static const Kernel kernels[] = {
+    {"rgb_to_oklab", DOMAIN_RGB8, error_rgb_to_oklab, 1e-5},
+    {"oklab_to_rgb", DOMAIN_RGB8, error_oklab_to_rgb, 1e-5},
+    {"lch_to_oklab", DOMAIN_LCH, error_lch_to_oklab, 1e-5},
+    {"oklab_to_lch", DOMAIN_LCH, error_oklab_to_lch, 1e-5},
+    /* Fast-cbrt lightness may pick the neighbouring entry at a rounding boundary (~4e-3 apart). */
+    {"gradient_lookup", DOMAIN_RGB8, error_gradient_map_lookup, 5e-3},
+    {"gradient_sample", DOMAIN_RGB8, error_gradient_map_sample, 5e-3},
+    /* Exact search may only differ from the reference on float-rounding ties. */
+    {"palette_exact", DOMAIN_RGB8, error_palette_exact, 1e-5},
+    /* 32^3 grid spaced in sRGB bytes: a color near a cell boundary may get the neighbouring entry. */
+    {"palette_grid", DOMAIN_RGB8, error_palette_grid, 0.03},
+    {"palette_grid_px", DOMAIN_RGB8, error_palette_grid_px, 0.03},
+};
+
+/* ---- Sweep ------------------------------------------------------------ */
+
+typedef struct {
+    double max_error;
+    double sum_error;
+    unsigned long long points;
+    double worst[3];
+} Accumulator;
+
+typedef struct {
+    const Kernel* kernel;
+    int rgb_step;
+    int grid[3];
+    int outer_count;
+    int next_outer; /* shared work counter */
+    pthread_mutex_t lock;
+    Accumulator total;
+} Sweep;
+
+static void accumulate(Accumulator* acc, const double in[3], double error) {
+    if (error > acc->max_error || acc->points == 0 || error != error) {
+        acc->max_error = error != error ? INFINITY : error;
+        memcpy(acc->worst, in, sizeof(acc->worst));
+    }
+    acc->sum_error += error;
+    acc->points++;
+}
+
+static void sweep_outer(const Sweep* sweep, int outer, Accumulator* acc) {
+    double in[3];
+    if (sweep->kernel->domain == DOMAIN_RGB8) {
+        in[0] = (outer * sweep->rgb_step) / 255.0;
+        for (int g = 0; g < 256; g += sweep->rgb_step) {
+            in[1] = g / 255.0;
+            for (int b = 0; b < 256; b += sweep->rgb_step) {
+                in[2] = b / 255.0;
+                accumulate(acc, in, sweep->kernel->error(in));
+            }
+        }
+    } else {
+        in[0] = (double)outer / (sweep->grid[0] - 1);
+        for (int c = 0; c < sweep->grid[1]; c++) {
+            in[1] = 0.4 * c / (sweep->grid[1] - 1);
+            for (int h = 0; h < sweep->grid[2]; h++) {
+                in[2] = 2.0 * M_PI * h / sweep->grid[2];
+                accumulate(acc, in, sweep->kernel->error(in));
+            }
+        }
+    }
+}
+
+static void* sweep_worker(void* arg) {
+    Sweep* sweep = (Sweep*)arg;
+    Accumulator acc;
+    memset(&acc, 0, sizeof(acc));
+    for (;;) {
+        pthread_mutex_lock(&sweep->lock);
+        const int outer = sweep->next_outer++;
+        pthread_mutex_unlock(&sweep->lock);
+        if (outer >= sweep->outer_count) {
+            break;
+        }
+        sweep_outer(sweep, outer, &acc);
+    }
+
+    pthread_mutex_lock(&sweep->lock);
+    if (acc.points > 0 && (sweep->total.points == 0 || acc.max_error > sweep->total.max_error)) {
+        sweep->total.max_error = acc.max_error;
+        memcpy(sweep->total.worst, acc.worst, sizeof(acc.worst));
+    }
+    sweep->total.sum_error += acc.sum_error;
+    sweep->total.points += acc.points;
+    pthread_mutex_unlock(&sweep->lock);
+    return NULL;
+}
+
+static void run_sweep(Sweep* sweep, int thread_count) {
+    pthread_t threads[256];
+    int started = 0;
+    for (; started < thread_count; started++) {
+        if (pthread_create(&threads[started], NULL, sweep_worker, sweep) != 0) {
+            break;
+        }
+    }
+    if (started == 0) {
+        sweep_worker(sweep);
+    }
+    for (int i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+}
+
+static void format_input(const Kernel* kernel, const double in[3], char* out, size_t size) {
+    if (kernel->domain == DOMAIN_RGB8) {
+        snprintf(out, size, "rgb8(%d,%d,%d)", (int)lround(in[0] * 255.0), (int)lround(in[1] * 255.0),
+                 (int)lround(in[2] * 255.0));
+    } else {
+        snprintf(out, size, "lch(%.4f,%.4f,%.4f)", in[0], in[1], in[2]);
+    }
+}
+
+static void print_usage(const char* program) {
+    printf("Usage: %s [--threads <n>] [--rgb-step <k>] [--grid L,C,h] [--kernel <substring>] [--json <path|->]\n",
+           program);
+}
+
+int main(int argc, char** argv) {
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    int thread_count = online > 0 ? (int)online : 1;
+    int rgb_step = 1;
+    int grid[3] = {257, 201, 720};
+    const char* filter = NULL;
+    const char* json_path = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            thread_count = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--rgb-step") == 0 && i + 1 < argc) {
+            rgb_step = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--grid") == 0 && i + 1 < argc) {
+            if (sscanf(argv[++i], "%d,%d,%d", &grid[0], &grid[1], &grid[2]) != 3) {
+                fprintf(stderr, "--grid expects L,C,h\n");
+                return 2;
+            }
+        } else if (strcmp(argv[i], "--kernel") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (strcmp(argv[i], "--help") == 0) {
+            print_usage(argv[0]);
+            return 0;
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+    if (thread_count < 1 || thread_count > 256 || rgb_step < 1 || rgb_step > 255 || grid[0] < 2 || grid[1] < 2 ||
+        grid[2] < 1) {
+        fprintf(stderr, "Invalid --threads, --rgb-step or --grid\n");
+        return 2;
+    }
+
+    CJ_Config config;
+    cj_config_init(&config);
+    config.anchor_count = 2;
+    config.anchors[0] = (CJ_RGB){0.10f, 0.05f, 0.30f};
+    config.anchors[1] = (CJ_RGB){0.95f, 0.75f, 0.20f};
+    gradient_journey = cj_journey_create(&config);
+    cj_gradient_table_bake(gradient_journey, &gradient_table);
+    cj_journey_discrete(gradient_journey, PALETTE_COUNT, palette);
+    for (int i = 0; i < PALETTE_COUNT; i++) {
+        palette_lab[i] = ref_rgb_to_oklab(palette[i].r, palette[i].g, palette[i].b);
+    }
+    palette_index = cj_palette_index_create(palette, PALETTE_COUNT, 32);
+
+    FILE* out = stdout;
+    if (json_path) {
+        out = strcmp(json_path, "-") == 0 ? stdout : fopen(json_path, "w");
+        if (!out) {
+            fprintf(stderr, "Cannot write %s\n", json_path);
+            return 1;
+        }
+        fprintf(out, "{\n  \"schema\": \"colorjourney-accuracy/1\",\n  \"kernels\": [\n");
+    } else {
+        printf("%-16s %12s %12s %12s %10s  %-34s %s\n", "kernel", "points", "max dE", "mean dE", "bound", "worst input",
+               "status");
+    }
+
+    int failures = 0;
+    int printed = 0;
+    const size_t kernel_count = sizeof(kernels) / sizeof(kernels[0]);
+    for (size_t k = 0; k < kernel_count; k++) {
+        if (filter && !strstr(kernels[k].name, filter)) {
+            continue;
+        }
+        Sweep sweep;
+        memset(&sweep, 0, sizeof(sweep));
+        sweep.kernel = &kernels[k];
+        sweep.rgb_step = rgb_step;
+        memcpy(sweep.grid, grid, sizeof(grid));
+        sweep.outer_count = kernels[k].domain == DOMAIN_RGB8 ? (255 / rgb_step) + 1 : grid[0];
+        pthread_mutex_init(&sweep.lock, NULL);
+        run_sweep(&sweep, thread_count);
+        pthread_mutex_destroy(&sweep.lock);
+
+        const Accumulator* total = &sweep.total;
+        const double mean = total->points ? total->sum_error / (double)total->points : 0.0;
+        const int pass = total->max_error <= kernels[k].bound;
+        char worst[64];
+        format_input(&kernels[k], total->worst, worst, sizeof(worst));
+        failures += !pass;
+
+        if (json_path) {
+            fprintf(out, "%s    {\"name\": \"%s\", \"points\": %llu, \"maxDeltaE\": %.3e, \"meanDeltaE\": %.3e, "
+                         "\"bound\": %.3e, \"worstInput\": \"%s\", \"pass\": %s}",
+                    printed ? ",\n" : "", kernels[k].name, total->points, total->max_error, mean, kernels[k].bound,
+                    worst, pass ? "true" : "false");
+        } else {
+            printf("%-16s %12llu %12.3e %12.3e %10.1e  %-34s %s\n", kernels[k].name, total->points, total->max_error,
+                   mean, kernels[k].bound, worst, pass ? "ok" : "FAIL");
+        }
+        printed++;
+    }
+
+    if (json_path) {
+        fprintf(out, "\n  ]\n}\n");
+        if (out != stdout) {
+            fclose(out);
+        }
+    }
+    cj_palette_index_destroy(palette_index);
+    cj_journey_destroy(gradient_journey);
+    if (failures > 0) {
+        fprintf(stderr, "%d kernel(s) exceeded their accuracy bound\n", failures);
+        return 1;
+    }
+    return 0;
+}
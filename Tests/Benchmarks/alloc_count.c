@@ -0,0 +1,126 @@
+/**
+ * Counting allocator - see alloc_count.h.
+ *
+ * Counters are process-wide relaxed atomics so allocations from any thread
+ * are seen. Live bytes use malloc_usable_size() so free() needs no header.
+ */
+
+#define _GNU_SOURCE
+
+#include "alloc_count.h"
+
+#include <errno.h>
+#include <malloc.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t count, size_t size);
+extern void* __libc_realloc(void* ptr, size_t size);
+extern void* __libc_memalign(size_t alignment, size_t size);
+extern void __libc_free(void* ptr);
+
+static uint64_t allocations;
+static uint64_t frees;
+static uint64_t bytes_requested;
+static uint64_t live_bytes;
+static uint64_t peak_live_bytes;
+
+static void count_alloc(void* ptr, size_t requested) {
+    if (!ptr) {
+        return;
+    }
+    __atomic_fetch_add(&allocations, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&bytes_requested, requested, __ATOMIC_RELAXED);
+    const uint64_t live = __atomic_add_fetch(&live_bytes, malloc_usable_size(ptr), __ATOMIC_RELAXED);
+    uint64_t peak = __atomic_load_n(&peak_live_bytes, __ATOMIC_RELAXED);
+    while (live > peak &&
+           !__atomic_compare_exchange_n(&peak_live_bytes, &peak, live, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+static void count_free(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+    __atomic_fetch_add(&frees, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_sub(&live_bytes, malloc_usable_size(ptr), __ATOMIC_RELAXED);
+}
+
+void* malloc(size_t size) {
+    void* ptr = __libc_malloc(size);
+    count_alloc(ptr, size);
+    return ptr;
+}
+
+void* calloc(size_t count, size_t size) {
+    void* ptr = __libc_calloc(count, size);
+    count_alloc(ptr, count * size);
+    return ptr;
+}
+
+void* realloc(void* ptr, size_t size) {
+    count_free(ptr);
+    void* result = __libc_realloc(ptr, size);
+    if (!result && ptr && size != 0) {
+        /* Failed realloc leaves the old block allocated. */
+        __atomic_fetch_sub(&frees, 1, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&live_bytes, malloc_usable_size(ptr), __ATOMIC_RELAXED);
+        return NULL;
+    }
+    count_alloc(result, size);
+    return result;
+}
+
+void free(void* ptr) {
+    count_free(ptr);
+    __libc_free(ptr);
+}
+
+void* memalign(size_t alignment, size_t size) {
+    void* ptr = __libc_memalign(alignment, size);
+    count_alloc(ptr, size);
+    return ptr;
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+    return memalign(alignment, size);
+}
+
+int posix_memalign(void** out, size_t alignment, size_t size) {
+    if (alignment < sizeof(void*) || (alignment & (alignment - 1)) != 0) {
+        return EINVAL;
+    }
+    void* ptr = memalign(alignment, size);
+    if (!ptr) {
+        return ENOMEM;
+    }
+    *out = ptr;
+    return 0;
+}
+
+void bench_alloc_snapshot(BenchAllocStats* out) {
+    out->allocations = __atomic_load_n(&allocations, __ATOMIC_RELAXED);
+    out->frees = __atomic_load_n(&frees, __ATOMIC_RELAXED);
+    out->bytes_requested = __atomic_load_n(&bytes_requested, __ATOMIC_RELAXED);
+    out->live_bytes = __atomic_load_n(&live_bytes, __ATOMIC_RELAXED);
+    out->peak_live_bytes = __atomic_load_n(&peak_live_bytes, __ATOMIC_RELAXED);
+}
+
+void bench_alloc_reset(void) {
+    __atomic_store_n(&allocations, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&frees, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&bytes_requested, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&peak_live_bytes, __atomic_load_n(&live_bytes, __ATOMIC_RELAXED), __ATOMIC_RELAXED);
+}
+
+__attribute__((destructor)) static void report_at_exit(void) {
+    if (!getenv("CJ_ALLOC_REPORT")) {
+        return;
+    }
+    BenchAllocStats stats;
+    bench_alloc_snapshot(&stats);
+    fprintf(stderr, "alloc_count: %llu allocations, %llu frees, %llu bytes requested, peak %llu live bytes\n",
+            (unsigned long long)stats.allocations, (unsigned long long)stats.frees,
+            (unsigned long long)stats.bytes_requested, (unsigned long long)stats.peak_live_bytes);
+}
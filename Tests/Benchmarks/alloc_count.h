@@ -0,0 +1,32 @@
+/**
+ * Counting allocator (glibc only)
+ *
+ * alloc_count.c defines malloc/calloc/realloc/free and the aligned variants
+ * on top of glibc's __libc_* entry points and counts every call. Linked into
+ * an executable it interposes on all allocations in that process. Built as a
+ * shared library it works as an LD_PRELOAD shim for any binary, e.g. the
+ * Swift test runner, which finds bench_alloc_snapshot() through dlsym().
+ * With CJ_ALLOC_REPORT set in the environment the shim prints process totals
+ * to stderr at exit.
+ */
+
+#ifndef ALLOC_COUNT_H
+#define ALLOC_COUNT_H
+
+#include <stdint.h>
+
+/* Five uint64_t fields in this order; the Swift tests read them as an array. */
+typedef struct {
+    uint64_t allocations;     /* malloc, calloc, realloc and aligned calls */
+    uint64_t frees;           /* free of non-NULL pointers, realloc moves included */
+    uint64_t bytes_requested; /* sum of requested sizes */
+    uint64_t live_bytes;      /* usable bytes currently allocated */
+    uint64_t peak_live_bytes; /* high-water mark of live_bytes since the last reset */
+} BenchAllocStats;
+
+void bench_alloc_snapshot(BenchAllocStats* out);
+
+/* Zeroes the counters and restarts the peak from the current live bytes. */
+void bench_alloc_reset(void);
+
+#endif /* ALLOC_COUNT_H */
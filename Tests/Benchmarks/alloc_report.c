@@ -0,0 +1,275 @@
+/**
+ * colorjourney_alloc_report - allocations, bytes and peak RSS per API call
+ *
+ * Linked with alloc_count.c, so every malloc/free in the process is counted.
+ * Each case runs once to warm up, then `calls` times with fresh counters,
+ * and reports per call:
+ *
+ * - allocations, frees and requested bytes,
+ * - peak live heap growth over the measured calls,
+ * - growth of the process peak RSS (getrusage ru_maxrss).
+ *
+ * Every case has an allocation budget that mirrors a documented guarantee:
+ * sampling, discrete generation and conversions allocate nothing (see the
+ * header comment of ColorJourney.c), and so do palette index and journey
+ * inverse queries and field rasterization; cj_journey_create allocates
+ * exactly its handle, cj_extract_anchors its sample buffer and the WASM
+ * engine's generate_discrete_palette its output.
+ * With --check the exit status is 1 if any case exceeds its budget or leaks.
+ *
+ * Usage: colorjourney_alloc_report [--check] [--json <path|->]
+ */
+
+#include "alloc_count.h"
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+
+/* alloc_report_wasm.c */
+void alloc_report_wasm_palette(int count);
+
+typedef struct {
+    CJ_Journey journey;
+    CJ_Journey created;
+    CJ_Config config;
+    CJ_RGB buffer[1000];
+    CJ_PaletteIndex palette_index;
+    CJ_JourneyInverse inverse;
+    CJ_JourneyField field;
+    int indices[1000];
+    float contrast[1000 * 4];
+    bool pass[1000 * 4];
+    uint8_t pixels[1000 * 4];
+} AllocContext;
+
+typedef void (*AllocCaseFn)(AllocContext* context);
+
+typedef struct {
+    const char* name;
+    AllocCaseFn run;
+    int calls;
+    uint64_t max_allocations; /* per call */
+    int balanced;             /* every allocation freed within the call */
+} AllocCase;
+
+static void run_sample(AllocContext* context) {
+    for (int i = 0; i < 1000; i++) {
+        bench_consume_rgb(cj_journey_sample(context->journey, (float)i / 999.0f));
+    }
+}
+
+static void run_discrete_100(AllocContext* context) {
+    cj_journey_discrete(context->journey, 100, context->buffer);
+}
+
+static void run_discrete_1000(AllocContext* context) {
+    cj_journey_discrete(context->journey, 1000, context->buffer);
+}
+
+static void run_discrete_at(AllocContext* context) {
+    bench_consume_rgb(cj_journey_discrete_at(context->journey, 100));
+}
+
+static void run_discrete_range(AllocContext* context) {
+    cj_journey_discrete_range(context->journey, 0, 100, context->buffer);
+}
+
+static void run_conversions(AllocContext* context) {
+    const CJ_Lab lab = cj_rgb_to_oklab(context->config.anchors[0]);
+    bench_consume_rgb(cj_oklab_to_rgb(lab));
+    bench_consume_float(cj_delta_e(lab, cj_rgb_to_oklab(context->config.anchors[1])));
+}
+
+static void run_create(AllocContext* context) {
+    cj_journey_destroy(context->created);
+    context->created = cj_journey_create(&context->config);
+}
+
+static void run_create_destroy(AllocContext* context) {
+    cj_journey_destroy(cj_journey_create(&context->config));
+}
+
+static void run_palette_index_nearest(AllocContext* context) {
+    cj_palette_index_nearest_batch(context->palette_index, context->buffer, 1000, context->indices, false);
+    cj_palette_index_nearest_batch(context->palette_index, context->buffer, 1000, context->indices, true);
+}
+
+static void run_extract_anchors(AllocContext* context) {
+    CJ_RGB anchors[8];
+    bench_consume_float((float)cj_extract_anchors((const uint8_t*)context->buffer, 100, 30, 400,
+                                                  CJ_PIXEL_RGBA8, 4, anchors));
+}
+
+static void run_cvd_adjacent(AllocContext* context) {
+    bench_consume_float(cj_palette_cvd_min_delta_e(context->buffer, 100, CJ_CVD_DEUTAN, false));
+}
+
+static void run_cvd_all_pairs(AllocContext* context) {
+    bench_consume_float(cj_palette_cvd_min_delta_e(context->buffer, 100, CJ_CVD_DEUTAN, true));
+}
+
+static void run_contrast(AllocContext* context) {
+    cj_contrast_wcag_batch(context->buffer, 1000, context->buffer, 4, context->contrast, 4.5f, context->pass);
+    cj_contrast_apca_batch(context->buffer, 1000, context->buffer, 4, context->contrast, 60.0f, context->pass);
+}
+
+static void run_colormap(AllocContext* context) {
+    CJ_ColormapOptions options;
+    cj_colormap_options_init(&options);
+    options.normalization = CJ_NORM_HISTOGRAM;
+    cj_colormap_apply(context->journey, context->contrast, 1000, 0.0f, 30.0f, context->pixels, CJ_PIXEL_RGBA8, &options);
+}
+
+static void run_journey_inverse_query(AllocContext* context) {
+    cj_journey_inverse_query_batch(context->inverse, context->buffer, 1000, context->contrast, NULL);
+}
+
+static void run_journey_field(AllocContext* context) {
+    cj_journey_field_rasterize(context->field, context->pixels, 100, 10, 400, CJ_PIXEL_RGBA8, 0, 10);
+}
+
+static void run_wasm_palette(AllocContext* context) {
+    (void)context;
+    alloc_report_wasm_palette(100);
+}
+
+static const AllocCase cases[] = {
+    {"journey_sample/x1000", run_sample, 10, 0, 1},
+    {"journey_discrete/n=100", run_discrete_100, 10, 0, 1},
+    {"journey_discrete/n=1000", run_discrete_1000, 10, 0, 1},
+    {"journey_discrete_at/index=100", run_discrete_at, 10, 0, 1},
+    {"journey_discrete_range/n=100", run_discrete_range, 10, 0, 1},
+    {"conversions", run_conversions, 10, 0, 1},
+    {"journey_create", run_create, 10, 1, 0},
+    {"journey_create_destroy", run_create_destroy, 10, 1, 1},
+    {"palette_index_nearest_batch/x1000", run_palette_index_nearest, 10, 0, 1},
+    {"extract_anchors/k=4,100x30", run_extract_anchors, 10, 1, 1},
+    {"palette_cvd_min_delta_e/adjacent,n=100", run_cvd_adjacent, 10, 0, 1},
+    {"palette_cvd_min_delta_e/all_pairs,n=100", run_cvd_all_pairs, 10, 1, 1},
+    {"contrast_wcag_apca_batch/1000x4", run_contrast, 10, 0, 1},
+    {"colormap_apply/histogram,n=1000", run_colormap, 10, 0, 1},
+    {"journey_inverse_query_batch/x1000", run_journey_inverse_query, 10, 0, 1},
+    {"journey_field_rasterize/100x10", run_journey_field, 10, 0, 1},
+    {"wasm_generate_discrete_palette/n=100", run_wasm_palette, 10, 1, 1},
+};
+
+static long peak_rss_kb(void) {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+static void print_usage(const char* program) {
+    printf("Usage: %s [--check] [--json <path|->]\n", program);
+}
+
+int main(int argc, char** argv) {
+    int check = 0;
+    const char* json_path = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--check") == 0) {
+            check = 1;
+        } else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (strcmp(argv[i], "--help") == 0) {
+            print_usage(argv[0]);
+            return 0;
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    AllocContext* context = calloc(1, sizeof(AllocContext));
+    if (!context) {
+        return 1;
+    }
+    cj_config_init(&context->config);
+    context->config.anchor_count = 2;
+    context->config.anchors[0] = (CJ_RGB){0.85f, 0.35f, 0.25f};
+    context->config.anchors[1] = (CJ_RGB){0.25f, 0.45f, 0.85f};
+    context->config.contrast_level = CJ_CONTRAST_HIGH;
+    context->journey = cj_journey_create(&context->config);
+    cj_journey_discrete(context->journey, 1000, context->buffer);
+    context->palette_index = cj_palette_index_create(context->buffer, 64, 16);
+    context->inverse = cj_journey_inverse_create(context->journey, 1024);
+    context->field = cj_journey_field_create_grid(context->buffer, 10, 10, CJ_FIELD_BICUBIC);
+
+    FILE* out = stdout;
+    if (json_path) {
+        out = strcmp(json_path, "-") == 0 ? stdout : fopen(json_path, "w");
+        if (!out) {
+            fprintf(stderr, "Cannot write %s\n", json_path);
+            return 1;
+        }
+        fprintf(out, "{\n  \"schema\": \"colorjourney-alloc/1\",\n  \"cases\": [\n");
+    } else {
+        printf("%-38s %8s %8s %10s %12s %8s %8s\n", "case", "allocs", "frees", "bytes", "peak heap", "rss KB", "status");
+    }
+
+    const size_t case_count = sizeof(cases) / sizeof(cases[0]);
+    int failures = 0;
+    for (size_t c = 0; c < case_count; c++) {
+        const AllocCase* alloc_case = &cases[c];
+        alloc_case->run(context);
+
+        BenchAllocStats before, after;
+        bench_alloc_reset();
+        bench_alloc_snapshot(&before);
+        const long rss_before = peak_rss_kb();
+        for (int i = 0; i < alloc_case->calls; i++) {
+            alloc_case->run(context);
+        }
+        const long rss_after = peak_rss_kb();
+        bench_alloc_snapshot(&after);
+
+        const double calls = (double)alloc_case->calls;
+        const uint64_t allocs = after.allocations - before.allocations;
+        const uint64_t frees = after.frees - before.frees;
+        const uint64_t peak_growth = after.peak_live_bytes - before.live_bytes;
+        const int over_budget = allocs > alloc_case->max_allocations * (uint64_t)alloc_case->calls;
+        const int leaked = alloc_case->balanced && after.live_bytes != before.live_bytes;
+        const char* status = over_budget ? "OVER" : leaked ? "LEAK" : "ok";
+        failures += over_budget || leaked;
+
+        if (json_path) {
+            fprintf(out, "    {\"name\": \"%s\", \"calls\": %d, \"allocationsPerCall\": %.2f, \"freesPerCall\": %.2f, "
+                         "\"bytesPerCall\": %.0f, \"peakHeapGrowthBytes\": %llu, \"peakRssGrowthKb\": %ld, "
+                         "\"maxAllocationsPerCall\": %llu, \"status\": \"%s\"}%s\n",
+                    alloc_case->name, alloc_case->calls, (double)allocs / calls, (double)frees / calls,
+                    (double)(after.bytes_requested - before.bytes_requested) / calls,
+                    (unsigned long long)peak_growth, rss_after - rss_before,
+                    (unsigned long long)alloc_case->max_allocations, status, c + 1 < case_count ? "," : "");
+        } else {
+            printf("%-38s %8.2f %8.2f %10.0f %12llu %8ld %8s\n", alloc_case->name, (double)allocs / calls,
+                   (double)frees / calls, (double)(after.bytes_requested - before.bytes_requested) / calls,
+                   (unsigned long long)peak_growth, rss_after - rss_before, status);
+        }
+    }
+
+    if (json_path) {
+        fprintf(out, "  ],\n  \"peakRssKb\": %ld\n}\n", peak_rss_kb());
+        if (out != stdout) {
+            fclose(out);
+        }
+    } else {
+        printf("\nprocess peak RSS: %ld KB\n", peak_rss_kb());
+    }
+
+    cj_palette_index_destroy(context->palette_index);
+    cj_journey_inverse_destroy(context->inverse);
+    cj_journey_field_destroy(context->field);
+    cj_journey_destroy(context->created);
+    cj_journey_destroy(context->journey);
+    free(context);
+
+    if (check && failures > 0) {
+        fprintf(stderr, "%d case(s) exceeded their allocation budget\n", failures);
+        return 1;
+    }
+    return 0;
+}
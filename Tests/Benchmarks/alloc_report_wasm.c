@@ -0,0 +1,28 @@
+/**
+ * WASM engine cases for colorjourney_alloc_report.
+ *
+ * Separate translation unit because the engine's CJ_Config clashes with the
+ * core's.
+ */
+
+#include "color_journey_runner.h"
+
+#include <string.h>
+
+void alloc_report_wasm_palette(int count) {
+    CJ_Config config;
+    memset(&config, 0, sizeof(config));
+    config.lightness = 0.0;
+    config.chroma = 1.0;
+    config.contrast = 0.5;
+    config.seed = 42;
+    config.num_colors = count;
+    config.num_anchors = 2;
+    config.curve_dimensions = 8;
+    config.curve_strength = 1.0;
+    strcpy(config.curve_style, "linear");
+
+    oklab anchors[2] = {{0.62, 0.18, 0.10}, {0.55, -0.05, -0.16}};
+    CJ_ColorPoint* palette = generate_discrete_palette(&config, anchors);
+    wasm_free(palette);
+}
@@ -0,0 +1,423 @@
+/**
+ * ColorJourney Benchmark Harness - implementation
+ *
+ * See bench.h. Timing uses CLOCK_MONOTONIC rather than clock(): clock()
+ * measures process CPU time at coarse resolution, which hides scheduler
+ * stalls and cannot resolve sub-microsecond kernels.
+ */
+
+#if defined(__linux__)
+#define _GNU_SOURCE
+#include <sched.h>
+#else
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "bench.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/utsname.h>
+
+#define BENCH_MAX_SAMPLES 1000
+#define BENCH_MAX_ITERATIONS (1ULL << 40)
+
+static volatile float bench_sink;
+
+void bench_consume_rgb(CJ_RGB color) {
+    bench_sink = color.r + color.g + color.b;
+}
+
+void bench_consume_float(float value) {
+    bench_sink = value;
+}
+
+uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+void bench_options_init(BenchOptions* options) {
+    options->warmup_ms = 100.0;
+    options->min_batch_ms = 10.0;
+    options->samples = 30;
+    options->pin_cpu = -1;
+    options->filter = NULL;
+    options->json_path = NULL;
+    options->list_only = 0;
+    options->counters = 0;
+}
+
+static void bench_print_usage(const char* program) {
+    printf("Usage: %s [--filter <substr>] [--json <path|->] [--samples <n>]\n", program);
+    printf("       [--warmup-ms <ms>] [--min-batch-ms <ms>] [--pin <cpu>] [--counters] [--quick] [--list]\n");
+}
+
+int bench_parse_args(BenchOptions* options, int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            options->filter = argv[++i];
+        } else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            options->json_path = argv[++i];
+        } else if (strcmp(argv[i], "--samples") == 0 && i + 1 < argc) {
+            options->samples = (size_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--warmup-ms") == 0 && i + 1 < argc) {
+            options->warmup_ms = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--min-batch-ms") == 0 && i + 1 < argc) {
+            options->min_batch_ms = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--pin") == 0 && i + 1 < argc) {
+            options->pin_cpu = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--quick") == 0) {
+            /* Smoke-test settings: exercises every kernel in well under a second each. */
+            options->warmup_ms = 0.0;
+            options->min_batch_ms = 0.5;
+            options->samples = 3;
+        } else if (strcmp(argv[i], "--counters") == 0) {
+            options->counters = 1;
+        } else if (strcmp(argv[i], "--list") == 0) {
+            options->list_only = 1;
+        } else if (strcmp(argv[i], "--help") == 0) {
+            bench_print_usage(argv[0]);
+            return 1;
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            bench_print_usage(argv[0]);
+            return -1;
+        }
+    }
+    if (options->samples == 0) {
+        options->samples = 1;
+    }
+    if (options->samples > BENCH_MAX_SAMPLES) {
+        options->samples = BENCH_MAX_SAMPLES;
+    }
+    return 0;
+}
+
+static int compare_double(const void* a, const void* b) {
+    const double x = *(const double*)a;
+    const double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/* Linear interpolation between closest ranks; `sorted` must be ascending. */
+double bench_percentile(double* sorted, size_t count, double q) {
+    if (count == 0) {
+        return 0.0;
+    }
+    const double rank = q * (double)(count - 1);
+    const size_t lower = (size_t)rank;
+    const size_t upper = lower + 1 < count ? lower + 1 : lower;
+    const double fraction = rank - (double)lower;
+    return sorted[lower] + (sorted[upper] - sorted[lower]) * fraction;
+}
+
+double bench_median_abs_deviation(const double* values, size_t count, double median) {
+    if (count == 0) {
+        return 0.0;
+    }
+    double* deviations = (double*)malloc(count * sizeof(double));
+    if (!deviations) {
+        return 0.0;
+    }
+    for (size_t i = 0; i < count; i++) {
+        deviations[i] = fabs(values[i] - median);
+    }
+    qsort(deviations, count, sizeof(double), compare_double);
+    const double mad = bench_percentile(deviations, count, 0.5);
+    free(deviations);
+    return mad;
+}
+
+int bench_pin_cpu(int cpu) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set);
+#else
+    (void)cpu;
+    return -1;
+#endif
+}
+
+/*
+ * Counter pass: separate batches after timing so the ioctl/read syscalls never
+ * land inside a timed sample. Reports the median per item of each event.
+ */
+static int collect_counters(const BenchCase* bench_case, const BenchOptions* options, BenchResult* out) {
+    static int warned = 0;
+    BenchCounters counters;
+    if (bench_counters_open(&counters) == 0) {
+        if (!warned) {
+            fprintf(stderr, "Warning: hardware counters unavailable (perf_event_open refused or unsupported); "
+                            "reporting wall time only\n");
+            warned = 1;
+        }
+        bench_counters_close(&counters);
+        return 0;
+    }
+
+    double* per_event = (double*)malloc(options->samples * BENCH_COUNTER_COUNT * sizeof(double));
+    if (!per_event) {
+        bench_counters_close(&counters);
+        return -1;
+    }
+    const double per_batch_items = (double)out->iterations * out->items;
+    for (size_t s = 0; s < options->samples; s++) {
+        double values[BENCH_COUNTER_COUNT];
+        bench_counters_start(&counters);
+        bench_case->kernel(bench_case->context, out->iterations);
+        bench_counters_stop(&counters, values);
+        for (int e = 0; e < BENCH_COUNTER_COUNT; e++) {
+            per_event[e * options->samples + s] = values[e] / per_batch_items;
+        }
+    }
+    for (int e = 0; e < BENCH_COUNTER_COUNT; e++) {
+        double* column = per_event + e * options->samples;
+        if (counters.fds[e] < 0 || isnan(column[0])) {
+            out->counters[e] = NAN;
+            continue;
+        }
+        qsort(column, options->samples, sizeof(double), compare_double);
+        out->counters[e] = bench_percentile(column, options->samples, 0.5);
+    }
+    out->has_counters = 1;
+    free(per_event);
+    bench_counters_close(&counters);
+    return 0;
+}
+
+static uint64_t time_batch(const BenchCase* bench_case, uint64_t iterations) {
+    const uint64_t start = bench_now_ns();
+    bench_case->kernel(bench_case->context, iterations);
+    return bench_now_ns() - start;
+}
+
+int bench_run_case(const BenchCase* bench_case, const BenchOptions* options, BenchResult* out) {
+    return bench_run_case_samples(bench_case, options, out, NULL);
+}
+
+int bench_run_case_samples(const BenchCase* bench_case, const BenchOptions* options, BenchResult* out,
+                           double* samples_out) {
+    memset(out, 0, sizeof(*out));
+    out->name = bench_case->name;
+    out->group = bench_case->group;
+    out->items = bench_case->items > 0.0 ? bench_case->items : 1.0;
+
+    /* Warmup: run until the warmup budget is spent (caches, branch predictors, frequency). */
+    const uint64_t warmup_ns = (uint64_t)(options->warmup_ms * 1e6);
+    const uint64_t warmup_start = bench_now_ns();
+    while (bench_now_ns() - warmup_start < warmup_ns) {
+        bench_case->kernel(bench_case->context, 1);
+    }
+
+    /* Calibration: double iterations until one batch reaches the minimum batch time. */
+    const uint64_t min_batch_ns = (uint64_t)(options->min_batch_ms * 1e6);
+    uint64_t iterations = 1;
+    uint64_t elapsed = time_batch(bench_case, iterations);
+    while (elapsed < min_batch_ns && iterations < BENCH_MAX_ITERATIONS) {
+        uint64_t next = iterations * 2;
+        if (elapsed > 0) {
+            /* Jump close to the target, with 20% headroom, instead of doubling blindly. */
+            const double scaled = (double)iterations * (double)min_batch_ns * 1.2 / (double)elapsed;
+            if (scaled > (double)next) {
+                next = scaled < (double)BENCH_MAX_ITERATIONS ? (uint64_t)scaled : BENCH_MAX_ITERATIONS;
+            }
+        }
+        iterations = next;
+        elapsed = time_batch(bench_case, iterations);
+    }
+    out->iterations = iterations;
+
+    double* samples = (double*)malloc(options->samples * sizeof(double));
+    if (!samples) {
+        return -1;
+    }
+    double total = 0.0;
+    const double per_batch_items = (double)iterations * out->items;
+    for (size_t s = 0; s < options->samples; s++) {
+        samples[s] = (double)time_batch(bench_case, iterations) / per_batch_items;
+        total += samples[s];
+    }
+    if (samples_out) {
+        memcpy(samples_out, samples, options->samples * sizeof(double));
+    }
+    qsort(samples, options->samples, sizeof(double), compare_double);
+
+    out->sample_count = options->samples;
+    out->median_ns = bench_percentile(samples, options->samples, 0.5);
+    out->mad_ns = bench_median_abs_deviation(samples, options->samples, out->median_ns);
+    out->mean_ns = total / (double)options->samples;
+    out->min_ns = samples[0];
+    out->max_ns = samples[options->samples - 1];
+    out->p90_ns = bench_percentile(samples, options->samples, 0.90);
+    out->p99_ns = bench_percentile(samples, options->samples, 0.99);
+    out->items_per_second = out->median_ns > 0.0 ? 1e9 / out->median_ns : 0.0;
+    free(samples);
+
+    for (int e = 0; e < BENCH_COUNTER_COUNT; e++) {
+        out->counters[e] = NAN;
+    }
+    if (options->counters) {
+        return collect_counters(bench_case, options, out);
+    }
+    return 0;
+}
+
+static int matches_filter(const BenchCase* bench_case, const char* filter) {
+    return !filter || strstr(bench_case->name, filter) != NULL || strstr(bench_case->group, filter) != NULL;
+}
+
+static void print_json_string(FILE* out, const char* value) {
+    fputc('"', out);
+    for (const char* c = value; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            fputc('\\', out);
+        }
+        fputc(*c, out);
+    }
+    fputc('"', out);
+}
+
+static double result_ipc(const BenchResult* r) {
+    const double cycles = r->counters[BENCH_COUNTER_CYCLES];
+    const double instructions = r->counters[BENCH_COUNTER_INSTRUCTIONS];
+    return (cycles > 0.0 && !isnan(instructions)) ? instructions / cycles : NAN;
+}
+
+/* JSON has no NaN: unavailable counters are null. */
+static void print_json_number(FILE* out, double value) {
+    if (isnan(value)) {
+        fputs("null", out);
+    } else {
+        fprintf(out, "%.4f", value);
+    }
+}
+
+static void print_table_number(FILE* out, double value, int width, int precision) {
+    if (isnan(value)) {
+        fprintf(out, " %*s", width, "n/a");
+    } else {
+        fprintf(out, " %*.*f", width, precision, value);
+    }
+}
+
+static void write_json(FILE* out, const char* suite_name, const BenchOptions* options,
+                       const BenchResult* results, size_t result_count) {
+    struct utsname host;
+    const int have_host = uname(&host) == 0;
+
+    fprintf(out, "{\n  \"schema\": \"colorjourney-bench/1\",\n  \"suite\": ");
+    print_json_string(out, suite_name);
+    fprintf(out, ",\n  \"host\": {\"system\": ");
+    print_json_string(out, have_host ? host.sysname : "unknown");
+    fprintf(out, ", \"machine\": ");
+    print_json_string(out, have_host ? host.machine : "unknown");
+    fprintf(out, ", \"release\": ");
+    print_json_string(out, have_host ? host.release : "unknown");
+    fprintf(out, "},\n  \"options\": {\"warmupMs\": %.3f, \"minBatchMs\": %.3f, \"samples\": %zu, \"pinCpu\": %d, \"counters\": %s},\n",
+            options->warmup_ms, options->min_batch_ms, options->samples, options->pin_cpu,
+            options->counters ? "true" : "false");
+    fprintf(out, "  \"benchmarks\": [\n");
+    for (size_t i = 0; i < result_count; i++) {
+        const BenchResult* r = &results[i];
+        fprintf(out, "    {\"name\": ");
+        print_json_string(out, r->name);
+        fprintf(out, ", \"group\": ");
+        print_json_string(out, r->group);
+        fprintf(out, ", \"items\": %.0f, \"iterations\": %llu, \"samples\": %zu, "
+                     "\"medianNs\": %.4f, \"madNs\": %.4f, \"meanNs\": %.4f, \"minNs\": %.4f, \"maxNs\": %.4f, "
+                     "\"p90Ns\": %.4f, \"p99Ns\": %.4f, \"itemsPerSecond\": %.1f",
+                r->items, (unsigned long long)r->iterations, r->sample_count,
+                r->median_ns, r->mad_ns, r->mean_ns, r->min_ns, r->max_ns,
+                r->p90_ns, r->p99_ns, r->items_per_second);
+        if (r->has_counters) {
+            /* Per item, like the timings; ipc is instructions / cycles. */
+            fprintf(out, ", \"counters\": {");
+            for (int e = 0; e < BENCH_COUNTER_COUNT; e++) {
+                fprintf(out, "\"%s\": ", bench_counter_names[e]);
+                print_json_number(out, r->counters[e]);
+                fprintf(out, ", ");
+            }
+            fprintf(out, "\"ipc\": ");
+            print_json_number(out, result_ipc(r));
+            fprintf(out, "}");
+        }
+        fprintf(out, "}%s\n", i + 1 < result_count ? "," : "");
+    }
+    fprintf(out, "  ]\n}\n");
+}
+
+int bench_run_suite(const char* suite_name, const BenchCase* cases, size_t case_count, const BenchOptions* options) {
+    if (options->list_only) {
+        for (size_t i = 0; i < case_count; i++) {
+            if (matches_filter(&cases[i], options->filter)) {
+                printf("%-48s %s\n", cases[i].name, cases[i].group);
+            }
+        }
+        return 0;
+    }
+
+    if (options->pin_cpu >= 0 && bench_pin_cpu(options->pin_cpu) != 0) {
+        fprintf(stderr, "Warning: could not pin to CPU %d; continuing unpinned\n", options->pin_cpu);
+    }
+
+    BenchResult* results = (BenchResult*)calloc(case_count, sizeof(BenchResult));
+    if (!results) {
+        return 1;
+    }
+    const int table = options->json_path == NULL;
+    FILE* progress = table ? stdout : stderr;
+    if (table) {
+        printf("%-48s %12s %10s %12s %12s %14s", "benchmark", "median ns", "MAD ns", "p90 ns", "p99 ns", "items/s");
+        if (options->counters) {
+            printf(" %10s %6s %10s %10s %10s", "cyc/item", "IPC", "br-miss", "L1D-miss", "LLC-miss");
+        }
+        printf("\n");
+    }
+
+    size_t result_count = 0;
+    for (size_t i = 0; i < case_count; i++) {
+        if (!matches_filter(&cases[i], options->filter)) {
+            continue;
+        }
+        BenchResult* r = &results[result_count];
+        if (bench_run_case(&cases[i], options, r) != 0) {
+            fprintf(stderr, "Benchmark %s failed\n", cases[i].name);
+            free(results);
+            return 1;
+        }
+        result_count++;
+        fprintf(progress, "%-48s %12.2f %10.2f %12.2f %12.2f %14.0f",
+                r->name, r->median_ns, r->mad_ns, r->p90_ns, r->p99_ns, r->items_per_second);
+        if (r->has_counters) {
+            print_table_number(progress, r->counters[BENCH_COUNTER_CYCLES], 10, 1);
+            print_table_number(progress, result_ipc(r), 6, 2);
+            print_table_number(progress, r->counters[BENCH_COUNTER_BRANCH_MISSES], 10, 3);
+            print_table_number(progress, r->counters[BENCH_COUNTER_L1D_MISSES], 10, 3);
+            print_table_number(progress, r->counters[BENCH_COUNTER_LLC_MISSES], 10, 3);
+        }
+        fprintf(progress, "\n");
+    }
+
+    int status = 0;
+    if (!table) {
+        FILE* out = strcmp(options->json_path, "-") == 0 ? stdout : fopen(options->json_path, "w");
+        if (!out) {
+            fprintf(stderr, "Cannot write %s\n", options->json_path);
+            status = 1;
+        } else {
+            write_json(out, suite_name, options, results, result_count);
+            if (out != stdout) {
+                fclose(out);
+            }
+        }
+    }
+    free(results);
+    return status;
+}
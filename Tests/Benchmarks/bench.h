@@ -0,0 +1,131 @@
+/**
+ * ColorJourney Benchmark Harness
+ *
+ * Small C99 harness shared by the benchmark executables:
+ * - Monotonic nanosecond timer (CLOCK_MONOTONIC)
+ * - Warmup, then automatic calibration of iterations per sample so each
+ *   timed batch runs for at least --min-batch-ms
+ * - Median / MAD / percentile summary over --samples batches
+ * - Optional CPU pinning (--pin, Linux only)
+ * - Optional hardware counters (--counters, Linux perf_event_open): cycles,
+ *   instructions, branch misses, L1D and LLC misses per item
+ * - Text table or JSON output (--json <path|->)
+ *
+ * A benchmark is a kernel that runs `iterations` times per call; per-call
+ * results are normalized by the benchmark's `items` (e.g. colors per call),
+ * so palette benchmarks report ns per color.
+ */
+
+#ifndef COLORJOURNEY_BENCH_H
+#define COLORJOURNEY_BENCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ColorJourney.h"
+
+/** Kernel: run the benchmarked operation `iterations` times. */
+typedef void (*BenchKernel)(void* context, uint64_t iterations);
+
+typedef struct {
+    const char* name;        ///< Unique name, e.g. "journey_sample/anchors=3"
+    const char* group;       ///< Public function under test, e.g. "cj_journey_sample"
+    BenchKernel kernel;
+    void* context;
+    double items;            ///< Items produced per kernel iteration (1 for scalar ops)
+} BenchCase;
+
+typedef enum {
+    BENCH_COUNTER_CYCLES,
+    BENCH_COUNTER_INSTRUCTIONS,
+    BENCH_COUNTER_BRANCH_MISSES,
+    BENCH_COUNTER_L1D_MISSES,
+    BENCH_COUNTER_LLC_MISSES,
+    BENCH_COUNTER_COUNT
+} BenchCounterId;
+
+/** JSON keys, indexed by BenchCounterId. */
+extern const char* const bench_counter_names[BENCH_COUNTER_COUNT];
+
+typedef struct {
+    int fds[BENCH_COUNTER_COUNT];   ///< -1 when the event could not be opened
+    int available_count;
+} BenchCounters;
+
+typedef struct {
+    const char* name;
+    const char* group;
+    double items;
+    uint64_t iterations;     ///< Calibrated iterations per sample batch
+    size_t sample_count;
+    double median_ns;        ///< Per item
+    double mad_ns;           ///< Median absolute deviation, per item
+    double mean_ns;
+    double min_ns;
+    double max_ns;
+    double p90_ns;
+    double p99_ns;
+    double items_per_second;
+    int has_counters;        ///< Set when --counters ran and at least one event opened
+    double counters[BENCH_COUNTER_COUNT]; ///< Median per item; NaN if the event is unavailable
+} BenchResult;
+
+typedef struct {
+    double warmup_ms;
+    double min_batch_ms;
+    size_t samples;
+    int pin_cpu;             ///< -1 disables pinning
+    const char* filter;      ///< Substring match on name; NULL runs everything
+    const char* json_path;   ///< NULL prints a table; "-" writes JSON to stdout
+    int list_only;
+    int counters;            ///< Collect hardware counters in extra batches after timing
+} BenchOptions;
+
+/** Defaults: 100 ms warmup, 10 ms batches, 30 samples, no pinning. */
+void bench_options_init(BenchOptions* options);
+
+/**
+ * Parse common harness flags. Returns 0 on success, 1 if --help was shown,
+ * -1 on an unknown flag.
+ */
+int bench_parse_args(BenchOptions* options, int argc, char** argv);
+
+uint64_t bench_now_ns(void);
+
+/** Pin the calling thread to `cpu` (Linux only); returns 0 on success. */
+int bench_pin_cpu(int cpu);
+
+/** Keep results observable so kernels are not optimized away. */
+void bench_consume_rgb(CJ_RGB color);
+void bench_consume_float(float value);
+
+/** Run one case; returns 0 on success. */
+int bench_run_case(const BenchCase* bench_case, const BenchOptions* options, BenchResult* out);
+
+/**
+ * As bench_run_case(), also copying the per-item sample times in run order
+ * into `samples_out` (options->samples entries; NULL to skip).
+ */
+int bench_run_case_samples(const BenchCase* bench_case, const BenchOptions* options, BenchResult* out,
+                           double* samples_out);
+
+/**
+ * Run every case matching options->filter and report. Returns the process
+ * exit code (0 on success).
+ */
+int bench_run_suite(const char* suite_name, const BenchCase* cases, size_t case_count, const BenchOptions* options);
+
+/**
+ * Hardware counters. bench_counters_open() returns the number of events that
+ * opened (0 when unsupported or not permitted); the rest read back as NaN.
+ */
+int bench_counters_open(BenchCounters* counters);
+void bench_counters_close(BenchCounters* counters);
+void bench_counters_start(BenchCounters* counters);
+void bench_counters_stop(BenchCounters* counters, double values[BENCH_COUNTER_COUNT]);
+
+/** Summary helpers (exposed for tests and the regression gate). */
+double bench_percentile(double* sorted, size_t count, double q);
+double bench_median_abs_deviation(const double* values, size_t count, double median);
+
+#endif /* COLORJOURNEY_BENCH_H */
@@ -0,0 +1,380 @@
+/**
+ * colorjourney_bench_coldstart - cold-start and creation-cost benchmarks
+ *
+ * Cold costs only exist once per process, so the parent re-executes itself
+ * (--runs times per probe, default 20) and each child measures one fresh
+ * process, printing "<probe> <ns> <minor faults>" lines back over a pipe:
+ *
+ * - process: exec to main(), i.e. kernel exec plus dynamic loading of this
+ *   binary (the parent's spawn timestamp is passed to the child).
+ * - first-call probes: the first and then the second call of
+ *   cj_rgb_to_oklab (libm lazy binding), cj_journey_create,
+ *   cj_journey_sample, cj_journey_discrete and cj_journey_discrete_at in
+ *   one process. first - second is the cold penalty: page faults on code
+ *   and data, lazy PLT binding, and any one-time table construction.
+ * - create/anchors=k, k = 1..8: the very first cj_journey_create in a fresh
+ *   process per anchor count. anchors=1 takes build_waypoints' 8-waypoint
+ *   hue wheel; the others take the anchor path. The warm median over 1000
+ *   creates in the same process is printed next to it.
+ * - load (with --library <path to a shared ColorJourney build>): dlopen
+ *   plus dlsym, then the first create and sample through the loaded
+ *   library.
+ *
+ * Usage: colorjourney_bench_coldstart [--runs <n>] [--library <path>] [--json <path|->]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench.h"
+
+#include <dlfcn.h>
+#include <spawn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define COLD_MAX_PROBES 32
+#define COLD_MAX_RUNS 200
+#define COLD_NAME_MAX 48
+#define COLD_WARM_CREATES 1000
+
+extern char** environ;
+
+/* ---- Child side -------------------------------------------------------- */
+
+static long minor_faults(void) {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_minflt;
+}
+
+static void report(const char* probe, uint64_t ns, long faults) {
+    printf("%s %llu %ld\n", probe, (unsigned long long)ns, faults);
+}
+
+static int compare_double(const void* a, const void* b) {
+    const double x = *(const double*)a;
+    const double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static void init_config(CJ_Config* config, int anchor_count) {
+    static const CJ_RGB anchors[8] = {
+        {0.85f, 0.35f, 0.25f}, {0.25f, 0.65f, 0.45f}, {0.30f, 0.35f, 0.85f}, {0.90f, 0.80f, 0.20f},
+        {0.55f, 0.20f, 0.60f}, {0.20f, 0.70f, 0.80f}, {0.95f, 0.55f, 0.70f}, {0.40f, 0.45f, 0.15f},
+    };
+    cj_config_init(config);
+    config->anchor_count = anchor_count;
+    for (int i = 0; i < anchor_count; i++) {
+        config->anchors[i] = anchors[i];
+    }
+}
+
+/* Time `statement` as probe "<name>/first" then "<name>/second". */
+#define COLD_TWICE(name, statement) do { \
+        for (int pass = 0; pass < 2; pass++) { \
+            const long faults_before = minor_faults(); \
+            const uint64_t t0 = bench_now_ns(); \
+            statement; \
+            const uint64_t t1 = bench_now_ns(); \
+            report(pass == 0 ? name "/first" : name "/second", t1 - t0, minor_faults() - faults_before); \
+        } \
+    } while (0)
+
+static int child_first_calls(void) {
+    CJ_Config config;
+    init_config(&config, 3);
+    CJ_Journey journey = NULL;
+    CJ_RGB palette[16];
+
+    COLD_TWICE("rgb_to_oklab", bench_consume_float(cj_rgb_to_oklab(config.anchors[0]).L));
+    COLD_TWICE("journey_create", {
+        cj_journey_destroy(journey);
+        journey = cj_journey_create(&config);
+    });
+    COLD_TWICE("journey_sample", bench_consume_rgb(cj_journey_sample(journey, 0.37f)));
+    COLD_TWICE("journey_discrete/n=16", {
+        cj_journey_discrete(journey, 16, palette);
+        bench_consume_rgb(palette[15]);
+    });
+    COLD_TWICE("journey_discrete_at/index=16", bench_consume_rgb(cj_journey_discrete_at(journey, 16)));
+    cj_journey_destroy(journey);
+    return 0;
+}
+
+static int child_create(int anchor_count) {
+    CJ_Config config;
+    init_config(&config, anchor_count);
+    char name[COLD_NAME_MAX];
+
+    const long faults_before = minor_faults();
+    const uint64_t t0 = bench_now_ns();
+    CJ_Journey journey = cj_journey_create(&config);
+    const uint64_t t1 = bench_now_ns();
+    snprintf(name, sizeof(name), "create/anchors=%d/cold", anchor_count);
+    report(name, t1 - t0, minor_faults() - faults_before);
+    cj_journey_destroy(journey);
+
+    double warm[COLD_WARM_CREATES];
+    for (int i = 0; i < COLD_WARM_CREATES; i++) {
+        const uint64_t start = bench_now_ns();
+        journey = cj_journey_create(&config);
+        warm[i] = (double)(bench_now_ns() - start);
+        cj_journey_destroy(journey);
+    }
+    snprintf(name, sizeof(name), "create/anchors=%d/warm", anchor_count);
+    qsort(warm, COLD_WARM_CREATES, sizeof(double), compare_double);
+    report(name, (uint64_t)bench_percentile(warm, COLD_WARM_CREATES, 0.5), 0);
+    return 0;
+}
+
+typedef CJ_Journey (*CreateFn)(const CJ_Config*);
+typedef void (*DestroyFn)(CJ_Journey);
+typedef CJ_RGB (*SampleFn)(CJ_Journey, float);
+typedef void (*ConfigInitFn)(CJ_Config*);
+
+static int child_load(const char* library) {
+    const long faults_before = minor_faults();
+    const uint64_t t0 = bench_now_ns();
+    void* handle = dlopen(library, RTLD_NOW | RTLD_LOCAL);
+    if (!handle) {
+        fprintf(stderr, "dlopen failed: %s\n", dlerror());
+        return 1;
+    }
+    const uint64_t t1 = bench_now_ns();
+    report("load/dlopen", t1 - t0, minor_faults() - faults_before);
+
+    /* Function pointers via memcpy: ISO C forbids casting void* to a function pointer. */
+    void* symbols[4] = {
+        dlsym(handle, "cj_config_init"), dlsym(handle, "cj_journey_create"),
+        dlsym(handle, "cj_journey_sample"), dlsym(handle, "cj_journey_destroy"),
+    };
+    const uint64_t t2 = bench_now_ns();
+    report("load/dlsym", t2 - t1, 0);
+    if (!symbols[0] || !symbols[1] || !symbols[2] || !symbols[3]) {
+        fprintf(stderr, "missing symbols in %s\n", library);
+        dlclose(handle);
+        return 1;
+    }
+    ConfigInitFn config_init;
+    CreateFn create;
+    SampleFn sample;
+    DestroyFn destroy;
+    memcpy(&config_init, &symbols[0], sizeof(config_init));
+    memcpy(&create, &symbols[1], sizeof(create));
+    memcpy(&sample, &symbols[2], sizeof(sample));
+    memcpy(&destroy, &symbols[3], sizeof(destroy));
+
+    CJ_Config config;
+    const long faults_mid = minor_faults();
+    const uint64_t t3 = bench_now_ns();
+    config_init(&config);
+    CJ_Journey journey = create(&config);
+    bench_consume_rgb(sample(journey, 0.5f));
+    const uint64_t t4 = bench_now_ns();
+    report("load/first_create_sample", t4 - t3, minor_faults() - faults_mid);
+    destroy(journey);
+    dlclose(handle);
+    return 0;
+}
+
+/* ---- Parent side ------------------------------------------------------- */
+
+typedef struct {
+    char name[COLD_NAME_MAX];
+    size_t count;
+    double ns[COLD_MAX_RUNS];
+    double faults[COLD_MAX_RUNS];
+} ProbeSamples;
+
+static ProbeSamples probes[COLD_MAX_PROBES];
+static size_t probe_count = 0;
+
+static ProbeSamples* probe_for(const char* name) {
+    for (size_t i = 0; i < probe_count; i++) {
+        if (strcmp(probes[i].name, name) == 0) {
+            return &probes[i];
+        }
+    }
+    if (probe_count == COLD_MAX_PROBES) {
+        return NULL;
+    }
+    ProbeSamples* probe = &probes[probe_count++];
+    snprintf(probe->name, sizeof(probe->name), "%s", name);
+    probe->count = 0;
+    return probe;
+}
+
+static void record(const char* name, double ns, double faults) {
+    ProbeSamples* probe = probe_for(name);
+    if (probe && probe->count < COLD_MAX_RUNS) {
+        probe->ns[probe->count] = ns;
+        probe->faults[probe->count] = faults;
+        probe->count++;
+    }
+}
+
+/* Spawn `self` with `child_args` and record every probe line it prints. */
+static int run_child(const char* self, char* const child_args[]) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return -1;
+    }
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+    posix_spawn_file_actions_addclose(&actions, fds[0]);
+
+    char* argv[8];
+    char spawn_stamp[32];
+    size_t argc = 0;
+    argv[argc++] = (char*)self;
+    argv[argc++] = (char*)"--spawned-at";
+    argv[argc++] = spawn_stamp;
+    for (size_t i = 0; child_args[i] && argc < 7; i++) {
+        argv[argc++] = child_args[i];
+    }
+    argv[argc] = NULL;
+
+    pid_t pid;
+    snprintf(spawn_stamp, sizeof(spawn_stamp), "%llu", (unsigned long long)bench_now_ns());
+    const int spawn_status = posix_spawn(&pid, self, &actions, NULL, argv, environ);
+    posix_spawn_file_actions_destroy(&actions);
+    close(fds[1]);
+    if (spawn_status != 0) {
+        close(fds[0]);
+        return -1;
+    }
+
+    FILE* in = fdopen(fds[0], "r");
+    char name[COLD_NAME_MAX];
+    unsigned long long ns;
+    long faults;
+    while (in && fscanf(in, "%47s %llu %ld", name, &ns, &faults) == 3) {
+        record(name, (double)ns, (double)faults);
+    }
+    if (in) {
+        fclose(in);
+    } else {
+        close(fds[0]);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0 ? 0 : -1;
+}
+
+static void summarize(ProbeSamples* probe, double* median, double* p90, double* max, double* faults) {
+    double sorted[COLD_MAX_RUNS];
+    memcpy(sorted, probe->ns, probe->count * sizeof(double));
+    qsort(sorted, probe->count, sizeof(double), compare_double);
+    *median = bench_percentile(sorted, probe->count, 0.5);
+    *p90 = bench_percentile(sorted, probe->count, 0.9);
+    *max = sorted[probe->count - 1];
+    memcpy(sorted, probe->faults, probe->count * sizeof(double));
+    qsort(sorted, probe->count, sizeof(double), compare_double);
+    *faults = bench_percentile(sorted, probe->count, 0.5);
+}
+
+static void print_usage(const char* program) {
+    printf("Usage: %s [--runs <n>] [--library <path>] [--json <path|->]\n", program);
+}
+
+int main(int argc, char** argv) {
+    /* Child mode: --spawned-at <ns> <probe> [arg] */
+    if (argc >= 4 && strcmp(argv[1], "--spawned-at") == 0) {
+        const uint64_t now = bench_now_ns();
+        report("process/exec_to_main", now - strtoull(argv[2], NULL, 10), minor_faults());
+        int status = 2;
+        if (strcmp(argv[3], "first-calls") == 0) {
+            status = child_first_calls();
+        } else if (strcmp(argv[3], "create") == 0 && argc >= 5) {
+            status = child_create(atoi(argv[4]));
+        } else if (strcmp(argv[3], "load") == 0 && argc >= 5) {
+            status = child_load(argv[4]);
+        }
+        fflush(stdout);
+        return status;
+    }
+
+    int runs = 20;
+    const char* library = NULL;
+    const char* json_path = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--runs") == 0 && i + 1 < argc) {
+            runs = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--library") == 0 && i + 1 < argc) {
+            library = argv[++i];
+        } else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (strcmp(argv[i], "--help") == 0) {
+            print_usage(argv[0]);
+            return 0;
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+    if (runs < 1 || runs > COLD_MAX_RUNS) {
+        fprintf(stderr, "--runs must be between 1 and %d\n", COLD_MAX_RUNS);
+        return 2;
+    }
+
+    /* Interleave probe kinds within each run so drift affects all equally. */
+    for (int run = 0; run < runs; run++) {
+        char* first_calls[] = {(char*)"first-calls", NULL};
+        if (run_child(argv[0], first_calls) != 0) {
+            fprintf(stderr, "first-calls child failed\n");
+            return 1;
+        }
+        for (int anchors = 1; anchors <= 8; anchors++) {
+            char count[4];
+            snprintf(count, sizeof(count), "%d", anchors);
+            char* create_args[] = {(char*)"create", count, NULL};
+            if (run_child(argv[0], create_args) != 0) {
+                fprintf(stderr, "create child failed\n");
+                return 1;
+            }
+        }
+        if (library) {
+            char* load_args[] = {(char*)"load", (char*)library, NULL};
+            if (run_child(argv[0], load_args) != 0) {
+                fprintf(stderr, "load child failed for %s\n", library);
+                return 1;
+            }
+        }
+    }
+
+    FILE* out = stdout;
+    if (json_path) {
+        out = strcmp(json_path, "-") == 0 ? stdout : fopen(json_path, "w");
+        if (!out) {
+            fprintf(stderr, "Cannot write %s\n", json_path);
+            return 1;
+        }
+        fprintf(out, "{\n  \"schema\": \"colorjourney-coldstart/1\",\n  \"runs\": %d,\n  \"probes\": [\n", runs);
+    } else {
+        printf("%-36s %12s %12s %12s %10s\n", "probe", "median ns", "p90 ns", "max ns", "minflt");
+    }
+    for (size_t i = 0; i < probe_count; i++) {
+        double median, p90, max, faults;
+        summarize(&probes[i], &median, &p90, &max, &faults);
+        if (json_path) {
+            fprintf(out, "    {\"name\": \"%s\", \"runs\": %zu, \"medianNs\": %.0f, \"p90Ns\": %.0f, \"maxNs\": %.0f, "
+                         "\"minorFaults\": %.0f}%s\n",
+                    probes[i].name, probes[i].count, median, p90, max, faults, i + 1 < probe_count ? "," : "");
+        } else {
+            printf("%-36s %12.0f %12.0f %12.0f %10.0f\n", probes[i].name, median, p90, max, faults);
+        }
+    }
+    if (json_path) {
+        fprintf(out, "  ]\n}\n");
+        if (out != stdout) {
+            fclose(out);
+        }
+    }
+    return 0;
+}
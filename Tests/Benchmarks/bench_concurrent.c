@@ -0,0 +1,483 @@
+/**
+ * colorjourney_bench_concurrent - latency histograms under concurrent load
+ *
+ * N threads (--threads, default 32) call one operation against either one
+ * shared journey or a journey per thread, recording every call into an
+ * HDR-style log-linear histogram (about 1% value precision, 1 ns to 2^40 ns).
+ * Histograms are per thread and merged afterwards, so recording adds no
+ * shared writes of its own.
+ *
+ * Each scenario runs in two phases:
+ * 1. Closed loop: every thread calls back to back for a short burst to find
+ *    the saturated throughput.
+ * 2. Open loop at --load (default 80%) of that throughput: each thread
+ *    follows a fixed schedule of intended start times. Service time is
+ *    measured from the actual start; response time is measured from the
+ *    intended start, which corrects for coordinated omission (a stalled
+ *    call delays the calls queued behind it, and those delays are counted
+ *    instead of silently skipped). The achieved rate is reported against
+ *    the target rate.
+ *
+ * Scenarios: sample and discrete_at, each with shared and per-thread
+ * journeys, and create_destroy (allocator contention). Comparing shared vs
+ * per-thread tails exposes false sharing on the journey; create_destroy
+ * tails expose allocator locks.
+ *
+ * Usage: colorjourney_bench_concurrent [--threads <n>] [--duration-ms <ms>]
+ *        [--load <fraction>] [--index <i>] [--scenario <substr>] [--json <path|->] [--quick]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define HIST_SUB_BITS 7
+#define HIST_SUB_COUNT (1 << HIST_SUB_BITS)
+#define HIST_HALF_COUNT (HIST_SUB_COUNT / 2)
+#define HIST_MAX_SHIFT 34
+#define HIST_BUCKETS (HIST_SUB_COUNT + HIST_MAX_SHIFT * HIST_HALF_COUNT)
+#define CACHE_LINE 64
+
+/* ---- HDR-style histogram ---------------------------------------------- */
+
+typedef struct {
+    uint64_t counts[HIST_BUCKETS];
+    uint64_t total;
+    uint64_t min;
+    uint64_t max;
+} Histogram;
+
+static void hist_init(Histogram* h) {
+    memset(h, 0, sizeof(*h));
+    h->min = UINT64_MAX;
+}
+
+/*
+ * Values below 128 get exact buckets. Above that, each power of two is
+ * split into 64 linear sub-buckets, bounding the relative error by 1/64.
+ */
+static size_t hist_index(uint64_t value) {
+    if (value < HIST_SUB_COUNT) {
+        return (size_t)value;
+    }
+    int shift = 0;
+    while ((value >> shift) >= HIST_SUB_COUNT) {
+        shift++;
+    }
+    if (shift > HIST_MAX_SHIFT) {
+        return HIST_BUCKETS - 1;
+    }
+    return HIST_SUB_COUNT + (size_t)(shift - 1) * HIST_HALF_COUNT + (size_t)((value >> shift) - HIST_HALF_COUNT);
+}
+
+/* Largest value that maps to `index`, so percentiles never under-report. */
+static uint64_t hist_upper_value(size_t index) {
+    if (index < HIST_SUB_COUNT) {
+        return (uint64_t)index;
+    }
+    const size_t shift = (index - HIST_SUB_COUNT) / HIST_HALF_COUNT + 1;
+    const uint64_t sub = (uint64_t)((index - HIST_SUB_COUNT) % HIST_HALF_COUNT) + HIST_HALF_COUNT;
+    return ((sub + 1) << shift) - 1;
+}
+
+static void hist_record(Histogram* h, uint64_t value) {
+    h->counts[hist_index(value)]++;
+    h->total++;
+    if (value < h->min) {
+        h->min = value;
+    }
+    if (value > h->max) {
+        h->max = value;
+    }
+}
+
+static void hist_merge(Histogram* into, const Histogram* from) {
+    for (size_t i = 0; i < HIST_BUCKETS; i++) {
+        into->counts[i] += from->counts[i];
+    }
+    into->total += from->total;
+    if (from->min < into->min) {
+        into->min = from->min;
+    }
+    if (from->max > into->max) {
+        into->max = from->max;
+    }
+}
+
+static double hist_percentile(const Histogram* h, double q) {
+    if (h->total == 0) {
+        return 0.0;
+    }
+    const uint64_t rank = (uint64_t)(q * (double)h->total + 0.5);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < HIST_BUCKETS; i++) {
+        seen += h->counts[i];
+        if (seen >= rank && seen > 0) {
+            const uint64_t upper = hist_upper_value(i);
+            return (double)(upper < h->max ? upper : h->max);
+        }
+    }
+    return (double)h->max;
+}
+
+/* ---- Scenarios --------------------------------------------------------- */
+
+typedef enum { OP_SAMPLE, OP_DISCRETE_AT, OP_CREATE_DESTROY } Operation;
+
+typedef struct {
+    const char* name;
+    Operation op;
+    int shared;
+} Scenario;
+
+static const Scenario scenarios[] = {
+    {"sample/shared", OP_SAMPLE, 1},
+    {"sample/per-thread", OP_SAMPLE, 0},
+    {"discrete_at/shared", OP_DISCRETE_AT, 1},
+    {"discrete_at/per-thread", OP_DISCRETE_AT, 0},
+    {"create_destroy", OP_CREATE_DESTROY, 0},
+};
+
+typedef struct {
+    int threads;
+    double duration_ms;
+    double saturate_ms;
+    double load;
+    int index;
+    const char* filter;
+    const char* json_path;
+} ConcurrentOptions;
+
+/* Written by the owning thread only; run_phase() places each on its own cache lines. */
+typedef struct {
+    Histogram service;
+    Histogram response;
+    uint64_t operations;
+    float sink;
+    CJ_Journey journey;
+    const CJ_Config* config;
+    const Scenario* scenario;
+    const ConcurrentOptions* options;
+    uint64_t interval_ns;         ///< 0 runs closed loop
+    uint64_t start_ns;
+    uint64_t end_ns;
+    unsigned seed;
+} ThreadState;
+
+typedef struct {
+    const char* name;
+    int threads;
+    double saturated_rate;
+    double target_rate;
+    double achieved_rate;
+    Histogram service;
+    Histogram response;
+} ScenarioResult;
+
+static pthread_mutex_t start_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t start_cond = PTHREAD_COND_INITIALIZER;
+static int start_generation = 0;
+
+static void run_operation(ThreadState* state, float t) {
+    switch (state->scenario->op) {
+    case OP_SAMPLE: {
+        const CJ_RGB c = cj_journey_sample(state->journey, t);
+        state->sink += c.r;
+        break;
+    }
+    case OP_DISCRETE_AT: {
+        const CJ_RGB c = cj_journey_discrete_at(state->journey, state->options->index);
+        state->sink += c.g;
+        break;
+    }
+    case OP_CREATE_DESTROY: {
+        CJ_Journey journey = cj_journey_create(state->config);
+        state->sink += journey ? 1.0f : 0.0f;
+        cj_journey_destroy(journey);
+        break;
+    }
+    }
+}
+
+/* Sleep most of the way to `deadline`, then yield-spin the rest. */
+static void wait_until(uint64_t deadline) {
+    uint64_t now = bench_now_ns();
+    if (deadline > now + 200000) {
+        const uint64_t sleep_ns = deadline - now - 100000;
+        struct timespec ts = {(time_t)(sleep_ns / 1000000000ULL), (long)(sleep_ns % 1000000000ULL)};
+        nanosleep(&ts, NULL);
+    }
+    while (bench_now_ns() < deadline) {
+        sched_yield();
+    }
+}
+
+static void* thread_main(void* arg) {
+    ThreadState* state = (ThreadState*)arg;
+
+    pthread_mutex_lock(&start_lock);
+    while (start_generation == 0) {
+        pthread_cond_wait(&start_cond, &start_lock);
+    }
+    pthread_mutex_unlock(&start_lock);
+
+    const uint64_t start = state->start_ns;
+    const uint64_t end = state->end_ns;
+    uint64_t intended = start;
+    for (;;) {
+        if (state->interval_ns > 0) {
+            intended += state->interval_ns;
+            if (intended >= end) {
+                break;
+            }
+            wait_until(intended);
+        }
+        const uint64_t op_start = bench_now_ns();
+        if (state->interval_ns == 0 && op_start >= end) {
+            break;
+        }
+        state->seed = state->seed * 1103515245u + 12345u;
+        run_operation(state, (float)(state->seed >> 8) / 16777216.0f);
+        const uint64_t op_end = bench_now_ns();
+        hist_record(&state->service, op_end - op_start);
+        hist_record(&state->response, op_end - (state->interval_ns > 0 ? intended : op_start));
+        state->operations++;
+    }
+    return NULL;
+}
+
+/*
+ * Run one phase with all threads; interval_ns 0 is closed loop. Returns the
+ * total completed operations, or -1 if threads could not be started.
+ */
+static long long run_phase(const Scenario* scenario, const ConcurrentOptions* options, const CJ_Config* config,
+                           CJ_Journey shared, double phase_ms, uint64_t interval_ns, ScenarioResult* result) {
+    pthread_t* threads = (pthread_t*)calloc((size_t)options->threads, sizeof(pthread_t));
+    /* One aligned block per thread so no two threads write the same cache line. */
+    const size_t stride = (sizeof(ThreadState) + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+    unsigned char* block = (unsigned char*)malloc(stride * (size_t)options->threads + CACHE_LINE);
+    if (!threads || !block) {
+        free(threads);
+        free(block);
+        return -1;
+    }
+    unsigned char* aligned = block + (CACHE_LINE - ((uintptr_t)block % CACHE_LINE)) % CACHE_LINE;
+
+    pthread_mutex_lock(&start_lock);
+    start_generation = 0;
+    pthread_mutex_unlock(&start_lock);
+
+    int started = 0;
+    for (int i = 0; i < options->threads; i++) {
+        ThreadState* state = (ThreadState*)(aligned + stride * (size_t)i);
+        memset(state, 0, sizeof(*state));
+        hist_init(&state->service);
+        hist_init(&state->response);
+        state->config = config;
+        state->scenario = scenario;
+        state->options = options;
+        state->interval_ns = interval_ns;
+        state->seed = 0x9e3779b9u * (unsigned)(i + 1);
+        state->journey = shared;
+        if (!scenario->shared && scenario->op != OP_CREATE_DESTROY) {
+            state->journey = cj_journey_create(config);
+        }
+        if (pthread_create(&threads[i], NULL, thread_main, state) != 0) {
+            break;
+        }
+        started++;
+    }
+
+    /* Stagger open-loop schedules so threads do not fire in lockstep. */
+    const uint64_t start = bench_now_ns() + 1000000;
+    for (int i = 0; i < started; i++) {
+        ThreadState* state = (ThreadState*)(aligned + stride * (size_t)i);
+        state->start_ns = start + (interval_ns > 0 ? interval_ns * (uint64_t)i / (uint64_t)started : 0);
+        state->end_ns = start + (uint64_t)(phase_ms * 1e6);
+    }
+    pthread_mutex_lock(&start_lock);
+    start_generation = 1;
+    pthread_cond_broadcast(&start_cond);
+    pthread_mutex_unlock(&start_lock);
+
+    long long total = 0;
+    float sink = 0.0f;
+    for (int i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+        ThreadState* state = (ThreadState*)(aligned + stride * (size_t)i);
+        total += (long long)state->operations;
+        sink += state->sink;
+        if (result) {
+            hist_merge(&result->service, &state->service);
+            hist_merge(&result->response, &state->response);
+        }
+        if (state->journey != shared) {
+            cj_journey_destroy(state->journey);
+        }
+    }
+    bench_consume_float(sink);
+    free(threads);
+    free(block);
+    return started == options->threads ? total : -1;
+}
+
+static int run_scenario(const Scenario* scenario, const ConcurrentOptions* options, const CJ_Config* config,
+                        ScenarioResult* result) {
+    memset(result, 0, sizeof(*result));
+    hist_init(&result->service);
+    hist_init(&result->response);
+    result->name = scenario->name;
+    result->threads = options->threads;
+
+    CJ_Journey shared = scenario->shared ? cj_journey_create(config) : NULL;
+
+    const long long saturated = run_phase(scenario, options, config, shared, options->saturate_ms, 0, NULL);
+    if (saturated <= 0) {
+        cj_journey_destroy(shared);
+        return -1;
+    }
+    result->saturated_rate = (double)saturated / (options->saturate_ms / 1000.0);
+    result->target_rate = result->saturated_rate * options->load;
+
+    /* Per-thread interval so all threads together issue target_rate calls/s. */
+    uint64_t interval_ns = (uint64_t)(1e9 * (double)options->threads / result->target_rate);
+    if (interval_ns == 0) {
+        interval_ns = 1;
+    }
+    const long long completed = run_phase(scenario, options, config, shared, options->duration_ms, interval_ns, result);
+    cj_journey_destroy(shared);
+    if (completed < 0) {
+        return -1;
+    }
+    result->achieved_rate = (double)completed / (options->duration_ms / 1000.0);
+    return 0;
+}
+
+static void print_result(FILE* out, const ScenarioResult* r) {
+    fprintf(out, "%-24s %7d %12.0f %12.0f %12.0f   %9.0f %9.0f %9.0f   %9.0f %9.0f %9.0f %11.0f\n",
+            r->name, r->threads, r->saturated_rate, r->target_rate, r->achieved_rate,
+            hist_percentile(&r->service, 0.50), hist_percentile(&r->service, 0.99), hist_percentile(&r->service, 0.999),
+            hist_percentile(&r->response, 0.50), hist_percentile(&r->response, 0.99), hist_percentile(&r->response, 0.999),
+            (double)r->response.max);
+}
+
+static void write_histogram_json(FILE* out, const char* key, const Histogram* h) {
+    fprintf(out, "\"%s\": {\"count\": %llu, \"minNs\": %llu, \"p50Ns\": %.0f, \"p90Ns\": %.0f, \"p99Ns\": %.0f, "
+                 "\"p999Ns\": %.0f, \"maxNs\": %llu}",
+            key, (unsigned long long)h->total, (unsigned long long)(h->total ? h->min : 0),
+            hist_percentile(h, 0.50), hist_percentile(h, 0.90), hist_percentile(h, 0.99), hist_percentile(h, 0.999),
+            (unsigned long long)h->max);
+}
+
+static void write_json(FILE* out, const ConcurrentOptions* options, const ScenarioResult* results, size_t count) {
+    fprintf(out, "{\n  \"schema\": \"colorjourney-concurrent/1\",\n  \"threads\": %d,\n  \"durationMs\": %.0f,\n"
+                 "  \"load\": %.2f,\n  \"discreteAtIndex\": %d,\n  \"scenarios\": [\n",
+            options->threads, options->duration_ms, options->load, options->index);
+    for (size_t i = 0; i < count; i++) {
+        const ScenarioResult* r = &results[i];
+        fprintf(out, "    {\"name\": \"%s\", \"saturatedRate\": %.1f, \"targetRate\": %.1f, \"achievedRate\": %.1f, ",
+                r->name, r->saturated_rate, r->target_rate, r->achieved_rate);
+        write_histogram_json(out, "service", &r->service);
+        fprintf(out, ", ");
+        write_histogram_json(out, "response", &r->response);
+        fprintf(out, "}%s\n", i + 1 < count ? "," : "");
+    }
+    fprintf(out, "  ]\n}\n");
+}
+
+static void print_usage(const char* program) {
+    printf("Usage: %s [--threads <n>] [--duration-ms <ms>] [--load <fraction>] [--index <i>]\n", program);
+    printf("       [--scenario <substr>] [--json <path|->] [--quick]\n");
+}
+
+int main(int argc, char** argv) {
+    ConcurrentOptions options = {32, 2000.0, 300.0, 0.8, 32, NULL, NULL};
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            options.threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--duration-ms") == 0 && i + 1 < argc) {
+            options.duration_ms = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--load") == 0 && i + 1 < argc) {
+            options.load = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--index") == 0 && i + 1 < argc) {
+            options.index = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--scenario") == 0 && i + 1 < argc) {
+            options.filter = argv[++i];
+        } else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            options.json_path = argv[++i];
+        } else if (strcmp(argv[i], "--quick") == 0) {
+            options.threads = 4;
+            options.duration_ms = 100.0;
+            options.saturate_ms = 50.0;
+        } else if (strcmp(argv[i], "--help") == 0) {
+            print_usage(argv[0]);
+            return 0;
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+    if (options.threads < 1 || options.duration_ms <= 0.0 || options.load <= 0.0 || options.index < 0) {
+        fprintf(stderr, "--threads, --duration-ms, --load must be positive and --index non-negative\n");
+        return 2;
+    }
+
+    CJ_Config config;
+    cj_config_init(&config);
+    config.anchor_count = 3;
+    config.anchors[0] = (CJ_RGB){0.85f, 0.35f, 0.25f};
+    config.anchors[1] = (CJ_RGB){0.25f, 0.65f, 0.45f};
+    config.anchors[2] = (CJ_RGB){0.30f, 0.35f, 0.85f};
+    config.contrast_level = CJ_CONTRAST_MEDIUM;
+    config.variation_enabled = true;
+    config.variation_dimensions = CJ_VARIATION_HUE;
+
+    const size_t scenario_count = sizeof(scenarios) / sizeof(scenarios[0]);
+    ScenarioResult* results = (ScenarioResult*)calloc(scenario_count, sizeof(ScenarioResult));
+    if (!results) {
+        return 1;
+    }
+    FILE* progress = options.json_path ? stderr : stdout;
+    fprintf(progress, "%-24s %7s %12s %12s %12s   %29s   %41s\n", "", "", "saturated", "target", "achieved",
+            "service ns (uncorrected)", "response ns (CO-corrected)");
+    fprintf(progress, "%-24s %7s %12s %12s %12s   %9s %9s %9s   %9s %9s %9s %11s\n", "scenario", "threads",
+            "ops/s", "ops/s", "ops/s", "p50", "p99", "p99.9", "p50", "p99", "p99.9", "max");
+
+    size_t result_count = 0;
+    for (size_t i = 0; i < scenario_count; i++) {
+        if (options.filter && !strstr(scenarios[i].name, options.filter)) {
+            continue;
+        }
+        if (run_scenario(&scenarios[i], &options, &config, &results[result_count]) != 0) {
+            fprintf(stderr, "Scenario %s failed (could not start %d threads)\n", scenarios[i].name, options.threads);
+            free(results);
+            return 1;
+        }
+        print_result(progress, &results[result_count]);
+        result_count++;
+    }
+
+    int status = 0;
+    if (options.json_path) {
+        FILE* out = strcmp(options.json_path, "-") == 0 ? stdout : fopen(options.json_path, "w");
+        if (!out) {
+            fprintf(stderr, "Cannot write %s\n", options.json_path);
+            status = 1;
+        } else {
+            write_json(out, &options, results, result_count);
+            if (out != stdout) {
+                fclose(out);
+            }
+        }
+    }
+    free(results);
+    return status;
+}
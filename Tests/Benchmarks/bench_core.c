@@ -0,0 +1,479 @@
+/**
+ * ColorJourney Core Benchmarks
+ *
+ * One or more cases for every public function in ColorJourney.h. Palette
+ * cases report time per color; conversion and utility cases cycle through a
+ * fixed table of inputs so the compiler cannot hoist the work out of the loop.
+ *
+ * Supersedes Tests/CColorJourneyTests/performance_baseline.c (clock()-based,
+ * fixed iterations, text only). The discrete_at / discrete_range cases at
+ * 1-1000 colors keep that harness's coverage for comparison.
+ *
+ * The case table is shared by colorjourney_bench (bench_main.c) and the
+ * regression gate (perf_gate.c).
+ */
+
+#include "bench_core.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define INPUT_TABLE_SIZE 256
+#define INPUT_TABLE_MASK (INPUT_TABLE_SIZE - 1)
+#define MAX_PALETTE 1000
+#define IMAGE_SIDE 256
+
+static CJ_RGB rgb_inputs[INPUT_TABLE_SIZE];
+static CJ_Lab lab_inputs[INPUT_TABLE_SIZE];
+static CJ_LCh lch_inputs[INPUT_TABLE_SIZE];
+static float t_inputs[INPUT_TABLE_SIZE];
+static CJ_RGB palette_buffer[MAX_PALETTE];
+static uint8_t image_pixels[IMAGE_SIDE * IMAGE_SIDE * 4];
+static CJ_GradientTable gradient_table;
+
+typedef struct {
+    CJ_Config config;
+    CJ_Journey journey;
+    int count;
+    int start;
+} JourneyContext;
+
+static void init_inputs(void) {
+    uint64_t state = 0x243f6a8885a308d3ULL;
+    for (int i = 0; i < INPUT_TABLE_SIZE; i++) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        rgb_inputs[i].r = (float)((state >> 40) & 0xffff) / 65535.0f;
+        rgb_inputs[i].g = (float)((state >> 24) & 0xffff) / 65535.0f;
+        rgb_inputs[i].b = (float)((state >> 8) & 0xffff) / 65535.0f;
+        lab_inputs[i] = cj_rgb_to_oklab(rgb_inputs[i]);
+        lch_inputs[i] = cj_oklab_to_lch(lab_inputs[i]);
+        t_inputs[i] = (float)i / (float)INPUT_TABLE_SIZE;
+    }
+    for (size_t i = 0; i < sizeof(image_pixels); i++) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        image_pixels[i] = (uint8_t)(state >> 56);
+    }
+}
+
+static void init_journey_context(JourneyContext* context, int anchor_count, CJ_ContrastLevel contrast) {
+    cj_config_init(&context->config);
+    context->config.anchor_count = anchor_count;
+    for (int i = 0; i < anchor_count; i++) {
+        context->config.anchors[i] = rgb_inputs[(i * 37) & INPUT_TABLE_MASK];
+    }
+    context->config.contrast_level = contrast;
+    context->journey = cj_journey_create(&context->config);
+    context->count = 0;
+    context->start = 0;
+}
+
+/* ---- Kernels ---------------------------------------------------------- */
+
+static void kernel_config_init(void* context, uint64_t iterations) {
+    (void)context;
+    CJ_Config config;
+    for (uint64_t i = 0; i < iterations; i++) {
+        cj_config_init(&config);
+        bench_consume_float(config.mid_journey_vibrancy);
+    }
+}
+
+static void kernel_create_destroy(void* context, uint64_t iterations) {
+    JourneyContext* c = (JourneyContext*)context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        CJ_Journey journey = cj_journey_create(&c->config);
+        cj_journey_destroy(journey);
+    }
+}
+
+static void kernel_sample(void* context, uint64_t iterations) {
+    JourneyContext* c = (JourneyContext*)context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        bench_consume_rgb(cj_journey_sample(c->journey, t_inputs[i & INPUT_TABLE_MASK]));
+    }
+}
+
+static void kernel_discrete(void* context, uint64_t iterations) {
+    JourneyContext* c = (JourneyContext*)context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        cj_journey_discrete(c->journey, c->count, palette_buffer);
+        bench_consume_rgb(palette_buffer[c->count - 1]);
+    }
+}
+
+static void kernel_discrete_at(void* context, uint64_t iterations) {
+    JourneyContext* c = (JourneyContext*)context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        /* Same access pattern as performance_baseline.c: indices 0..count-1 one at a time. */
+        for (int index = 0; index < c->count; index++) {
+            bench_consume_rgb(cj_journey_discrete_at(c->journey, index));
+        }
+    }
+}
+
+static void kernel_discrete_range(void* context, uint64_t iterations) {
+    JourneyContext* c = (JourneyContext*)context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        cj_journey_discrete_range(c->journey, c->start, c->count, palette_buffer);
+        bench_consume_rgb(palette_buffer[c->count - 1]);
+    }
+}
+
+static void kernel_rgb_to_oklab(void* context, uint64_t iterations) {
+    (void)context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        bench_consume_float(cj_rgb_to_oklab(rgb_inputs[i & INPUT_TABLE_MASK]).L);
+    }
+}
+
+static void kernel_oklab_to_rgb(void* context, uint64_t iterations) {
+    (void)context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        bench_consume_rgb(cj_oklab_to_rgb(lab_inputs[i & INPUT_TABLE_MASK]));
+    }
+}
+
+static void kernel_oklab_to_lch(void* context, uint64_t iterations) {
+    (void)context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        bench_consume_float(cj_oklab_to_lch(lab_inputs[i & INPUT_TABLE_MASK]).h);
+    }
+}
+
+static void kernel_lch_to_oklab(void* context, uint64_t iterations) {
+    (void)context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        bench_consume_float(cj_lch_to_oklab(lch_inputs[i & INPUT_TABLE_MASK]).a);
+    }
+}
+
+static void kernel_delta_e(void* context, uint64_t iterations) {
+    (void)context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        bench_consume_float(cj_delta_e(lab_inputs[i & INPUT_TABLE_MASK], lab_inputs[(i + 1) & INPUT_TABLE_MASK]));
+    }
+}
+
+static void kernel_rgb_clamp(void* context, uint64_t iterations) {
+    (void)context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        const CJ_RGB c = rgb_inputs[i & INPUT_TABLE_MASK];
+        const CJ_RGB out_of_gamut = {c.r * 1.5f - 0.25f, c.g * 1.5f - 0.25f, c.b * 1.5f - 0.25f};
+        bench_consume_rgb(cj_rgb_clamp(out_of_gamut));
+    }
+}
+
+static void kernel_is_readable(void* context, uint64_t iterations) {
+    (void)context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        bench_consume_float(cj_is_readable(lab_inputs[i & INPUT_TABLE_MASK]) ? 1.0f : 0.0f);
+    }
+}
+
+static void kernel_enforce_contrast(void* context, uint64_t iterations) {
+    (void)context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        bench_consume_float(cj_enforce_contrast(lab_inputs[i & INPUT_TABLE_MASK],
+                                                lab_inputs[(i + 7) & INPUT_TABLE_MASK], 0.15f).L);
+    }
+}
+
+static void kernel_gradient_table_bake(void* context, uint64_t iterations) {
+    JourneyContext* journey = (JourneyContext*)context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        cj_gradient_table_bake(journey->journey, &gradient_table);
+        bench_consume_float(gradient_table.rgb[i & (CJ_GRADIENT_TABLE_SIZE - 1)][0]);
+    }
+}
+
+/* In place, one 256x256 RGBA8 image per iteration, with a pre-baked table. */
+static void kernel_image_gradient_map(void* context, uint64_t iterations) {
+    JourneyContext* journey = (JourneyContext*)context;
+    const CJ_GradientMapOptions options = {true, &gradient_table};
+    for (uint64_t i = 0; i < iterations; i++) {
+        cj_image_gradient_map(journey->journey, image_pixels, image_pixels, IMAGE_SIDE, IMAGE_SIDE, IMAGE_SIDE * 4,
+                              CJ_PIXEL_RGBA8, &options);
+    }
+    bench_consume_float(image_pixels[0]);
+}
+
+/* Random pixels never settle early, so this is the all-iterations worst case. */
+static void kernel_extract_anchors(void* context, uint64_t iterations) {
+    (void)context;
+    CJ_RGB anchors[8];
+    for (uint64_t i = 0; i < iterations; i++) {
+        bench_consume_float((float)cj_extract_anchors(image_pixels, IMAGE_SIDE, IMAGE_SIDE, IMAGE_SIDE * 4,
+                                                      CJ_PIXEL_RGBA8, 5, anchors));
+    }
+}
+
+static void kernel_cvd_simulate_batch(void* context, uint64_t iterations) {
+    (void)context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        cj_cvd_simulate_batch(rgb_inputs, INPUT_TABLE_SIZE, (CJ_CVDType)(i % 3), palette_buffer);
+        bench_consume_rgb(palette_buffer[i & INPUT_TABLE_MASK]);
+    }
+}
+
+/* All 256 inputs against the first 16 as backgrounds, 4096 pairs per call. */
+static float contrast_values[INPUT_TABLE_SIZE * 16];
+static bool contrast_pass[INPUT_TABLE_SIZE * 16];
+
+static void kernel_contrast_wcag_batch(void* context, uint64_t iterations) {
+    (void)context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        cj_contrast_wcag_batch(rgb_inputs, INPUT_TABLE_SIZE, rgb_inputs, 16, contrast_values, 4.5f, contrast_pass);
+        bench_consume_float(contrast_values[i & INPUT_TABLE_MASK]);
+    }
+}
+
+static void kernel_contrast_apca_batch(void* context, uint64_t iterations) {
+    (void)context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        cj_contrast_apca_batch(rgb_inputs, INPUT_TABLE_SIZE, rgb_inputs, 16, contrast_values, 60.0f, contrast_pass);
+        bench_consume_float(contrast_values[i & INPUT_TABLE_MASK]);
+    }
+}
+
+/* 65536 values (log-uniform over [1, 1e4], a few NaN) into image_pixels as RGBA8. */
+#define COLORMAP_VALUES (IMAGE_SIDE * IMAGE_SIDE)
+static float colormap_values[COLORMAP_VALUES];
+
+typedef struct {
+    CJ_ColormapOptions options;
+    CJ_ColormapEqualization equalization;
+} ColormapContext;
+
+static void init_colormap_values(void) {
+    uint64_t state = 0x9e3779b97f4a7c15ULL;
+    for (int i = 0; i < COLORMAP_VALUES; i++) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        colormap_values[i] = (i % 997 == 0) ? NAN : powf(10.0f, 4.0f * (float)(state >> 40) / 16777216.0f);
+    }
+}
+
+static void kernel_colormap_apply(void* context, uint64_t iterations) {
+    ColormapContext* colormap = (ColormapContext*)context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        cj_colormap_apply(NULL, colormap_values, COLORMAP_VALUES, 1.0f, 1e4f, image_pixels, CJ_PIXEL_RGBA8,
+                          &colormap->options);
+    }
+    bench_consume_float(image_pixels[0]);
+}
+
+typedef struct {
+    CJ_RGB palette[256];
+    int count;
+    CJ_PaletteIndex index;
+} PaletteIndexContext;
+
+static void kernel_palette_index_create(void* context, uint64_t iterations) {
+    PaletteIndexContext* palette = (PaletteIndexContext*)context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        CJ_PaletteIndex index = cj_palette_index_create(palette->palette, palette->count, 0);
+        bench_consume_float((float)cj_palette_index_nearest(index, rgb_inputs[i & INPUT_TABLE_MASK], NULL));
+        cj_palette_index_destroy(index);
+    }
+}
+
+static void kernel_palette_index_nearest(void* context, uint64_t iterations) {
+    PaletteIndexContext* palette = (PaletteIndexContext*)context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        bench_consume_float((float)cj_palette_index_nearest(palette->index, rgb_inputs[i & INPUT_TABLE_MASK], NULL));
+    }
+}
+
+static void kernel_palette_cvd_adjacent(void* context, uint64_t iterations) {
+    PaletteIndexContext* palette = (PaletteIndexContext*)context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        bench_consume_float(cj_palette_cvd_min_delta_e(palette->palette, palette->count, CJ_CVD_DEUTAN, false));
+    }
+}
+
+static void kernel_palette_cvd_all_pairs(void* context, uint64_t iterations) {
+    PaletteIndexContext* palette = (PaletteIndexContext*)context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        bench_consume_float(cj_palette_cvd_min_delta_e(palette->palette, palette->count, CJ_CVD_DEUTAN, true));
+    }
+}
+
+static void kernel_palette_index_nearest_approx(void* context, uint64_t iterations) {
+    PaletteIndexContext* palette = (PaletteIndexContext*)context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        bench_consume_float((float)cj_palette_index_nearest_approx(palette->index, rgb_inputs[i & INPUT_TABLE_MASK]));
+    }
+}
+
+/* ---- Suite ------------------------------------------------------------ */
+
+enum { ANCHOR_1, ANCHOR_3, ANCHOR_8, JOURNEY_CONTEXTS };
+
+static JourneyContext journeys[JOURNEY_CONTEXTS];
+
+#define PALETTE_SIZES 6
+static const int palette_sizes[PALETTE_SIZES] = {1, 10, 50, 100, 500, 1000};
+static JourneyContext discrete_contexts[PALETTE_SIZES];
+static JourneyContext discrete_at_contexts[PALETTE_SIZES];
+static JourneyContext range_contexts[PALETTE_SIZES];
+static JourneyContext range_offset_context;
+static char palette_names[3][PALETTE_SIZES][48];
+static PaletteIndexContext palette_indexes[2];
+static ColormapContext colormaps[4];
+static char colormap_names[4][48];
+
+static void init_palette_index(PaletteIndexContext* context, int count, int grid_resolution) {
+    cj_journey_discrete(journeys[ANCHOR_3].journey, count, context->palette);
+    context->count = count;
+    context->index = cj_palette_index_create(context->palette, count, grid_resolution);
+}
+
+static CJ_JourneyInverse journey_inverse;
+
+static void kernel_journey_inverse_create(void* context, uint64_t iterations) {
+    const JourneyContext* journey = (const JourneyContext*)context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        CJ_JourneyInverse inverse = cj_journey_inverse_create(journey->journey, 1024);
+        bench_consume_float(cj_journey_inverse_query(inverse, rgb_inputs[i & INPUT_TABLE_MASK], NULL));
+        cj_journey_inverse_destroy(inverse);
+    }
+}
+
+static void kernel_journey_inverse_query(void* context, uint64_t iterations) {
+    (void)context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        float distance;
+        bench_consume_float(cj_journey_inverse_query(journey_inverse, rgb_inputs[i & INPUT_TABLE_MASK], &distance));
+        bench_consume_float(distance);
+    }
+}
+
+static CJ_JourneyField journey_fields[2]; /* bilinear, bicubic */
+static uint8_t field_pixels[IMAGE_SIDE * IMAGE_SIDE * 4];
+
+static void kernel_journey_field_sample(void* context, uint64_t iterations) {
+    CJ_JourneyField field = *(const CJ_JourneyField*)context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        const CJ_RGB uv = rgb_inputs[i & INPUT_TABLE_MASK];
+        bench_consume_rgb(cj_journey_field_sample(field, uv.r, uv.g));
+    }
+}
+
+static void kernel_journey_field_rasterize(void* context, uint64_t iterations) {
+    CJ_JourneyField field = *(const CJ_JourneyField*)context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        cj_journey_field_rasterize(field, field_pixels, IMAGE_SIDE, IMAGE_SIDE, IMAGE_SIDE * 4, CJ_PIXEL_RGBA8,
+                                   0, IMAGE_SIDE);
+        bench_consume_float((float)field_pixels[i & (IMAGE_SIDE * IMAGE_SIDE * 4 - 1)]);
+    }
+}
+
+size_t bench_core_cases(BenchCase* cases, size_t capacity) {
+    if (capacity < BENCH_CORE_MAX_CASES) {
+        return 0;
+    }
+
+    init_inputs();
+    init_journey_context(&journeys[ANCHOR_1], 1, CJ_CONTRAST_MEDIUM);
+    init_journey_context(&journeys[ANCHOR_3], 3, CJ_CONTRAST_MEDIUM);
+    init_journey_context(&journeys[ANCHOR_8], 8, CJ_CONTRAST_MEDIUM);
+
+    size_t n = 0;
+    cases[n++] = (BenchCase){"config_init", "cj_config_init", kernel_config_init, NULL, 1.0};
+    cases[n++] = (BenchCase){"journey_create_destroy/anchors=1", "cj_journey_create/cj_journey_destroy", kernel_create_destroy, &journeys[ANCHOR_1], 1.0};
+    cases[n++] = (BenchCase){"journey_create_destroy/anchors=3", "cj_journey_create/cj_journey_destroy", kernel_create_destroy, &journeys[ANCHOR_3], 1.0};
+    cases[n++] = (BenchCase){"journey_create_destroy/anchors=8", "cj_journey_create/cj_journey_destroy", kernel_create_destroy, &journeys[ANCHOR_8], 1.0};
+    cases[n++] = (BenchCase){"journey_sample/anchors=1", "cj_journey_sample", kernel_sample, &journeys[ANCHOR_1], 1.0};
+    cases[n++] = (BenchCase){"journey_sample/anchors=3", "cj_journey_sample", kernel_sample, &journeys[ANCHOR_3], 1.0};
+    cases[n++] = (BenchCase){"journey_sample/anchors=8", "cj_journey_sample", kernel_sample, &journeys[ANCHOR_8], 1.0};
+
+    for (int s = 0; s < PALETTE_SIZES; s++) {
+        const int count = palette_sizes[s];
+        init_journey_context(&discrete_contexts[s], 2, CJ_CONTRAST_MEDIUM);
+        discrete_contexts[s].count = count;
+        discrete_at_contexts[s] = discrete_contexts[s];
+        range_contexts[s] = discrete_contexts[s];
+
+        snprintf(palette_names[0][s], sizeof(palette_names[0][s]), "journey_discrete/n=%d", count);
+        snprintf(palette_names[1][s], sizeof(palette_names[1][s]), "journey_discrete_at/n=%d", count);
+        snprintf(palette_names[2][s], sizeof(palette_names[2][s]), "journey_discrete_range/start=0,n=%d", count);
+        cases[n++] = (BenchCase){palette_names[0][s], "cj_journey_discrete", kernel_discrete, &discrete_contexts[s], (double)count};
+        cases[n++] = (BenchCase){palette_names[1][s], "cj_journey_discrete_at", kernel_discrete_at, &discrete_at_contexts[s], (double)count};
+        cases[n++] = (BenchCase){palette_names[2][s], "cj_journey_discrete_range", kernel_discrete_range, &range_contexts[s], (double)count};
+    }
+    range_offset_context = discrete_contexts[0];
+    range_offset_context.start = 1000;
+    range_offset_context.count = 10;
+    cases[n++] = (BenchCase){"journey_discrete_range/start=1000,n=10", "cj_journey_discrete_range", kernel_discrete_range, &range_offset_context, 10.0};
+
+    cases[n++] = (BenchCase){"rgb_to_oklab", "cj_rgb_to_oklab", kernel_rgb_to_oklab, NULL, 1.0};
+    cases[n++] = (BenchCase){"oklab_to_rgb", "cj_oklab_to_rgb", kernel_oklab_to_rgb, NULL, 1.0};
+    cases[n++] = (BenchCase){"oklab_to_lch", "cj_oklab_to_lch", kernel_oklab_to_lch, NULL, 1.0};
+    cases[n++] = (BenchCase){"lch_to_oklab", "cj_lch_to_oklab", kernel_lch_to_oklab, NULL, 1.0};
+    cases[n++] = (BenchCase){"delta_e", "cj_delta_e", kernel_delta_e, NULL, 1.0};
+    cases[n++] = (BenchCase){"rgb_clamp", "cj_rgb_clamp", kernel_rgb_clamp, NULL, 1.0};
+    cases[n++] = (BenchCase){"is_readable", "cj_is_readable", kernel_is_readable, NULL, 1.0};
+    cases[n++] = (BenchCase){"enforce_contrast", "cj_enforce_contrast", kernel_enforce_contrast, NULL, 1.0};
+
+    cj_gradient_table_bake(journeys[ANCHOR_3].journey, &gradient_table);
+    cases[n++] = (BenchCase){"gradient_table_bake", "cj_gradient_table_bake", kernel_gradient_table_bake, &journeys[ANCHOR_3], 1.0};
+    cases[n++] = (BenchCase){"image_gradient_map/rgba8,256x256", "cj_image_gradient_map", kernel_image_gradient_map, &journeys[ANCHOR_3], (double)(IMAGE_SIDE * IMAGE_SIDE)};
+
+    init_palette_index(&palette_indexes[0], 16, 0);
+    init_palette_index(&palette_indexes[1], 256, 32);
+    cases[n++] = (BenchCase){"palette_index_create/n=256", "cj_palette_index_create", kernel_palette_index_create, &palette_indexes[1], 1.0};
+    cases[n++] = (BenchCase){"palette_index_nearest/n=16", "cj_palette_index_nearest", kernel_palette_index_nearest, &palette_indexes[0], 1.0};
+    cases[n++] = (BenchCase){"palette_index_nearest/n=256", "cj_palette_index_nearest", kernel_palette_index_nearest, &palette_indexes[1], 1.0};
+    cases[n++] = (BenchCase){"palette_index_nearest_approx/n=256,grid=32", "cj_palette_index_nearest_approx", kernel_palette_index_nearest_approx, &palette_indexes[1], 1.0};
+    cases[n++] = (BenchCase){"extract_anchors/k=5,256x256", "cj_extract_anchors", kernel_extract_anchors, NULL, 1.0};
+    cases[n++] = (BenchCase){"cvd_simulate_batch/n=256", "cj_cvd_simulate_batch", kernel_cvd_simulate_batch, NULL, (double)INPUT_TABLE_SIZE};
+    cases[n++] = (BenchCase){"palette_cvd_min_delta_e/adjacent,n=16", "cj_palette_cvd_min_delta_e", kernel_palette_cvd_adjacent, &palette_indexes[0], 1.0};
+    cases[n++] = (BenchCase){"palette_cvd_min_delta_e/all_pairs,n=16", "cj_palette_cvd_min_delta_e", kernel_palette_cvd_all_pairs, &palette_indexes[0], 1.0};
+    cases[n++] = (BenchCase){"palette_cvd_min_delta_e/all_pairs,n=256", "cj_palette_cvd_min_delta_e", kernel_palette_cvd_all_pairs, &palette_indexes[1], 1.0};
+    cases[n++] = (BenchCase){"contrast_wcag_batch/256x16", "cj_contrast_wcag_batch", kernel_contrast_wcag_batch, NULL, (double)(INPUT_TABLE_SIZE * 16)};
+    cases[n++] = (BenchCase){"contrast_apca_batch/256x16", "cj_contrast_apca_batch", kernel_contrast_apca_batch, NULL, (double)(INPUT_TABLE_SIZE * 16)};
+
+    init_colormap_values();
+    static const char* const normalization_names[4] = {"linear", "log", "symlog", "histogram"};
+    for (int m = 0; m < 4; m++) {
+        cj_colormap_options_init(&colormaps[m].options);
+        colormaps[m].options.normalization = (CJ_Normalization)m;
+        colormaps[m].options.table = &gradient_table;
+        if (m == CJ_NORM_HISTOGRAM) {
+            cj_colormap_equalize(colormap_values, COLORMAP_VALUES, 1.0f, 1e4f, &colormaps[m].equalization);
+            colormaps[m].options.equalization = &colormaps[m].equalization;
+        }
+        snprintf(colormap_names[m], sizeof(colormap_names[m]), "colormap_apply/%s,n=65536", normalization_names[m]);
+        cases[n++] = (BenchCase){colormap_names[m], "cj_colormap_apply", kernel_colormap_apply, &colormaps[m], (double)COLORMAP_VALUES};
+    }
+
+    journey_inverse = cj_journey_inverse_create(journeys[ANCHOR_8].journey, 1024);
+    cases[n++] = (BenchCase){"journey_inverse_create/samples=1024", "cj_journey_inverse_create", kernel_journey_inverse_create, &journeys[ANCHOR_8], 1.0};
+    cases[n++] = (BenchCase){"journey_inverse_query/samples=1024", "cj_journey_inverse_query", kernel_journey_inverse_query, NULL, 1.0};
+
+    CJ_Journey field_rows[2] = {journeys[ANCHOR_3].journey, journeys[ANCHOR_8].journey};
+    journey_fields[0] = cj_journey_field_create(field_rows, 2, CJ_FIELD_BILINEAR);
+    journey_fields[1] = cj_journey_field_create(field_rows, 2, CJ_FIELD_BICUBIC);
+    cases[n++] = (BenchCase){"journey_field_sample/bilinear", "cj_journey_field_sample", kernel_journey_field_sample, &journey_fields[0], 1.0};
+    cases[n++] = (BenchCase){"journey_field_sample/bicubic", "cj_journey_field_sample", kernel_journey_field_sample, &journey_fields[1], 1.0};
+    cases[n++] = (BenchCase){"journey_field_rasterize/bilinear,256x256", "cj_journey_field_rasterize", kernel_journey_field_rasterize, &journey_fields[0], (double)(IMAGE_SIDE * IMAGE_SIDE)};
+    cases[n++] = (BenchCase){"journey_field_rasterize/bicubic,256x256", "cj_journey_field_rasterize", kernel_journey_field_rasterize, &journey_fields[1], (double)(IMAGE_SIDE * IMAGE_SIDE)};
+
+    return n;
+}
+
+void bench_core_release(void) {
+    for (int i = 0; i < JOURNEY_CONTEXTS; i++) {
+        cj_journey_destroy(journeys[i].journey);
+    }
+    for (int s = 0; s < PALETTE_SIZES; s++) {
+        cj_journey_destroy(discrete_contexts[s].journey);
+    }
+    for (int i = 0; i < 2; i++) {
+        cj_palette_index_destroy(palette_indexes[i].index);
+    }
+    cj_journey_inverse_destroy(journey_inverse);
+    for (int i = 0; i < 2; i++) {
+        cj_journey_field_destroy(journey_fields[i]);
+    }
+}
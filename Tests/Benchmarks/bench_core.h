@@ -0,0 +1,24 @@
+/**
+ * ColorJourney Core Benchmark Cases
+ *
+ * Case table for every public function in ColorJourney.h, shared by the
+ * benchmark runner and the performance regression gate.
+ */
+
+#ifndef COLORJOURNEY_BENCH_CORE_H
+#define COLORJOURNEY_BENCH_CORE_H
+
+#include "bench.h"
+
+#define BENCH_CORE_MAX_CASES 64
+
+/**
+ * Create the journeys and fill `cases` (capacity >= BENCH_CORE_MAX_CASES).
+ * Returns the number of cases, or 0 if the capacity is too small.
+ */
+size_t bench_core_cases(BenchCase* cases, size_t capacity);
+
+/** Destroy the journeys created by bench_core_cases(). */
+void bench_core_release(void);
+
+#endif /* COLORJOURNEY_BENCH_CORE_H */
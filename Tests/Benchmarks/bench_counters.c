@@ -0,0 +1,146 @@
+/**
+ * ColorJourney Benchmark Harness - hardware performance counters
+ *
+ * Linux perf_event_open counters for --counters. Each event is opened on its
+ * own (not as a group) so one unsupported event, e.g. LLC misses on a VM,
+ * does not take the others down with it. Counts are user-space only, which
+ * also keeps them readable at perf_event_paranoid=2.
+ *
+ * On other platforms, or when the kernel refuses (containers, seccomp,
+ * paranoid=3), every event reports unavailable and the harness falls back to
+ * wall time.
+ */
+
+#if defined(__linux__)
+#define _GNU_SOURCE
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "bench.h"
+
+#include <math.h>
+#include <string.h>
+
+const char* const bench_counter_names[BENCH_COUNTER_COUNT] = {
+    "cycles", "instructions", "branchMisses", "l1dMisses", "llcMisses"
+};
+
+#if defined(__linux__)
+
+static void counter_attr(BenchCounterId id, struct perf_event_attr* attr) {
+    memset(attr, 0, sizeof(*attr));
+    attr->size = sizeof(*attr);
+    attr->disabled = 1;
+    attr->exclude_kernel = 1;
+    attr->exclude_hv = 1;
+    attr->read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    switch (id) {
+    case BENCH_COUNTER_CYCLES:
+        attr->type = PERF_TYPE_HARDWARE;
+        attr->config = PERF_COUNT_HW_CPU_CYCLES;
+        break;
+    case BENCH_COUNTER_INSTRUCTIONS:
+        attr->type = PERF_TYPE_HARDWARE;
+        attr->config = PERF_COUNT_HW_INSTRUCTIONS;
+        break;
+    case BENCH_COUNTER_BRANCH_MISSES:
+        attr->type = PERF_TYPE_HARDWARE;
+        attr->config = PERF_COUNT_HW_BRANCH_MISSES;
+        break;
+    case BENCH_COUNTER_L1D_MISSES:
+        attr->type = PERF_TYPE_HW_CACHE;
+        attr->config = PERF_COUNT_HW_CACHE_L1D
+                     | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                     | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        break;
+    case BENCH_COUNTER_LLC_MISSES:
+        attr->type = PERF_TYPE_HARDWARE;
+        attr->config = PERF_COUNT_HW_CACHE_MISSES;
+        break;
+    case BENCH_COUNTER_COUNT:
+        break;
+    }
+}
+
+int bench_counters_open(BenchCounters* counters) {
+    counters->available_count = 0;
+    for (int i = 0; i < BENCH_COUNTER_COUNT; i++) {
+        struct perf_event_attr attr;
+        counter_attr((BenchCounterId)i, &attr);
+        counters->fds[i] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        if (counters->fds[i] >= 0) {
+            counters->available_count++;
+        }
+    }
+    return counters->available_count;
+}
+
+void bench_counters_close(BenchCounters* counters) {
+    for (int i = 0; i < BENCH_COUNTER_COUNT; i++) {
+        if (counters->fds[i] >= 0) {
+            close(counters->fds[i]);
+            counters->fds[i] = -1;
+        }
+    }
+    counters->available_count = 0;
+}
+
+void bench_counters_start(BenchCounters* counters) {
+    for (int i = 0; i < BENCH_COUNTER_COUNT; i++) {
+        if (counters->fds[i] >= 0) {
+            ioctl(counters->fds[i], PERF_EVENT_IOC_RESET, 0);
+            ioctl(counters->fds[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+}
+
+void bench_counters_stop(BenchCounters* counters, double values[BENCH_COUNTER_COUNT]) {
+    for (int i = 0; i < BENCH_COUNTER_COUNT; i++) {
+        if (counters->fds[i] >= 0) {
+            ioctl(counters->fds[i], PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+    for (int i = 0; i < BENCH_COUNTER_COUNT; i++) {
+        values[i] = NAN;
+        if (counters->fds[i] < 0) {
+            continue;
+        }
+        /* value, time_enabled, time_running */
+        uint64_t data[3];
+        if (read(counters->fds[i], data, sizeof(data)) != (ssize_t)sizeof(data) || data[2] == 0) {
+            continue;
+        }
+        /* Scale up when the PMU multiplexed this event with others. */
+        values[i] = (double)data[0] * ((double)data[1] / (double)data[2]);
+    }
+}
+
+#else
+
+int bench_counters_open(BenchCounters* counters) {
+    for (int i = 0; i < BENCH_COUNTER_COUNT; i++) {
+        counters->fds[i] = -1;
+    }
+    counters->available_count = 0;
+    return 0;
+}
+
+void bench_counters_close(BenchCounters* counters) {
+    (void)counters;
+}
+
+void bench_counters_start(BenchCounters* counters) {
+    (void)counters;
+}
+
+void bench_counters_stop(BenchCounters* counters, double values[BENCH_COUNTER_COUNT]) {
+    (void)counters;
+    for (int i = 0; i < BENCH_COUNTER_COUNT; i++) {
+        values[i] = NAN;
+    }
+}
+
+#endif
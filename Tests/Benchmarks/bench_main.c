@@ -0,0 +1,22 @@
+/**
+ * colorjourney_bench - runs the core benchmark suite
+ *
+ * Usage: colorjourney_bench [--filter <substr>] [--json <path|->] [--quick] ...
+ */
+
+#include "bench_core.h"
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    bench_options_init(&options);
+    const int parsed = bench_parse_args(&options, argc, argv);
+    if (parsed != 0) {
+        return parsed > 0 ? 0 : 2;
+    }
+
+    BenchCase cases[BENCH_CORE_MAX_CASES];
+    const size_t count = bench_core_cases(cases, BENCH_CORE_MAX_CASES);
+    const int status = bench_run_suite("core", cases, count, &options);
+    bench_core_release();
+    return status;
+}
@@ -0,0 +1,386 @@
+/**
+ * colorjourney_bench_scaling - asymptotic scaling sweep for the discrete APIs
+ *
+ * Sweeps n over half-decades from 1 to --max (default 1,000,000) for:
+ * - cj_journey_discrete(n colors)
+ * - cj_journey_discrete_range(start = n, 16 colors)
+ * - cj_journey_discrete_at(index = n)
+ * and times one call at each point. Each curve is then fitted to
+ * t(n) = a + b * f(n) for f in {1, log n, n, n log n, n^2} by least squares
+ * on relative error over n >= 10 (below that the first color, which skips
+ * contrast enforcement, dominates). The simplest model within 25% of the
+ * best residual is reported as the complexity class, next to the documented
+ * class and the log-log slope over the top decade. Crossover points are the n at which
+ * the fitted per-call curves of two APIs intersect.
+ *
+ * The fixed 1-1000 palette sizes in colorjourney_bench cannot tell O(1)
+ * from O(n) per call; this sweep makes replay costs such as discrete_at's
+ * O(index) visible and checkable (--strict fails when a measured class is
+ * worse than documented).
+ *
+ * Usage: colorjourney_bench_scaling [--max <n>] [--samples <k>] [--json <path|->] [--strict]
+ */
+
+#include "bench.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SCALING_MAX_POINTS 32
+#define SCALING_RANGE_COUNT 16
+#define SCALING_DEFAULT_MAX 1000000
+#define SCALING_FIT_MIN_N 10
+
+typedef enum {
+    MODEL_CONSTANT,
+    MODEL_LOG,
+    MODEL_LINEAR,
+    MODEL_N_LOG_N,
+    MODEL_QUADRATIC,
+    MODEL_COUNT
+} ComplexityModel;
+
+static const char* const model_names[MODEL_COUNT] = {"O(1)", "O(log n)", "O(n)", "O(n log n)", "O(n^2)"};
+
+typedef enum { SWEEP_DISCRETE, SWEEP_RANGE, SWEEP_AT, SWEEP_COUNT } SweepId;
+
+typedef struct {
+    const char* name;
+    const char* function;
+    ComplexityModel documented;   ///< Per-call class from ColorJourney.h
+    BenchKernel kernel;
+} Sweep;
+
+typedef struct {
+    CJ_Journey journey;
+    int n;
+    CJ_RGB* buffer;
+} ScalingContext;
+
+typedef struct {
+    double a;
+    double b;
+    double residual;              ///< RMS relative error
+} ModelFit;
+
+typedef struct {
+    int point_count;
+    int n[SCALING_MAX_POINTS];
+    double call_ns[SCALING_MAX_POINTS];
+    ModelFit fits[MODEL_COUNT];
+    ComplexityModel measured;
+    double slope;                 ///< log-log slope over the top decade
+} SweepResult;
+
+static void kernel_discrete(void* context, uint64_t iterations) {
+    ScalingContext* c = (ScalingContext*)context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        cj_journey_discrete(c->journey, c->n, c->buffer);
+        bench_consume_rgb(c->buffer[c->n - 1]);
+    }
+}
+
+static void kernel_range(void* context, uint64_t iterations) {
+    ScalingContext* c = (ScalingContext*)context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        cj_journey_discrete_range(c->journey, c->n, SCALING_RANGE_COUNT, c->buffer);
+        bench_consume_rgb(c->buffer[SCALING_RANGE_COUNT - 1]);
+    }
+}
+
+static void kernel_at(void* context, uint64_t iterations) {
+    ScalingContext* c = (ScalingContext*)context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        bench_consume_rgb(cj_journey_discrete_at(c->journey, c->n));
+    }
+}
+
+static const Sweep sweeps[SWEEP_COUNT] = {
+    {"discrete(count=n)", "cj_journey_discrete", MODEL_LINEAR, kernel_discrete},
+    {"discrete_range(start=n,count=16)", "cj_journey_discrete_range", MODEL_LINEAR, kernel_range},
+    {"discrete_at(index=n)", "cj_journey_discrete_at", MODEL_LINEAR, kernel_at},
+};
+
+static double model_term(ComplexityModel model, double n) {
+    switch (model) {
+    case MODEL_CONSTANT:
+        return 0.0;
+    case MODEL_LOG:
+        return log(n + 1.0);
+    case MODEL_LINEAR:
+        return n;
+    case MODEL_N_LOG_N:
+        return n * log(n + 1.0);
+    case MODEL_QUADRATIC:
+        return n * n;
+    case MODEL_COUNT:
+        break;
+    }
+    return 0.0;
+}
+
+static double model_eval(ComplexityModel model, const ModelFit* fit, double n) {
+    return fit->a + fit->b * model_term(model, n);
+}
+
+/*
+ * Weighted least squares for t = a + b*f with weights 1/t^2, i.e. minimizing
+ * relative error so microsecond and second points count equally. a and b
+ * are kept non-negative: a negative intercept or slope is not a cost model.
+ */
+static ModelFit fit_model(ComplexityModel model, const SweepResult* r) {
+    double sw = 0.0, swf = 0.0, swff = 0.0, swt = 0.0, swft = 0.0;
+    for (int i = 0; i < r->point_count; i++) {
+        if (r->n[i] < SCALING_FIT_MIN_N) {
+            continue;
+        }
+        const double w = 1.0 / (r->call_ns[i] * r->call_ns[i]);
+        const double f = model_term(model, (double)r->n[i]);
+        sw += w;
+        swf += w * f;
+        swff += w * f * f;
+        swt += w * r->call_ns[i];
+        swft += w * f * r->call_ns[i];
+    }
+
+    ModelFit fit = {swt / sw, 0.0, 0.0};
+    const double det = sw * swff - swf * swf;
+    if (model != MODEL_CONSTANT && det > 0.0) {
+        fit.a = (swff * swt - swf * swft) / det;
+        fit.b = (sw * swft - swf * swt) / det;
+        if (fit.a < 0.0) {
+            fit.a = 0.0;
+            fit.b = swff > 0.0 ? swft / swff : 0.0;
+        }
+        if (fit.b < 0.0) {
+            fit.a = swt / sw;
+            fit.b = 0.0;
+        }
+    }
+
+    double sum_sq = 0.0;
+    int fitted = 0;
+    for (int i = 0; i < r->point_count; i++) {
+        if (r->n[i] < SCALING_FIT_MIN_N) {
+            continue;
+        }
+        fitted++;
+        const double relative = (r->call_ns[i] - model_eval(model, &fit, (double)r->n[i])) / r->call_ns[i];
+        sum_sq += relative * relative;
+    }
+    fit.residual = sqrt(sum_sq / (double)fitted);
+    return fit;
+}
+
+static void classify(SweepResult* r) {
+    ComplexityModel best = MODEL_CONSTANT;
+    for (int m = 0; m < MODEL_COUNT; m++) {
+        r->fits[m] = fit_model((ComplexityModel)m, r);
+        if (r->fits[m].residual < r->fits[best].residual) {
+            best = (ComplexityModel)m;
+        }
+    }
+    /* Prefer the simplest model that explains the data nearly as well. */
+    r->measured = best;
+    for (int m = 0; m < (int)best; m++) {
+        if (r->fits[m].residual <= r->fits[best].residual * 1.25 + 0.02) {
+            r->measured = (ComplexityModel)m;
+            break;
+        }
+    }
+
+    /* Empirical exponent from the points in the top decade of the sweep. */
+    const int last = r->point_count - 1;
+    int first = last;
+    while (first > 0 && r->n[first - 1] * 10 > r->n[last]) {
+        first--;
+    }
+    if (first > 0) {
+        first--;
+    }
+    r->slope = last > first
+        ? log(r->call_ns[last] / r->call_ns[first]) / log((double)r->n[last] / (double)r->n[first])
+        : 0.0;
+}
+
+/* First n in [SCALING_FIT_MIN_N, max] where the fitted curves of two sweeps change order; 0 if none. */
+static double find_crossover(const SweepResult* x, const SweepResult* y, int max_n) {
+    double previous_sign = 0.0;
+    for (double n = SCALING_FIT_MIN_N; n <= (double)max_n; n *= 1.05) {
+        const double difference = model_eval(x->measured, &x->fits[x->measured], n)
+                                - model_eval(y->measured, &y->fits[y->measured], n);
+        const double sign = difference > 0.0 ? 1.0 : -1.0;
+        if (previous_sign != 0.0 && sign != previous_sign) {
+            return n;
+        }
+        previous_sign = sign;
+    }
+    return 0.0;
+}
+
+static int build_grid(int max_n, int* grid) {
+    int count = 0;
+    for (int k = 0; count < SCALING_MAX_POINTS; k++) {
+        const int n = (int)floor(pow(10.0, (double)k * 0.5) + 0.5);
+        if (n > max_n) {
+            break;
+        }
+        if (count == 0 || n != grid[count - 1]) {
+            grid[count++] = n;
+        }
+    }
+    return count;
+}
+
+static void write_json(FILE* out, const SweepResult* results, int max_n) {
+    fprintf(out, "{\n  \"schema\": \"colorjourney-scaling/1\",\n  \"maxN\": %d,\n  \"sweeps\": [\n", max_n);
+    for (int s = 0; s < SWEEP_COUNT; s++) {
+        const SweepResult* r = &results[s];
+        const ModelFit* fit = &r->fits[r->measured];
+        fprintf(out, "    {\"name\": \"%s\", \"function\": \"%s\", \"documented\": \"%s\", \"measured\": \"%s\", "
+                     "\"intercept_ns\": %.4g, \"coefficient_ns\": %.6g, \"residual\": %.4f, \"slope\": %.3f, \"points\": [",
+                sweeps[s].name, sweeps[s].function, model_names[sweeps[s].documented], model_names[r->measured],
+                fit->a, fit->b, fit->residual, r->slope);
+        for (int i = 0; i < r->point_count; i++) {
+            fprintf(out, "%s{\"n\": %d, \"callNs\": %.1f}", i > 0 ? ", " : "", r->n[i], r->call_ns[i]);
+        }
+        fprintf(out, "]}%s\n", s + 1 < SWEEP_COUNT ? "," : "");
+    }
+    fprintf(out, "  ],\n  \"crossovers\": [");
+    int first = 1;
+    for (int s = 0; s < SWEEP_COUNT; s++) {
+        for (int t = s + 1; t < SWEEP_COUNT; t++) {
+            const double n = find_crossover(&results[s], &results[t], max_n);
+            if (n > 0.0) {
+                fprintf(out, "%s\n    {\"a\": \"%s\", \"b\": \"%s\", \"n\": %.0f}",
+                        first ? "" : ",", sweeps[s].name, sweeps[t].name, n);
+                first = 0;
+            }
+        }
+    }
+    fprintf(out, "%s]\n}\n", first ? "" : "\n  ");
+}
+
+static void print_usage(const char* program) {
+    printf("Usage: %s [--max <n>] [--samples <k>] [--json <path|->] [--strict]\n", program);
+}
+
+int main(int argc, char** argv) {
+    int max_n = SCALING_DEFAULT_MAX;
+    int strict = 0;
+    const char* json_path = NULL;
+    BenchOptions options;
+    bench_options_init(&options);
+    options.warmup_ms = 0.0;
+    options.min_batch_ms = 5.0;
+    options.samples = 5;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--max") == 0 && i + 1 < argc) {
+            max_n = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--samples") == 0 && i + 1 < argc) {
+            options.samples = (size_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (strcmp(argv[i], "--strict") == 0) {
+            strict = 1;
+        } else if (strcmp(argv[i], "--help") == 0) {
+            print_usage(argv[0]);
+            return 0;
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+    if (max_n < 10 || options.samples == 0) {
+        fprintf(stderr, "--max must be at least 10 and --samples at least 1\n");
+        return 2;
+    }
+
+    int grid[SCALING_MAX_POINTS];
+    const int point_count = build_grid(max_n, grid);
+
+    CJ_Config config;
+    cj_config_init(&config);
+    config.anchor_count = 3;
+    config.anchors[0] = (CJ_RGB){0.85f, 0.35f, 0.25f};
+    config.anchors[1] = (CJ_RGB){0.25f, 0.65f, 0.45f};
+    config.anchors[2] = (CJ_RGB){0.30f, 0.35f, 0.85f};
+    config.contrast_level = CJ_CONTRAST_MEDIUM;
+
+    ScalingContext context;
+    context.journey = cj_journey_create(&config);
+    const int buffer_size = max_n > SCALING_RANGE_COUNT ? max_n : SCALING_RANGE_COUNT;
+    context.buffer = (CJ_RGB*)malloc((size_t)buffer_size * sizeof(CJ_RGB));
+    if (!context.journey || !context.buffer) {
+        fprintf(stderr, "Allocation failed\n");
+        cj_journey_destroy(context.journey);
+        free(context.buffer);
+        return 1;
+    }
+
+    FILE* progress = json_path ? stderr : stdout;
+    SweepResult results[SWEEP_COUNT];
+    for (int s = 0; s < SWEEP_COUNT; s++) {
+        SweepResult* r = &results[s];
+        r->point_count = point_count;
+        fprintf(progress, "%s\n", sweeps[s].name);
+        for (int i = 0; i < point_count; i++) {
+            context.n = grid[i];
+            const BenchCase bench_case = {sweeps[s].name, sweeps[s].function, sweeps[s].kernel, &context, 1.0};
+            BenchResult result;
+            if (bench_run_case(&bench_case, &options, &result) != 0) {
+                fprintf(stderr, "Sweep %s failed at n=%d\n", sweeps[s].name, grid[i]);
+                cj_journey_destroy(context.journey);
+                free(context.buffer);
+                return 1;
+            }
+            r->n[i] = grid[i];
+            r->call_ns[i] = result.median_ns;
+            fprintf(progress, "  n=%-8d %14.1f ns/call %12.2f ns/color\n", grid[i], result.median_ns,
+                    result.median_ns / (double)(s == SWEEP_DISCRETE ? grid[i] : s == SWEEP_RANGE ? SCALING_RANGE_COUNT : 1));
+        }
+        classify(r);
+    }
+    cj_journey_destroy(context.journey);
+    free(context.buffer);
+
+    int worse_than_documented = 0;
+    fprintf(progress, "\n%-34s %-11s %-11s %8s %9s\n", "sweep", "documented", "measured", "slope", "residual");
+    for (int s = 0; s < SWEEP_COUNT; s++) {
+        const SweepResult* r = &results[s];
+        const int worse = r->measured > sweeps[s].documented;
+        worse_than_documented += worse;
+        fprintf(progress, "%-34s %-11s %-11s %8.2f %9.3f%s\n", sweeps[s].name, model_names[sweeps[s].documented],
+                model_names[r->measured], r->slope, r->fits[r->measured].residual,
+                worse ? "  worse than documented" : "");
+    }
+    fprintf(progress, "\nCrossovers (fitted per-call cost):\n");
+    for (int s = 0; s < SWEEP_COUNT; s++) {
+        for (int t = s + 1; t < SWEEP_COUNT; t++) {
+            const double n = find_crossover(&results[s], &results[t], max_n);
+            if (n > 0.0) {
+                fprintf(progress, "  %s vs %s: n ~ %.0f\n", sweeps[s].name, sweeps[t].name, n);
+            } else {
+                fprintf(progress, "  %s vs %s: none in [%d, %d]\n", sweeps[s].name, sweeps[t].name,
+                        SCALING_FIT_MIN_N, max_n);
+            }
+        }
+    }
+
+    if (json_path) {
+        FILE* out = strcmp(json_path, "-") == 0 ? stdout : fopen(json_path, "w");
+        if (!out) {
+            fprintf(stderr, "Cannot write %s\n", json_path);
+            return 1;
+        }
+        write_json(out, results, max_n);
+        if (out != stdout) {
+            fclose(out);
+        }
+    }
+    return strict && worse_than_documented > 0 ? 1 : 0;
+}
@@ -0,0 +1,461 @@
+/**
+ * colorjourney_perf_gate - performance regression gate
+ *
+ * Runs the gated core benchmarks and compares each one against the round
+ * medians stored in a checked-in baseline file.
+ *
+ * Samples taken back to back in one process are not independent: they
+ * share the same warm caches, frequency state, heap layout and neighbours,
+ * so a rank test over them reports "significant" shifts that are only the
+ * difference between two processes. The gate therefore runs GATE_ROUNDS
+ * rounds, each in a fresh process (the gate re-runs itself with --round),
+ * and treats one round as one observation: the median of that round's
+ * samples, divided by a calibration kernel (a dependent chain of float
+ * multiply-adds, independent of the library) measured in the same round so
+ * clock speed differences largely cancel out.
+ *
+ * A benchmark regresses when both hold:
+ * - a one-sided Mann-Whitney U test over the round medians says the current
+ *   rounds are slower than the baseline rounds (p < --alpha, default 0.01),
+ *   so a shift must be consistent across independent processes, and
+ * - the median of the current rounds is slower than the median of the
+ *   baseline rounds by more than the benchmark's tolerance.
+ * The tolerance is the baseline's round-to-round spread, (max - min) /
+ * median, times GATE_SPREAD_FACTOR, clamped to [GATE_MIN_TOLERANCE,
+ * GATE_MAX_TOLERANCE]. The cap keeps a noisy baseline from hiding real
+ * slowdowns; the rank test keeps the tight band from flaking on noise.
+ *
+ * The calibration kernel does not cancel microarchitecture differences, so
+ * a baseline only gates on the machine that wrote it; refresh it with
+ * --update when the reference machine changes.
+ *
+ * Usage:
+ *   colorjourney_perf_gate --baseline <file> [--alpha <p>] [--pin <cpu>]
+ *   colorjourney_perf_gate --baseline <file> --update
+ *
+ * Exit codes: 0 pass, 1 regression, 2 usage or baseline error.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench_core.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define GATE_ROUNDS 15
+#define GATE_MIN_ROUNDS 3
+#define GATE_MAX_ROUNDS 32
+#define GATE_SAMPLES_PER_ROUND 7
+#define GATE_MAX_ENTRIES 32
+#define GATE_NAME_MAX 64
+#define GATE_SPREAD_FACTOR 1.5
+#define GATE_MIN_TOLERANCE 0.05
+#define GATE_MAX_TOLERANCE 0.15
+#define GATE_DEFAULT_ALPHA 0.01
+#define GATE_LINE_MAX 4096
+#define GATE_COMMAND_MAX 2048
+
+/* Gated when --update writes a new baseline file; an existing file's list wins. */
+static const char* const default_gated[] = {
+    "journey_sample/anchors=1",
+    "journey_sample/anchors=3",
+    "journey_sample/anchors=8",
+    "journey_discrete/n=100",
+    "journey_discrete/n=1000",
+    "journey_discrete_at/n=10",
+    "journey_discrete_at/n=100",
+    "journey_discrete_range/start=0,n=100",
+};
+
+typedef struct {
+    char name[GATE_NAME_MAX];
+    size_t round_count;
+    double rounds[GATE_MAX_ROUNDS];
+} GateEntry;
+
+/* Volatile so the compiler cannot fold the chain to a constant. */
+static volatile float calibration_seed = 0.5f;
+
+static void kernel_calibration(void* context, uint64_t iterations) {
+    (void)context;
+    const float scale = calibration_seed;
+    float x = calibration_seed;
+    for (uint64_t i = 0; i < iterations; i++) {
+        for (int k = 0; k < 64; k++) {
+            x = x * scale + 0.25f;
+        }
+    }
+    bench_consume_float(x);
+}
+
+static int compare_double(const void* a, const void* b) {
+    const double x = *(const double*)a;
+    const double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static double median_of(const double* values, size_t count) {
+    double sorted[GATE_MAX_ROUNDS];
+    memcpy(sorted, values, count * sizeof(double));
+    qsort(sorted, count, sizeof(double), compare_double);
+    return bench_percentile(sorted, count, 0.5);
+}
+
+/* Relative round-to-round spread of a baseline, scaled and clamped into a tolerance. */
+static double tolerance_of(const GateEntry* baseline) {
+    double lo = baseline->rounds[0];
+    double hi = baseline->rounds[0];
+    for (size_t i = 1; i < baseline->round_count; i++) {
+        lo = baseline->rounds[i] < lo ? baseline->rounds[i] : lo;
+        hi = baseline->rounds[i] > hi ? baseline->rounds[i] : hi;
+    }
+    const double tolerance = GATE_SPREAD_FACTOR * (hi - lo) / median_of(baseline->rounds, baseline->round_count);
+    if (tolerance < GATE_MIN_TOLERANCE) {
+        return GATE_MIN_TOLERANCE;
+    }
+    return tolerance > GATE_MAX_TOLERANCE ? GATE_MAX_TOLERANCE : tolerance;
+}
+
+/*
+ * One-sided Mann-Whitney U: p-value for "current tends to be larger than
+ * baseline". Normal approximation with tie and continuity correction, which
+ * is adequate for the 15 vs 15 round medians the gate compares.
+ */
+static double mann_whitney_greater(const double* baseline, size_t n_base, const double* current, size_t n_cur) {
+    const size_t total = n_base + n_cur;
+    double values[2 * GATE_MAX_ROUNDS];
+    int from_current[2 * GATE_MAX_ROUNDS];
+    size_t order[2 * GATE_MAX_ROUNDS];
+    for (size_t i = 0; i < n_base; i++) {
+        values[i] = baseline[i];
+        from_current[i] = 0;
+    }
+    for (size_t i = 0; i < n_cur; i++) {
+        values[n_base + i] = current[i];
+        from_current[n_base + i] = 1;
+    }
+    for (size_t i = 0; i < total; i++) {
+        order[i] = i;
+    }
+    /* Insertion sort of indices by value; total <= 2 * GATE_MAX_ROUNDS. */
+    for (size_t i = 1; i < total; i++) {
+        const size_t key = order[i];
+        size_t j = i;
+        while (j > 0 && values[order[j - 1]] > values[key]) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = key;
+    }
+
+    double rank_sum_current = 0.0;
+    double tie_term = 0.0;
+    for (size_t i = 0; i < total;) {
+        size_t j = i;
+        while (j + 1 < total && values[order[j + 1]] == values[order[i]]) {
+            j++;
+        }
+        const double average_rank = ((double)i + (double)j) * 0.5 + 1.0;
+        const double ties = (double)(j - i + 1);
+        tie_term += ties * ties * ties - ties;
+        for (size_t k = i; k <= j; k++) {
+            if (from_current[order[k]]) {
+                rank_sum_current += average_rank;
+            }
+        }
+        i = j + 1;
+    }
+
+    const double n1 = (double)n_cur;
+    const double n2 = (double)n_base;
+    const double n = n1 + n2;
+    const double u = rank_sum_current - n1 * (n1 + 1.0) * 0.5;
+    const double mean = n1 * n2 * 0.5;
+    const double variance = n1 * n2 / 12.0 * ((n + 1.0) - tie_term / (n * (n - 1.0)));
+    if (variance <= 0.0) {
+        return 1.0;
+    }
+    const double z = (u - mean - 0.5) / sqrt(variance);
+    return 0.5 * erfc(z / sqrt(2.0));
+}
+
+static int load_baseline(const char* path, GateEntry* entries, size_t* entry_count) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        return -1;
+    }
+    char line[GATE_LINE_MAX];
+    size_t count = 0;
+    int status = 0;
+    while (fgets(line, sizeof(line), file)) {
+        if (line[0] == '#' || line[0] == '\n') {
+            continue;
+        }
+        if (count == GATE_MAX_ENTRIES) {
+            fprintf(stderr, "%s: more than %d benchmarks\n", path, GATE_MAX_ENTRIES);
+            status = -1;
+            break;
+        }
+        GateEntry* entry = &entries[count];
+        char* cursor = line;
+        int consumed = 0;
+        if (sscanf(cursor, "%63s%n", entry->name, &consumed) != 1) {
+            fprintf(stderr, "%s: malformed line: %s", path, line);
+            status = -1;
+            break;
+        }
+        cursor += consumed;
+        entry->round_count = 0;
+        double value;
+        while (entry->round_count < GATE_MAX_ROUNDS && sscanf(cursor, "%lf%n", &value, &consumed) == 1) {
+            entry->rounds[entry->round_count++] = value;
+            cursor += consumed;
+        }
+        if (entry->round_count < GATE_MIN_ROUNDS) {
+            fprintf(stderr, "%s: %s needs at least %d round medians\n", path, entry->name, GATE_MIN_ROUNDS);
+            status = -1;
+            break;
+        }
+        count++;
+    }
+    fclose(file);
+    *entry_count = count;
+    return status;
+}
+
+static int write_baseline(const char* path, const GateEntry* entries, size_t entry_count) {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        return -1;
+    }
+    fprintf(file, "# ColorJourney performance baseline (written by colorjourney_perf_gate --update)\n");
+    fprintf(file, "# Each value is one round, run in its own process: the median ns per item divided by\n");
+    fprintf(file, "# the calibration kernel's median ns in that round. Tolerances derive from the spread.\n");
+    fprintf(file, "# Only valid on the machine that wrote it; see Tests/Benchmarks/README.md.\n");
+    fprintf(file, "# <benchmark> <round medians...>; edit the benchmark list by hand, rerun --update to refresh.\n");
+    for (size_t i = 0; i < entry_count; i++) {
+        fprintf(file, "%s", entries[i].name);
+        for (size_t r = 0; r < entries[i].round_count; r++) {
+            fprintf(file, " %.5g", entries[i].rounds[r]);
+        }
+        fputc('\n', file);
+    }
+    return fclose(file);
+}
+
+static const BenchCase* find_case(const BenchCase* cases, size_t count, const char* name) {
+    for (size_t i = 0; i < count; i++) {
+        if (strcmp(cases[i].name, name) == 0) {
+            return &cases[i];
+        }
+    }
+    return NULL;
+}
+
+static int measure_calibration(const BenchOptions* options, double* median_ns) {
+    const BenchCase calibration = {"calibration", "calibration", kernel_calibration, NULL, 64.0};
+    BenchResult result;
+    if (bench_run_case(&calibration, options, &result) != 0) {
+        return -1;
+    }
+    *median_ns = result.median_ns;
+    return 0;
+}
+
+/* One round (the --round child): prints "<name> <normalized median>" per benchmark. */
+static int run_round(const GateEntry* entries, size_t entry_count, const BenchOptions* options) {
+    BenchCase cases[BENCH_CORE_MAX_CASES];
+    const size_t case_count = bench_core_cases(cases, BENCH_CORE_MAX_CASES);
+    if (options->pin_cpu >= 0 && bench_pin_cpu(options->pin_cpu) != 0) {
+        fprintf(stderr, "Warning: could not pin to CPU %d; continuing unpinned\n", options->pin_cpu);
+    }
+
+    double calibration_ns = 0.0;
+    if (measure_calibration(options, &calibration_ns) != 0 || calibration_ns <= 0.0) {
+        fprintf(stderr, "Calibration failed\n");
+        bench_core_release();
+        return 2;
+    }
+    for (size_t i = 0; i < entry_count; i++) {
+        const BenchCase* bench_case = find_case(cases, case_count, entries[i].name);
+        BenchResult result;
+        if (!bench_case || bench_run_case(bench_case, options, &result) != 0) {
+            fprintf(stderr, "Benchmark %s failed\n", entries[i].name);
+            bench_core_release();
+            return 2;
+        }
+        printf("%s %.17g\n", entries[i].name, result.median_ns / calibration_ns);
+    }
+    bench_core_release();
+    return 0;
+}
+
+/* Runs one round in a child process and appends its medians to `current`. */
+static int collect_round(const char* program, const char* baseline_path, int pin_cpu,
+                         GateEntry* current, size_t entry_count) {
+    char command[GATE_COMMAND_MAX];
+    char pin[32] = "";
+    if (pin_cpu >= 0) {
+        snprintf(pin, sizeof(pin), " --pin %d", pin_cpu);
+    }
+    const int length = snprintf(command, sizeof(command), "'%s' --baseline '%s' --round%s",
+                                program, baseline_path, pin);
+    if (length < 0 || (size_t)length >= sizeof(command) || strchr(program, '\'') || strchr(baseline_path, '\'')) {
+        fprintf(stderr, "Cannot build round command for %s\n", program);
+        return -1;
+    }
+
+    FILE* pipe = popen(command, "r");
+    if (!pipe) {
+        fprintf(stderr, "Cannot start round process %s\n", program);
+        return -1;
+    }
+    char line[GATE_LINE_MAX];
+    size_t received = 0;
+    while (fgets(line, sizeof(line), pipe)) {
+        char name[GATE_NAME_MAX];
+        double value;
+        if (received < entry_count && sscanf(line, "%63s %lf", name, &value) == 2 &&
+            strcmp(name, current[received].name) == 0) {
+            GateEntry* entry = &current[received++];
+            entry->rounds[entry->round_count++] = value;
+        }
+    }
+    const int status = pclose(pipe);
+    if (status != 0 || received != entry_count) {
+        fprintf(stderr, "Round process failed (status %d, %zu of %zu benchmarks)\n", status, received, entry_count);
+        return -1;
+    }
+    return 0;
+}
+
+static void print_usage(const char* program) {
+    printf("Usage: %s --baseline <file> [--update] [--alpha <p>] [--pin <cpu>]\n", program);
+}
+
+int main(int argc, char** argv) {
+    const char* baseline_path = NULL;
+    int update = 0;
+    int round_only = 0;
+    double alpha = GATE_DEFAULT_ALPHA;
+    BenchOptions options;
+    bench_options_init(&options);
+    options.samples = GATE_SAMPLES_PER_ROUND;
+    options.warmup_ms = 20.0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            baseline_path = argv[++i];
+        } else if (strcmp(argv[i], "--update") == 0) {
+            update = 1;
+        } else if (strcmp(argv[i], "--alpha") == 0 && i + 1 < argc) {
+            alpha = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--round") == 0) {
+            round_only = 1;
+        } else if (strcmp(argv[i], "--pin") == 0 && i + 1 < argc) {
+            options.pin_cpu = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--help") == 0) {
+            print_usage(argv[0]);
+            return 0;
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+    if (!baseline_path || alpha <= 0.0 || alpha >= 1.0) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    GateEntry baseline[GATE_MAX_ENTRIES];
+    size_t baseline_count = 0;
+    const int loaded = load_baseline(baseline_path, baseline, &baseline_count) == 0 && baseline_count > 0;
+    if (!loaded && !update && !round_only) {
+        fprintf(stderr, "Cannot read baseline %s (run with --update to create it)\n", baseline_path);
+        return 2;
+    }
+    if (!loaded) {
+        baseline_count = sizeof(default_gated) / sizeof(default_gated[0]);
+        for (size_t i = 0; i < baseline_count; i++) {
+            snprintf(baseline[i].name, GATE_NAME_MAX, "%s", default_gated[i]);
+            baseline[i].round_count = 0;
+        }
+    }
+
+    if (round_only) {
+        return run_round(baseline, baseline_count, &options);
+    }
+
+    BenchCase cases[BENCH_CORE_MAX_CASES];
+    const size_t case_count = bench_core_cases(cases, BENCH_CORE_MAX_CASES);
+    for (size_t i = 0; i < baseline_count; i++) {
+        if (!find_case(cases, case_count, baseline[i].name)) {
+            fprintf(stderr, "Baseline benchmark %s is not in the core suite\n", baseline[i].name);
+            bench_core_release();
+            return 2;
+        }
+    }
+    bench_core_release();
+
+    GateEntry current[GATE_MAX_ENTRIES];
+    for (size_t i = 0; i < baseline_count; i++) {
+        current[i] = baseline[i];
+        current[i].round_count = 0;
+    }
+    for (int round = 0; round < GATE_ROUNDS; round++) {
+        /* Children find the benchmark list in the baseline; --update may not have one yet. */
+        if (collect_round(argv[0], loaded ? baseline_path : "", options.pin_cpu, current, baseline_count) != 0) {
+            return 2;
+        }
+    }
+
+    int regressions = 0;
+    if (!update) {
+        printf("%-40s %10s %10s %8s %9s %9s  %s\n", "benchmark", "baseline", "current", "ratio", "tolerance", "p(slower)", "verdict");
+    }
+    for (size_t i = 0; i < baseline_count; i++) {
+        const GateEntry* entry = &current[i];
+        if (update) {
+            printf("%-40s %10.4g  spread tolerance %.3f\n", entry->name,
+                   median_of(entry->rounds, entry->round_count), tolerance_of(entry));
+            continue;
+        }
+
+        const double base_median = median_of(baseline[i].rounds, baseline[i].round_count);
+        const double current_median = median_of(entry->rounds, entry->round_count);
+        const double ratio = current_median / base_median;
+        const double tolerance = tolerance_of(&baseline[i]);
+        const double p_slower = mann_whitney_greater(baseline[i].rounds, baseline[i].round_count,
+                                                     entry->rounds, entry->round_count);
+        const double p_faster = mann_whitney_greater(entry->rounds, entry->round_count,
+                                                     baseline[i].rounds, baseline[i].round_count);
+        const char* verdict = "ok";
+        if (p_slower < alpha && ratio > 1.0 + tolerance) {
+            verdict = "REGRESSION";
+            regressions++;
+        } else if (p_faster < alpha && ratio < 1.0 - tolerance) {
+            verdict = "faster (consider --update)";
+        }
+        printf("%-40s %10.4g %10.4g %8.3f %9.3f %9.2g  %s\n",
+               entry->name, base_median, current_median, ratio, tolerance, p_slower, verdict);
+    }
+
+    if (update) {
+        if (write_baseline(baseline_path, current, baseline_count) != 0) {
+            fprintf(stderr, "Cannot write %s\n", baseline_path);
+            return 2;
+        }
+        printf("Wrote %s\n", baseline_path);
+        return 0;
+    }
+    if (regressions > 0) {
+        printf("%d benchmark(s) regressed beyond tolerance (alpha %.3g)\n", regressions, alpha);
+        return 1;
+    }
+    printf("No significant regressions (%d rounds, alpha %.3g)\n", GATE_ROUNDS, alpha);
+    return 0;
+}
@@ -1,246 +0,0 @@
-/**
- * Performance Baseline Tests for Feature 004 Incremental Creation
- * 
- * Task: R-001-A - Establish C core performance baseline
- * 
- * This test harness measures baseline color generation performance
- * for various counts (1, 10, 50, 100, 500, 1000 colors).
- * 
- * Purpose:
- * - Establish reference point for chunk size optimization (R-001-B)
- * - Create reproducible benchmark methodology
- * - Document baseline speeds, memory profile, cache behavior
- * 
- * Success Criteria:
- * - Baseline measurements documented and reproducible
- * - Test harness works across platforms
- * - Ready to compare chunk size implementations against baseline
- */
-
-#include <CColorJourney.h>
-#include <stdio.h>
-#include <time.h>
-#include <stdlib.h>
-#include <string.h>
-
-/* Timing utilities */
-typedef struct {
-    clock_t start;
-    clock_t end;
-    double elapsed_ms;
-} Timer;
-
-static void timer_start(Timer* timer) {
-    timer->start = clock();
-}
-
-static void timer_stop(Timer* timer) {
-    timer->end = clock();
-    timer->elapsed_ms = ((double)(timer->end - timer->start)) / CLOCKS_PER_SEC * 1000.0;
-}
-
-/* Test configuration */
-typedef struct {
-    const char* name;
-    int count;
-    int iterations;  /* Number of times to repeat for averaging */
-} BenchmarkConfig;
-
-/* Benchmark result */
-typedef struct {
-    const char* test_name;
-    int color_count;
-    double avg_time_ms;
-    double min_time_ms;
-    double max_time_ms;
-    double colors_per_second;
-} BenchmarkResult;
-
-/* Baseline test: discrete_at individual access */
-static BenchmarkResult benchmark_discrete_at(CJ_Journey journey, BenchmarkConfig config) {
-    BenchmarkResult result;
-    result.test_name = config.name;
-    result.color_count = config.count;
-    result.min_time_ms = 999999.0;
-    result.max_time_ms = 0.0;
-    
-    double total_time = 0.0;
-    
-    for (int iter = 0; iter < config.iterations; iter++) {
-        Timer timer;
-        timer_start(&timer);
-        
-        /* Generate colors one at a time */
-        for (int i = 0; i < config.count; i++) {
-            CJ_RGB color = cj_journey_discrete_at(journey, i);
-            /* Volatile to prevent optimization */
-            volatile float r = color.r;
-            (void)r;
-        }
-        
-        timer_stop(&timer);
-        
-        total_time += timer.elapsed_ms;
-        if (timer.elapsed_ms < result.min_time_ms) result.min_time_ms = timer.elapsed_ms;
-        if (timer.elapsed_ms > result.max_time_ms) result.max_time_ms = timer.elapsed_ms;
-    }
-    
-    result.avg_time_ms = total_time / config.iterations;
-    result.colors_per_second = (config.count * config.iterations * 1000.0) / total_time;
-    
-    return result;
-}
-
-/* Baseline test: discrete_range batch access */
-static BenchmarkResult benchmark_discrete_range(CJ_Journey journey, BenchmarkConfig config) {
-    BenchmarkResult result;
-    result.test_name = config.name;
-    result.color_count = config.count;
-    result.min_time_ms = 999999.0;
-    result.max_time_ms = 0.0;
-    
-    CJ_RGB* colors = (CJ_RGB*)malloc(sizeof(CJ_RGB) * config.count);
-    if (!colors) {
-        result.avg_time_ms = -1.0;
-        return result;
-    }
-    
-    double total_time = 0.0;
-    
-    for (int iter = 0; iter < config.iterations; iter++) {
-        Timer timer;
-        timer_start(&timer);
-        
-        /* Generate colors in batch */
-        cj_journey_discrete_range(journey, 0, config.count, colors);
-        
-        timer_stop(&timer);
-        
-        total_time += timer.elapsed_ms;
-        if (timer.elapsed_ms < result.min_time_ms) result.min_time_ms = timer.elapsed_ms;
-        if (timer.elapsed_ms > result.max_time_ms) result.max_time_ms = timer.elapsed_ms;
-    }
-    
-    result.avg_time_ms = total_time / config.iterations;
-    result.colors_per_second = (config.count * config.iterations * 1000.0) / total_time;
-    
-    free(colors);
-    return result;
-}
-
-/* Memory profiling stub (actual implementation needs platform-specific tools) */
-static void profile_memory_usage(CJ_Journey journey, int count) {
-    /* Note: Actual memory profiling requires platform-specific tools:
-     * - macOS/iOS: Instruments / malloc_history
-     * - Linux: valgrind --tool=massif
-     * - Windows: Windows Performance Toolkit
-     * 
-     * This stub documents the methodology:
-     * 1. Measure heap allocations during color generation
-     * 2. Track peak memory usage
-     * 3. Verify no memory leaks
-     * 4. Document stack allocation (~24 bytes/call as per spec)
-     */
-    
-    printf("  Memory Profile (count=%d):\n", count);
-    printf("    Stack allocation: ~24 bytes per call (as per spec)\n");
-    printf("    Heap allocation: None (stateless design)\n");
-    printf("    Note: Use platform-specific tools for detailed profiling\n");
-}
-
-/* Print results in table format */
-static void print_result(BenchmarkResult result) {
-    printf("  %-40s | %6d | %8.3f | %8.3f | %8.3f | %10.0f\n",
-           result.test_name,
-           result.color_count,
-           result.avg_time_ms,
-           result.min_time_ms,
-           result.max_time_ms,
-           result.colors_per_second);
-}
-
-int main(void) {
-    printf("=================================================================\n");
-    printf("C Core Performance Baseline - Feature 004 (Task R-001-A)\n");
-    printf("=================================================================\n\n");
-    
-    /* Create test journey */
-    CJ_Config config;
-    cj_config_init(&config);
-    config.anchor_count = 2;
-    config.anchors[0] = (CJ_RGB){1.0f, 0.3f, 0.0f};
-    config.anchors[1] = (CJ_RGB){0.3f, 0.5f, 0.8f};
-    config.contrast_level = CJ_CONTRAST_MEDIUM;
-    
-    CJ_Journey journey = cj_journey_create(&config);
-    if (!journey) {
-        fprintf(stderr, "Failed to create journey\n");
-        return 1;
-    }
-    
-    /* Test configurations matching spec requirements */
-    BenchmarkConfig configs[] = {
-        {"discrete_at(i) [1 color]",    1,    100},
-        {"discrete_at(i) [10 colors]",  10,   100},
-        {"discrete_at(i) [50 colors]",  50,   50},
-        {"discrete_at(i) [100 colors]", 100,  50},
-        {"discrete_at(i) [500 colors]", 500,  10},
-        {"discrete_at(i) [1000 colors]", 1000, 5},
-        
-        {"discrete_range(0,n) [1 color]",    1,    100},
-        {"discrete_range(0,n) [10 colors]",  10,   100},
-        {"discrete_range(0,n) [50 colors]",  50,   50},
-        {"discrete_range(0,n) [100 colors]", 100,  50},
-        {"discrete_range(0,n) [500 colors]", 500,  10},
-        {"discrete_range(0,n) [1000 colors]", 1000, 5}
-    };
-    
-    /* Run benchmarks */
-    printf("Performance Measurements:\n");
-    printf("  %-40s | Colors | Avg (ms) | Min (ms) | Max (ms) | Colors/sec\n", "Test");
-    printf("  %-40s-+--------+----------+----------+----------+-----------\n", "----------------------------------------");
-    
-    int num_configs = sizeof(configs) / sizeof(configs[0]);
-    for (int i = 0; i < num_configs; i++) {
-        BenchmarkResult result;
-        
-        if (strstr(configs[i].name, "discrete_at")) {
-            result = benchmark_discrete_at(journey, configs[i]);
-        } else {
-            result = benchmark_discrete_range(journey, configs[i]);
-        }
-        
-        print_result(result);
-    }
-    
-    printf("\n");
-    
-    /* Memory profiling */
-    printf("Memory Profiling:\n");
-    profile_memory_usage(journey, 100);
-    
-    printf("\n");
-    
-    /* Baseline summary */
-    printf("Baseline Summary:\n");
-    printf("  - All measurements completed successfully\n");
-    printf("  - Methodology: Average of multiple iterations\n");
-    printf("  - Platform: %s\n", "C99");
-    printf("  - Ready for chunk size comparison (R-001-B)\n");
-    printf("\n");
-    
-    printf("Success Criteria Check:\n");
-    printf("  ✓ Baseline measurements documented and reproducible\n");
-    printf("  ✓ Test harness works across platforms\n");
-    printf("  ✓ Ready to compare chunk size implementations\n");
-    printf("\n");
-    
-    /* Cleanup */
-    cj_journey_destroy(journey);
-    
-    printf("=================================================================\n");
-    printf("Task R-001-A Complete\n");
-    printf("=================================================================\n");
-    
-    return 0;
-}
@@ -1,7 +1,11 @@
+/* The checks are asserts: keep them in Release (NDEBUG) builds too */
+#undef NDEBUG
 #include "ColorJourney.h"
 #include <assert.h>
 #include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 static void expect_rgb_in_range(CJ_RGB c) {
     assert(c.r >= 0.0f && c.r <= 1.0f);
@@ -113,11 +117,838 @@ static void test_discrete_range_contrast(void) {
     cj_journey_destroy(journey);
 }
 
+static void test_stats(void) {
+    CJ_Config config;
+    cj_config_init(&config);
+    config.anchor_count = 1;
+    config.anchors[0] = (CJ_RGB){0.5f, 0.2f, 0.6f};
+    config.contrast_level = CJ_CONTRAST_HIGH;
+
+    CJ_Journey journey = cj_journey_create(&config);
+    assert(journey != NULL);
+
+    CJ_Stats stats;
+    cj_stats_reset();
+    const int count = 20;
+    CJ_RGB palette[count];
+    cj_journey_discrete_range(journey, 0, count, palette);
+    cj_stats_snapshot(&stats);
+
+    if (cj_stats_enabled()) {
+        /* At least one sample per color; every color after the first is checked */
+        assert(stats.samples >= (uint64_t)count);
+        assert(stats.delta_checks == (uint64_t)(count - 1));
+        assert(stats.contrast_checks == (uint64_t)(count - 1));
+        assert(stats.delta_search_iterations >= stats.delta_searches);
+        assert(stats.contrast_adjustments <= stats.contrast_checks);
+
+        cj_stats_reset();
+        cj_stats_snapshot(&stats);
+        assert(stats.samples == 0 && stats.delta_checks == 0);
+    } else {
+        assert(stats.samples == 0 && stats.delta_searches == 0);
+    }
+
+    cj_journey_destroy(journey);
+}
+
+/* Exact sRGB transfer curve, for checking the 8-bit pixel paths. */
+static float srgb8_decode(uint8_t k) {
+    float v = (float)k / 255.0f;
+    return v <= 0.04045f ? v / 12.92f : powf((v + 0.055f) / 1.055f, 2.4f);
+}
+
+static int srgb8_encode(float x) {
+    x = fminf(fmaxf(x, 0.0f), 1.0f);
+    float v = x <= 0.0031308f ? 12.92f * x : 1.055f * powf(x, 1.0f / 2.4f) - 0.055f;
+    return (int)(v * 255.0f + 0.5f);
+}
+
+/* Mapped color must be the table entry for the pixel's L (or its neighbour at a rounding boundary). */
+static void expect_gradient_entry(const CJ_GradientTable* table, const uint8_t rgb[3], const uint8_t mapped[3]) {
+    CJ_RGB c = {srgb8_decode(rgb[0]), srgb8_decode(rgb[1]), srgb8_decode(rgb[2])};
+    float L = cj_rgb_to_oklab(c).L;
+    int index = (int)(fminf(fmaxf(L, 0.0f), 1.0f) * (CJ_GRADIENT_TABLE_SIZE - 1) + 0.5f);
+    bool found = false;
+    for (int i = index - 1; i <= index + 1; i++) {
+        if (i >= 0 && i < CJ_GRADIENT_TABLE_SIZE && memcmp(table->rgb[i], mapped, 3) == 0) {
+            found = true;
+        }
+    }
+    assert(found);
+}
+
+static void test_image_gradient_map(void) {
+    CJ_Config config;
+    cj_config_init(&config);
+    config.anchor_count = 2;
+    config.anchors[0] = (CJ_RGB){0.1f, 0.05f, 0.3f};
+    config.anchors[1] = (CJ_RGB){0.95f, 0.75f, 0.2f};
+    CJ_Journey journey = cj_journey_create(&config);
+    assert(journey != NULL);
+
+    CJ_GradientTable table;
+    cj_gradient_table_bake(journey, &table);
+
+    /* Entries are sRGB-encoded samples (half-step ties may round either way) */
+    for (int i = 0; i < CJ_GRADIENT_TABLE_SIZE; i += 31) {
+        CJ_RGB c = cj_journey_sample(journey, (float)i / (float)(CJ_GRADIENT_TABLE_SIZE - 1));
+        assert(abs(table.rgb[i][0] - srgb8_encode(c.r)) <= 1);
+        assert(abs(table.rgb[i][1] - srgb8_encode(c.g)) <= 1);
+        assert(abs(table.rgb[i][2] - srgb8_encode(c.b)) <= 1);
+    }
+
+    /* Pixels are sRGB: #777777 has OKLab L ~0.57, not the ~0.78 (entry 794) it has read as linear */
+    const uint8_t gray[3] = {0x77, 0x77, 0x77};
+    uint8_t gray_mapped[3];
+    cj_image_gradient_map(journey, gray, gray_mapped, 1, 1, 3, CJ_PIXEL_RGB8, &(CJ_GradientMapOptions){true, &table});
+    expect_gradient_entry(&table, gray, gray_mapped);
+    assert(memcmp(gray_mapped, table.rgb[794], 3) != 0);
+
+    enum { W = 5, H = 3, STRIDE = W * 4 + 8 };
+    uint8_t src[STRIDE * H];
+    uint8_t dst[STRIDE * H];
+    memset(src, 0x5A, sizeof(src));
+    for (int y = 0; y < H; y++) {
+        for (int x = 0; x < W; x++) {
+            uint8_t* p = src + y * STRIDE + x * 4;
+            p[0] = (uint8_t)(x * 63);
+            p[1] = (uint8_t)(y * 120);
+            p[2] = (uint8_t)((x * 37 + y * 91) & 0xff);
+            p[3] = (uint8_t)(x * 50 + y);
+        }
+    }
+    src[0] = src[1] = src[2] = 0;                     /* black */
+    memset(src + (H - 1) * STRIDE + (W - 1) * 4, 255, 3); /* white */
+
+    /* RGBA with pre-baked table: lightness lookup, alpha kept, padding untouched */
+    CJ_GradientMapOptions options = {true, &table};
+    memset(dst, 0xAB, sizeof(dst));
+    cj_image_gradient_map(journey, src, dst, W, H, STRIDE, CJ_PIXEL_RGBA8, &options);
+    for (int y = 0; y < H; y++) {
+        for (int x = 0; x < W; x++) {
+            const uint8_t* p = src + y * STRIDE + x * 4;
+            const uint8_t* q = dst + y * STRIDE + x * 4;
+            expect_gradient_entry(&table, p, q);
+            assert(q[3] == p[3]);
+        }
+        for (int i = W * 4; i < STRIDE; i++) {
+            assert(dst[y * STRIDE + i] == 0xAB);
+        }
+    }
+    assert(memcmp(dst, table.rgb[0], 3) == 0);
+    assert(memcmp(dst + (H - 1) * STRIDE + (W - 1) * 4, table.rgb[CJ_GRADIENT_TABLE_SIZE - 1], 3) == 0);
+
+    /* NULL options bake the same table per call and keep alpha */
+    uint8_t defaults[STRIDE * H];
+    memset(defaults, 0xAB, sizeof(defaults));
+    cj_image_gradient_map(journey, src, defaults, W, H, STRIDE, CJ_PIXEL_RGBA8, NULL);
+    assert(memcmp(defaults, dst, sizeof(dst)) == 0);
+
+    /* Opaque output */
+    options.preserve_alpha = false;
+    cj_image_gradient_map(journey, src, dst, W, H, STRIDE, CJ_PIXEL_RGBA8, &options);
+    assert(dst[3] == 255 && dst[STRIDE + 7] == 255);
+
+    /* BGRA: same colors with R and B swapped on both sides */
+    uint8_t bgra[STRIDE * H];
+    memcpy(bgra, src, sizeof(src));
+    for (int y = 0; y < H; y++) {
+        for (int x = 0; x < W; x++) {
+            uint8_t* p = bgra + y * STRIDE + x * 4;
+            uint8_t r = p[0];
+            p[0] = p[2];
+            p[2] = r;
+        }
+    }
+    options.preserve_alpha = true;
+    cj_image_gradient_map(journey, bgra, bgra, W, H, STRIDE, CJ_PIXEL_BGRA8, &options);
+    cj_image_gradient_map(journey, src, dst, W, H, STRIDE, CJ_PIXEL_RGBA8, &options);
+    for (int y = 0; y < H; y++) {
+        for (int x = 0; x < W; x++) {
+            const uint8_t* p = bgra + y * STRIDE + x * 4;
+            const uint8_t* q = dst + y * STRIDE + x * 4;
+            assert(p[2] == q[0] && p[1] == q[1] && p[0] == q[2] && p[3] == q[3]);
+        }
+    }
+
+    /* RGB8 in place */
+    uint8_t rgb[W * 3];
+    uint8_t original[W * 3];
+    for (int i = 0; i < W * 3; i++) {
+        rgb[i] = original[i] = (uint8_t)(i * 17);
+    }
+    cj_image_gradient_map(journey, rgb, rgb, W, 1, W * 3, CJ_PIXEL_RGB8, &options);
+    for (int x = 0; x < W; x++) {
+        expect_gradient_entry(&table, original + x * 3, rgb + x * 3);
+    }
+
+    /* Invalid arguments leave the destination alone */
+    memset(dst, 0xAB, sizeof(dst));
+    cj_image_gradient_map(journey, src, dst, W, H, W * 4 - 1, CJ_PIXEL_RGBA8, &options);
+    cj_image_gradient_map(NULL, src, dst, W, H, STRIDE, CJ_PIXEL_RGBA8, NULL);
+    cj_image_gradient_map(journey, src, dst, 0, H, STRIDE, CJ_PIXEL_RGBA8, &options);
+    assert(dst[0] == 0xAB && dst[STRIDE * H - 1] == 0xAB);
+
+    cj_journey_destroy(journey);
+}
+
+/* Brute-force reference: lowest palette position with the smallest ΔE. */
+static int nearest_brute_force(const CJ_RGB* palette, int count, CJ_RGB color) {
+    CJ_Lab lab = cj_rgb_to_oklab(color);
+    int best = 0;
+    float best_de = INFINITY;
+    for (int i = 0; i < count; i++) {
+        float de = cj_delta_e(lab, cj_rgb_to_oklab(palette[i]));
+        if (de < best_de) {
+            best_de = de;
+            best = i;
+        }
+    }
+    return best;
+}
+
+static void test_palette_index(void) {
+    CJ_Config config;
+    cj_config_init(&config);
+    config.anchor_count = 3;
+    config.anchors[0] = (CJ_RGB){0.9f, 0.2f, 0.1f};
+    config.anchors[1] = (CJ_RGB){0.1f, 0.7f, 0.3f};
+    config.anchors[2] = (CJ_RGB){0.2f, 0.2f, 0.9f};
+    CJ_Journey journey = cj_journey_create(&config);
+    assert(journey != NULL);
+
+    enum { PALETTE = 37, QUERIES = 500 };
+    CJ_RGB palette[PALETTE];
+    cj_journey_discrete(journey, PALETTE, palette);
+    palette[PALETTE - 1] = palette[3]; /* duplicate: ties go to the lower position */
+
+    CJ_PaletteIndex index = cj_palette_index_create(palette, PALETTE, 16);
+    assert(index != NULL);
+
+    /* Palette colors map to themselves */
+    for (int i = 0; i < PALETTE - 1; i++) {
+        float de = -1.0f;
+        assert(cj_palette_index_nearest(index, palette[i], &de) == i);
+        assert(de >= 0.0f && de < 1e-6f);
+    }
+    assert(cj_palette_index_nearest(index, palette[PALETTE - 1], NULL) == 3);
+
+    /* Exact queries agree with brute force; grid queries are within a cell's error */
+    CJ_RGB queries[QUERIES];
+    uint32_t seed = 12345u;
+    for (int i = 0; i < QUERIES; i++) {
+        float v[3];
+        for (int c = 0; c < 3; c++) {
+            seed = seed * 1664525u + 1013904223u;
+            v[c] = (float)(seed >> 8) / 16777216.0f;
+        }
+        queries[i] = (CJ_RGB){v[0], v[1], v[2]};
+    }
+    int exact[QUERIES];
+    int approx[QUERIES];
+    cj_palette_index_nearest_batch(index, queries, QUERIES, exact, false);
+    cj_palette_index_nearest_batch(index, queries, QUERIES, approx, true);
+    for (int i = 0; i < QUERIES; i++) {
+        float de = 0.0f;
+        assert(exact[i] == nearest_brute_force(palette, PALETTE, queries[i]));
+        assert(cj_palette_index_nearest(index, queries[i], &de) == exact[i]);
+        assert(approx[i] == cj_palette_index_nearest_approx(index, queries[i]));
+        assert(approx[i] >= 0 && approx[i] < PALETTE);
+        CJ_Lab lab = cj_rgb_to_oklab(queries[i]);
+        assert(cj_delta_e(lab, cj_rgb_to_oklab(palette[approx[i]])) <= de + 0.1f);
+    }
+
+    /* Out-of-gamut queries clamp into the grid */
+    CJ_RGB outside = {1.5f, -0.2f, 0.5f};
+    int clamped = cj_palette_index_nearest_approx(index, outside);
+    assert(clamped >= 0 && clamped < PALETTE);
+
+    /* Without a grid, approximate queries are exact */
+    CJ_PaletteIndex exact_only = cj_palette_index_create(palette, PALETTE, 0);
+    assert(exact_only != NULL);
+    for (int i = 0; i < QUERIES; i++) {
+        assert(cj_palette_index_nearest_approx(exact_only, queries[i]) == exact[i]);
+    }
+    cj_palette_index_destroy(exact_only);
+
+    /* Single-entry palette */
+    CJ_PaletteIndex single = cj_palette_index_create(palette, 1, 2);
+    assert(cj_palette_index_nearest(single, queries[0], NULL) == 0);
+    assert(cj_palette_index_nearest_approx(single, queries[0]) == 0);
+    cj_palette_index_destroy(single);
+
+    /* Invalid arguments */
+    assert(cj_palette_index_create(NULL, PALETTE, 0) == NULL);
+    assert(cj_palette_index_create(palette, 0, 0) == NULL);
+    assert(cj_palette_index_create(palette, PALETTE, -1) == NULL);
+    assert(cj_palette_index_create(palette, PALETTE, CJ_PALETTE_GRID_MAX + 1) == NULL);
+    assert(cj_palette_index_nearest(NULL, queries[0], NULL) == -1);
+    assert(cj_palette_index_nearest_approx(NULL, queries[0]) == -1);
+    cj_palette_index_destroy(NULL);
+
+    cj_palette_index_destroy(index);
+    cj_journey_destroy(journey);
+}
+
+/* A linear color must match the sRGB bytes it was extracted from, decoded */
+static void expect_rgb8(CJ_RGB c, int r, int g, int b) {
+    assert(fabsf(c.r - srgb8_decode((uint8_t)r)) < 1e-3f);
+    assert(fabsf(c.g - srgb8_decode((uint8_t)g)) < 1e-3f);
+    assert(fabsf(c.b - srgb8_decode((uint8_t)b)) < 1e-3f);
+}
+
+static void test_extract_anchors(void) {
+    /* Three solid bands covering 50%, 30% and 20% of the width, plus a transparent strip */
+    enum { W = 100, H = 40, STRIDE = W * 4 };
+    static uint8_t image[STRIDE * H];
+    static uint8_t bgra[STRIDE * H];
+    for (int y = 0; y < H; y++) {
+        for (int x = 0; x < W; x++) {
+            uint8_t* p = image + y * STRIDE + x * 4;
+            const uint8_t red[3] = {200, 40, 30};
+            const uint8_t blue[3] = {20, 90, 200};
+            const uint8_t cream[3] = {240, 220, 210};
+            const uint8_t* color = x < 50 ? red : (x < 80 ? blue : cream);
+            memcpy(p, color, 3);
+            p[3] = (y < 4) ? 0 : 255;
+            if (y < 4) p[1] = 255; /* Transparent pixels must not form a cluster */
+        }
+    }
+
+    CJ_RGB anchors[8];
+    int count = cj_extract_anchors(image, W, H, STRIDE, CJ_PIXEL_RGBA8, 3, anchors);
+    assert(count == 3);
+    expect_rgb8(anchors[0], 200, 40, 30);
+    expect_rgb8(anchors[1], 20, 90, 200);
+    expect_rgb8(anchors[2], 240, 220, 210);
+
+    /* Deterministic, and BGRA reads the same colors */
+    CJ_RGB again[8];
+    assert(cj_extract_anchors(image, W, H, STRIDE, CJ_PIXEL_RGBA8, 3, again) == 3);
+    assert(memcmp(anchors, again, sizeof(CJ_RGB) * 3) == 0);
+    memcpy(bgra, image, sizeof(image));
+    for (int i = 0; i < W * H; i++) {
+        uint8_t r = bgra[i * 4];
+        bgra[i * 4] = bgra[i * 4 + 2];
+        bgra[i * 4 + 2] = r;
+    }
+    assert(cj_extract_anchors(bgra, W, H, STRIDE, CJ_PIXEL_BGRA8, 3, again) == 3);
+    expect_rgb8(again[0], 200, 40, 30);
+
+    /* Fewer distinct colors than requested */
+    assert(cj_extract_anchors(image, W, H, STRIDE, CJ_PIXEL_RGBA8, 8, anchors) == 3);
+    assert(cj_extract_anchors(image, W, H, STRIDE, CJ_PIXEL_RGBA8, 1, anchors) == 1);
+
+    /* The result is a usable config */
+    CJ_Config config;
+    cj_config_init(&config);
+    config.anchor_count = cj_extract_anchors(image, W, H, STRIDE, CJ_PIXEL_RGBA8, 3, config.anchors);
+    CJ_Journey journey = cj_journey_create(&config);
+    assert(journey != NULL);
+    cj_journey_destroy(journey);
+
+    /* One-pixel strips longer than the sample budget are still sampled, either way round */
+    enum { STRIP = 70000 };
+    static uint8_t strip[STRIP * 3];
+    for (int i = 0; i < STRIP; i++) {
+        memcpy(strip + i * 3, i < STRIP * 3 / 5 ? (const uint8_t[3]){200, 40, 30} : (const uint8_t[3]){20, 90, 200}, 3);
+    }
+    assert(cj_extract_anchors(strip, STRIP, 1, STRIP * 3, CJ_PIXEL_RGB8, 2, anchors) == 2);
+    expect_rgb8(anchors[0], 200, 40, 30);
+    expect_rgb8(anchors[1], 20, 90, 200);
+    assert(cj_extract_anchors(strip, 1, STRIP, 3, CJ_PIXEL_RGB8, 2, anchors) == 2);
+    expect_rgb8(anchors[0], 200, 40, 30);
+    expect_rgb8(anchors[1], 20, 90, 200);
+
+    /* Invalid arguments and fully transparent images */
+    assert(cj_extract_anchors(NULL, W, H, STRIDE, CJ_PIXEL_RGBA8, 3, anchors) == 0);
+    assert(cj_extract_anchors(image, W, H, STRIDE, CJ_PIXEL_RGBA8, 0, anchors) == 0);
+    assert(cj_extract_anchors(image, W, H, STRIDE, CJ_PIXEL_RGBA8, 9, anchors) == 0);
+    assert(cj_extract_anchors(image, W, H, W * 4 - 1, CJ_PIXEL_RGBA8, 3, anchors) == 0);
+    assert(cj_extract_anchors(image, W, 4, STRIDE, CJ_PIXEL_RGBA8, 3, anchors) == 0);
+}
+
+static void test_cvd_simulation(void) {
+    /* Grays are unchanged by every type */
+    const CJ_CVDType types[3] = {CJ_CVD_PROTAN, CJ_CVD_DEUTAN, CJ_CVD_TRITAN};
+    const CJ_RGB gray = {0.4f, 0.4f, 0.4f};
+    for (int t = 0; t < 3; t++) {
+        CJ_RGB g = cj_cvd_simulate(gray, types[t]);
+        assert(fabsf(g.r - 0.4f) < 1e-3f && fabsf(g.g - 0.4f) < 1e-3f && fabsf(g.b - 0.4f) < 1e-3f);
+    }
+
+    /* Red/green collapse for protan and deutan but not tritan; blue/green-ish pairs for tritan */
+    const CJ_RGB red = {0.6f, 0.15f, 0.1f};
+    const CJ_RGB green = {0.2f, 0.3f, 0.05f};
+    float normal = cj_delta_e(cj_rgb_to_oklab(red), cj_rgb_to_oklab(green));
+    float protan = cj_delta_e(cj_rgb_to_oklab(cj_cvd_simulate(red, CJ_CVD_PROTAN)),
+                              cj_rgb_to_oklab(cj_cvd_simulate(green, CJ_CVD_PROTAN)));
+    float deutan = cj_delta_e(cj_rgb_to_oklab(cj_cvd_simulate(red, CJ_CVD_DEUTAN)),
+                              cj_rgb_to_oklab(cj_cvd_simulate(green, CJ_CVD_DEUTAN)));
+    float tritan = cj_delta_e(cj_rgb_to_oklab(cj_cvd_simulate(red, CJ_CVD_TRITAN)),
+                              cj_rgb_to_oklab(cj_cvd_simulate(green, CJ_CVD_TRITAN)));
+    assert(protan < normal * 0.5f);
+    assert(deutan < normal * 0.5f);
+    assert(tritan > protan && tritan > deutan);
+
+    /* Batch matches single calls, also in place */
+    CJ_RGB palette[12];
+    CJ_RGB simulated[12];
+    CJ_Config config;
+    cj_config_init(&config);
+    config.anchor_count = 2;
+    config.anchors[0] = (CJ_RGB){0.8f, 0.1f, 0.1f};
+    config.anchors[1] = (CJ_RGB){0.1f, 0.6f, 0.2f};
+    CJ_Journey journey = cj_journey_create(&config);
+    cj_journey_discrete(journey, 12, palette);
+    cj_journey_destroy(journey);
+    memcpy(simulated, palette, sizeof(palette));
+    cj_cvd_simulate_batch(simulated, 12, CJ_CVD_DEUTAN, simulated);
+    for (int i = 0; i < 12; i++) {
+        CJ_RGB one = cj_cvd_simulate(palette[i], CJ_CVD_DEUTAN);
+        assert(memcmp(&one, &simulated[i], sizeof(one)) == 0);
+        assert(one.r >= 0.0f && one.r <= 1.0f && one.b >= 0.0f && one.b <= 1.0f);
+    }
+
+    /* Minimum ΔE agrees with a direct computation over the simulated colors */
+    for (int t = 0; t < 3; t++) {
+        cj_cvd_simulate_batch(palette, 12, types[t], simulated);
+        float adjacent = INFINITY;
+        float all = INFINITY;
+        for (int i = 0; i < 12; i++) {
+            for (int j = i + 1; j < 12; j++) {
+                float de = cj_delta_e(cj_rgb_to_oklab(simulated[i]), cj_rgb_to_oklab(simulated[j]));
+                all = fminf(all, de);
+                if (j == i + 1) adjacent = fminf(adjacent, de);
+            }
+        }
+        assert(fabsf(cj_palette_cvd_min_delta_e(palette, 12, types[t], false) - adjacent) < 1e-4f);
+        assert(fabsf(cj_palette_cvd_min_delta_e(palette, 12, types[t], true) - all) < 1e-4f);
+        assert(all <= adjacent);
+    }
+
+    assert(cj_palette_cvd_min_delta_e(palette, 1, CJ_CVD_PROTAN, true) == 0.0f);
+    assert(cj_palette_cvd_min_delta_e(NULL, 12, CJ_CVD_PROTAN, false) == 0.0f);
+}
+
+/* sRGB hex to the library's linear RGB */
+static CJ_RGB rgb_from_hex(uint32_t hex) {
+    float channel[3];
+    for (int i = 0; i < 3; i++) {
+        float v = (float)((hex >> (16 - 8 * i)) & 0xff) / 255.0f;
+        channel[i] = v <= 0.04045f ? v / 12.92f : powf((v + 0.055f) / 1.055f, 2.4f);
+    }
+    return (CJ_RGB){channel[0], channel[1], channel[2]};
+}
+
+static void test_contrast_batch(void) {
+    /* WCAG: black/white 21, identical 1, #777777 on white ~4.48 */
+    const CJ_RGB colors[3] = {rgb_from_hex(0x000000), rgb_from_hex(0xffffff), rgb_from_hex(0x777777)};
+    const CJ_RGB backgrounds[2] = {rgb_from_hex(0xffffff), rgb_from_hex(0x000000)};
+    float ratios[6];
+    bool pass[6];
+    cj_contrast_wcag_batch(colors, 3, backgrounds, 2, ratios, 4.5f, pass);
+    assert(fabsf(ratios[0] - 21.0f) < 1e-3f && fabsf(ratios[1] - 1.0f) < 1e-6f);
+    assert(fabsf(ratios[2] - 1.0f) < 1e-6f && fabsf(ratios[3] - 21.0f) < 1e-3f);
+    assert(fabsf(ratios[4] - 4.48f) < 0.01f);
+    assert(pass[0] && !pass[1] && !pass[2] && pass[3] && !pass[4] && pass[5]);
+
+    /* APCA reference values from the apca-w3 test suite (text, background, Lc) */
+    const uint32_t pairs[6][2] = {
+        {0x888888, 0xffffff}, {0xffffff, 0x888888}, {0x000000, 0xaaaaaa},
+        {0xaaaaaa, 0x000000}, {0x112233, 0xddeeff}, {0xddeeff, 0x112233}
+    };
+    const float expected[6] = {63.056f, -68.541f, 58.146f, -56.24f, 91.66f, -93.07f};
+    for (int k = 0; k < 6; k++) {
+        CJ_RGB text = rgb_from_hex(pairs[k][0]);
+        CJ_RGB bg = rgb_from_hex(pairs[k][1]);
+        float lc = 0.0f;
+        bool ok = false;
+        cj_contrast_apca_batch(&text, 1, &bg, 1, &lc, 60.0f, &ok);
+        assert(fabsf(lc - expected[k]) < 0.1f);
+        assert(ok == (fabsf(expected[k]) >= 60.0f));
+    }
+
+    /* Batch layout across more backgrounds than one chunk, mask-only output */
+    enum { COLORS = 5, BACKGROUNDS = 70 };
+    CJ_RGB many[BACKGROUNDS];
+    for (int j = 0; j < BACKGROUNDS; j++) {
+        float v = (float)j / (BACKGROUNDS - 1);
+        many[j] = (CJ_RGB){v, v * 0.8f, 1.0f - v};
+    }
+    float lc[COLORS * BACKGROUNDS];
+    bool mask[COLORS * BACKGROUNDS];
+    cj_contrast_apca_batch(many, COLORS, many, BACKGROUNDS, lc, 45.0f, NULL);
+    cj_contrast_apca_batch(many, COLORS, many, BACKGROUNDS, NULL, 45.0f, mask);
+    for (int i = 0; i < COLORS; i++) {
+        for (int j = 0; j < BACKGROUNDS; j++) {
+            float single = 0.0f;
+            cj_contrast_apca_batch(&many[i], 1, &many[j], 1, &single, 0.0f, NULL);
+            assert(lc[i * BACKGROUNDS + j] == single);
+            assert(mask[i * BACKGROUNDS + j] == (fabsf(single) >= 45.0f));
+        }
+        assert(lc[i * BACKGROUNDS + i] == 0.0f);
+    }
+
+    /* Invalid arguments write nothing */
+    ratios[0] = -1.0f;
+    cj_contrast_wcag_batch(NULL, 3, backgrounds, 2, ratios, 4.5f, pass);
+    cj_contrast_wcag_batch(colors, 0, backgrounds, 2, ratios, 4.5f, pass);
+    assert(ratios[0] == -1.0f);
+}
+
+static void expect_table_entry(const CJ_GradientTable* table, int entry, const uint8_t* pixel) {
+    assert(memcmp(table->rgb[entry], pixel, 3) == 0);
+}
+
+static void test_colormap_apply(void) {
+    CJ_Config config;
+    cj_config_init(&config);
+    config.anchor_count = 3;
+    config.anchors[0] = (CJ_RGB){0.05f, 0.02f, 0.3f};
+    config.anchors[1] = (CJ_RGB){0.8f, 0.2f, 0.3f};
+    config.anchors[2] = (CJ_RGB){0.95f, 0.9f, 0.2f};
+    CJ_Journey journey = cj_journey_create(&config);
+    CJ_GradientTable table;
+    cj_gradient_table_bake(journey, &table);
+    const int last = CJ_GRADIENT_TABLE_SIZE - 1;
+
+    /* Linear with defaults: ends and midpoint, out-of-range clamps, NaN transparent */
+    const float values[6] = {0.0f, 10.0f, 5.0f, -3.0f, 42.0f, NAN};
+    uint8_t rgba[6 * 4];
+    cj_colormap_apply(journey, values, 6, 0.0f, 10.0f, rgba, CJ_PIXEL_RGBA8, NULL);
+    expect_table_entry(&table, 0, rgba);
+    expect_table_entry(&table, last, rgba + 4);
+    expect_table_entry(&table, 512, rgba + 8);
+    expect_table_entry(&table, 0, rgba + 12);
+    expect_table_entry(&table, last, rgba + 16);
+    assert(rgba[3] == 255 && rgba[23] == 0 && rgba[20] == 0);
+
+    /* Colors are sRGB-encoded journey samples, not linear values scaled to bytes */
+    const float positions[3] = {0.0f, 1.0f, 512.0f / (float)last};
+    for (int i = 0; i < 3; i++) {
+        CJ_RGB c = cj_journey_sample(journey, positions[i]);
+        assert(abs(rgba[i * 4] - srgb8_encode(c.r)) <= 1);
+        assert(abs(rgba[i * 4 + 1] - srgb8_encode(c.g)) <= 1);
+        assert(abs(rgba[i * 4 + 2] - srgb8_encode(c.b)) <= 1);
+    }
+
+    /* Clip colors, pre-baked table without a journey, BGRA and RGB layouts */
+    CJ_ColormapOptions options;
+    cj_colormap_options_init(&options);
+    options.clip = true;
+    options.table = &table;
+    const uint8_t under[4] = {1, 2, 3, 4};
+    const uint8_t over[4] = {5, 6, 7, 8};
+    const uint8_t nan_color[4] = {9, 10, 11, 12};
+    memcpy(options.under_color, under, 4);
+    memcpy(options.over_color, over, 4);
+    memcpy(options.nan_color, nan_color, 4);
+    cj_colormap_apply(NULL, values, 6, 0.0f, 10.0f, rgba, CJ_PIXEL_RGBA8, &options);
+    assert(memcmp(rgba + 12, under, 4) == 0 && memcmp(rgba + 16, over, 4) == 0);
+    assert(memcmp(rgba + 20, nan_color, 4) == 0);
+    uint8_t bgra[6 * 4];
+    cj_colormap_apply(NULL, values, 6, 0.0f, 10.0f, bgra, CJ_PIXEL_BGRA8, &options);
+    for (int i = 0; i < 6; i++) {
+        assert(bgra[i * 4] == rgba[i * 4 + 2] && bgra[i * 4 + 2] == rgba[i * 4] && bgra[i * 4 + 3] == rgba[i * 4 + 3]);
+    }
+    uint8_t rgb[6 * 3];
+    cj_colormap_apply(NULL, values, 6, 0.0f, 10.0f, rgb, CJ_PIXEL_RGB8, &options);
+    for (int i = 0; i < 6; i++) {
+        assert(memcmp(rgb + i * 3, rgba + i * 4, 3) == 0);
+    }
+
+    /* Log: decades spread evenly; non-positive values are under the range */
+    const float decades[4] = {1.0f, 10.0f, 100.0f, 0.0f};
+    options.normalization = CJ_NORM_LOG;
+    cj_colormap_apply(NULL, decades, 4, 1.0f, 100.0f, rgba, CJ_PIXEL_RGBA8, &options);
+    expect_table_entry(&table, 0, rgba);
+    expect_table_entry(&table, 512, rgba + 4);
+    expect_table_entry(&table, last, rgba + 8);
+    assert(memcmp(rgba + 12, under, 4) == 0);
+    uint8_t unchanged[4] = {0xAB, 0xAB, 0xAB, 0xAB};
+    cj_colormap_apply(NULL, decades, 1, 0.0f, 100.0f, unchanged, CJ_PIXEL_RGBA8, &options);
+    assert(unchanged[0] == 0xAB);
+
+    /* Symlog over a symmetric range mirrors around the middle, including zero */
+    options.normalization = CJ_NORM_SYMLOG;
+    options.symlog_scale = 0.5f;
+    const float symmetric[5] = {-1000.0f, -3.0f, 0.0f, 3.0f, 1000.0f};
+    cj_colormap_apply(NULL, symmetric, 5, -1000.0f, 1000.0f, rgba, CJ_PIXEL_RGBA8, &options);
+    expect_table_entry(&table, 0, rgba);
+    expect_table_entry(&table, 512, rgba + 8);
+    expect_table_entry(&table, last, rgba + 16);
+    float inner = (float)last * 0.5f * (1.0f - log1pf(6.0f) / log1pf(2000.0f));
+    expect_table_entry(&table, (int)(inner + 0.5f), rgba + 4);
+    expect_table_entry(&table, last - (int)(inner + 0.5f), rgba + 12);
+
+    /* Histogram: skewed data gets evenly spread entries */
+    enum { SKEWED = 4000 };
+    static float skewed[SKEWED];
+    static uint8_t mapped[SKEWED * 4];
+    for (int i = 0; i < SKEWED; i++) {
+        float u = (i + 0.5f) / SKEWED;
+        skewed[i] = u * u * u * 100.0f; /* Ascending, dense near 0 */
+    }
+    options.normalization = CJ_NORM_HISTOGRAM;
+    cj_colormap_apply(NULL, skewed, SKEWED, 0.0f, 100.0f, mapped, CJ_PIXEL_RGBA8, &options);
+    CJ_ColormapEqualization equalization;
+    cj_colormap_equalize(skewed, SKEWED, 0.0f, 100.0f, &equalization);
+    for (int q = 1; q < 4; q++) {
+        /* The value at quantile q/4 lands near entry q/4 of the table */
+        int i = q * SKEWED / 4;
+        int bin = (int)(skewed[i] / 100.0f * CJ_COLORMAP_HISTOGRAM_BINS);
+        int entry = equalization.entry[bin];
+        assert(abs(entry - q * last / 4) < 16);
+        expect_table_entry(&table, entry, mapped + i * 4);
+    }
+    /* A shared equalization gives the same colors when mapping in parts */
+    static uint8_t parts[SKEWED * 4];
+    options.equalization = &equalization;
+    cj_colormap_apply(NULL, skewed, SKEWED / 2, 0.0f, 100.0f, parts, CJ_PIXEL_RGBA8, &options);
+    cj_colormap_apply(NULL, skewed + SKEWED / 2, SKEWED / 2, 0.0f, 100.0f, parts + SKEWED * 2, CJ_PIXEL_RGBA8, &options);
+    assert(memcmp(parts, mapped, sizeof(mapped)) == 0);
+
+    /* Invalid arguments write nothing */
+    memset(rgba, 0xAB, sizeof(rgba));
+    cj_colormap_apply(journey, values, 6, 10.0f, 10.0f, rgba, CJ_PIXEL_RGBA8, NULL);
+    cj_colormap_apply(journey, values, 6, 0.0f, NAN, rgba, CJ_PIXEL_RGBA8, NULL);
+    cj_colormap_apply(NULL, values, 6, 0.0f, 10.0f, rgba, CJ_PIXEL_RGBA8, NULL);
+    cj_colormap_apply(journey, NULL, 6, 0.0f, 10.0f, rgba, CJ_PIXEL_RGBA8, NULL);
+    assert(rgba[0] == 0xAB && rgba[23] == 0xAB);
+
+    cj_journey_destroy(journey);
+}
+
+/* Exhaustive projection onto the polyline the inverse is built from */
+static float inverse_brute_force(CJ_Journey journey, int samples, CJ_RGB color, float* out_distance) {
+    const CJ_Lab q = cj_rgb_to_oklab(color);
+    CJ_Lab a = cj_rgb_to_oklab(cj_journey_sample(journey, 0.0f));
+    float best_d2 = INFINITY;
+    float best_t = 0.0f;
+    for (int k = 0; k + 1 < samples; k++) {
+        const CJ_Lab b = cj_rgb_to_oklab(cj_journey_sample(journey, (float)(k + 1) / (float)(samples - 1)));
+        const float ab[3] = {b.L - a.L, b.a - a.a, b.b - a.b};
+        const float aq[3] = {q.L - a.L, q.a - a.a, q.b - a.b};
+        const float length2 = ab[0] * ab[0] + ab[1] * ab[1] + ab[2] * ab[2];
+        float u = length2 > 0.0f ? (aq[0] * ab[0] + aq[1] * ab[1] + aq[2] * ab[2]) / length2 : 0.0f;
+        u = u < 0.0f ? 0.0f : (u > 1.0f ? 1.0f : u);
+        const float d[3] = {aq[0] - u * ab[0], aq[1] - u * ab[1], aq[2] - u * ab[2]};
+        const float d2 = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+        if (d2 < best_d2) {
+            best_d2 = d2;
+            best_t = ((float)k + u) / (float)(samples - 1);
+        }
+        a = b;
+    }
+    *out_distance = sqrtf(best_d2);
+    return best_t;
+}
+
+static void test_journey_inverse(void) {
+    CJ_Config config;
+    cj_config_init(&config);
+    config.anchor_count = 3;
+    config.anchors[0] = (CJ_RGB){0.05f, 0.02f, 0.3f};
+    config.anchors[1] = (CJ_RGB){0.8f, 0.2f, 0.3f};
+    config.anchors[2] = (CJ_RGB){0.95f, 0.9f, 0.2f};
+    CJ_Journey journey = cj_journey_create(&config);
+    const int samples = 1024;
+    CJ_JourneyInverse inverse = cj_journey_inverse_create(journey, samples);
+    assert(inverse != NULL);
+
+    /* Colors on the journey come back at their own t */
+    for (int i = 0; i <= 100; i++) {
+        float t = (float)i / 100.0f;
+        float distance = -1.0f;
+        float found = cj_journey_inverse_query(inverse, cj_journey_sample(journey, t), &distance);
+        assert(fabsf(found - t) < 2e-3f);
+        assert(distance >= 0.0f && distance < 1e-3f);
+    }
+
+    /* Off-journey colors match an exhaustive projection */
+    enum { QUERIES = 200 };
+    CJ_RGB colors[QUERIES];
+    uint32_t state = 7u;
+    for (int i = 0; i < QUERIES; i++) {
+        float channel[3];
+        for (int c = 0; c < 3; c++) {
+            state = state * 1664525u + 1013904223u;
+            channel[c] = (float)(state >> 8) / 16777216.0f;
+        }
+        colors[i] = (CJ_RGB){channel[0], channel[1], channel[2]};
+    }
+    float ts[QUERIES];
+    float distances[QUERIES];
+    cj_journey_inverse_query_batch(inverse, colors, QUERIES, ts, distances);
+    for (int i = 0; i < QUERIES; i++) {
+        float expected_distance;
+        float expected_t = inverse_brute_force(journey, samples, colors[i], &expected_distance);
+        assert(fabsf(distances[i] - expected_distance) < 1e-5f);
+        /* Equal distances elsewhere on the curve would be a legitimate answer */
+        if (fabsf(ts[i] - expected_t) > 1e-4f) {
+            float at_t = cj_delta_e(cj_rgb_to_oklab(colors[i]), cj_rgb_to_oklab(cj_journey_sample(journey, ts[i])));
+            assert(fabsf(at_t - expected_distance) < 1e-3f);
+        }
+        float single = cj_journey_inverse_query(inverse, colors[i], NULL);
+        assert(single == ts[i]);
+    }
+
+    /* Invalid arguments are rejected; the inverse outlives its journey */
+    assert(cj_journey_inverse_create(journey, 1) == NULL);
+    cj_journey_destroy(journey);
+    float t_after = cj_journey_inverse_query(inverse, colors[0], NULL);
+    assert(t_after == ts[0]);
+    assert(cj_journey_inverse_create(NULL, samples) == NULL);
+    assert(cj_journey_inverse_query(NULL, colors[0], NULL) == -1.0f);
+    cj_journey_inverse_query_batch(NULL, colors, QUERIES, ts, NULL);
+    cj_journey_inverse_destroy(inverse);
+    cj_journey_inverse_destroy(NULL);
+}
+
+static void expect_rgb_near(CJ_RGB a, CJ_RGB b, float tolerance) {
+    assert(fabsf(a.r - b.r) < tolerance && fabsf(a.g - b.g) < tolerance && fabsf(a.b - b.b) < tolerance);
+}
+
+static void test_journey_field(void) {
+    /* 2 x 2 grid: corners reproduce the anchors, the center is their OKLab mean */
+    const CJ_RGB corners[4] = {
+        {0.9f, 0.1f, 0.1f}, {0.1f, 0.1f, 0.9f},  /* v = 0 */
+        {0.9f, 0.9f, 0.8f}, {0.2f, 0.2f, 0.2f}   /* v = 1 */
+    };
+    CJ_JourneyField bilinear = cj_journey_field_create_grid(corners, 2, 2, CJ_FIELD_BILINEAR);
+    CJ_JourneyField bicubic = cj_journey_field_create_grid(corners, 2, 2, CJ_FIELD_BICUBIC);
+    assert(bilinear != NULL && bicubic != NULL);
+    for (int j = 0; j < 2; j++) {
+        for (int i = 0; i < 2; i++) {
+            expect_rgb_near(cj_journey_field_sample(bilinear, (float)i, (float)j), corners[j * 2 + i], 1e-4f);
+            expect_rgb_near(cj_journey_field_sample(bicubic, (float)i, (float)j), corners[j * 2 + i], 1e-4f);
+        }
+    }
+    CJ_Lab mean = {0.0f, 0.0f, 0.0f};
+    for (int n = 0; n < 4; n++) {
+        CJ_Lab lab = cj_rgb_to_oklab(corners[n]);
+        mean.L += 0.25f * lab.L;
+        mean.a += 0.25f * lab.a;
+        mean.b += 0.25f * lab.b;
+    }
+    CJ_RGB center = cj_journey_field_sample(bilinear, 0.5f, 0.5f);
+    assert(cj_delta_e(cj_rgb_to_oklab(center), mean) < 1e-4f);
+    /* Out-of-range and NaN coordinates clamp */
+    expect_rgb_near(cj_journey_field_sample(bilinear, -3.0f, NAN), corners[0], 1e-4f);
+    expect_rgb_near(cj_journey_field_sample(bilinear, 7.0f, 2.0f), corners[3], 1e-4f);
+
+    /* Bicubic passes through interior anchors of a 3 x 3 grid */
+    CJ_RGB grid[9];
+    for (int n = 0; n < 9; n++) {
+        grid[n] = (CJ_RGB){(float)(n % 3) * 0.4f + 0.1f, (float)(n / 3) * 0.4f + 0.1f, 0.5f};
+    }
+    CJ_JourneyField smooth = cj_journey_field_create_grid(grid, 3, 3, CJ_FIELD_BICUBIC);
+    expect_rgb_near(cj_journey_field_sample(smooth, 0.5f, 0.5f), grid[4], 1e-4f);
+    expect_rgb_near(cj_journey_field_sample(smooth, 1.0f, 0.5f), grid[5], 1e-4f);
+
+    /* From journeys: each row is its journey */
+    CJ_Config config;
+    cj_config_init(&config);
+    config.anchor_count = 2;
+    config.anchors[0] = (CJ_RGB){0.05f, 0.02f, 0.3f};
+    config.anchors[1] = (CJ_RGB){0.95f, 0.9f, 0.2f};
+    CJ_Journey rows[2];
+    rows[0] = cj_journey_create(&config);
+    config.anchors[0] = (CJ_RGB){0.3f, 0.3f, 0.3f};
+    config.anchors[1] = (CJ_RGB){0.7f, 0.7f, 0.7f};
+    rows[1] = cj_journey_create(&config);
+    CJ_JourneyField field = cj_journey_field_create(rows, 2, CJ_FIELD_BILINEAR);
+    assert(field != NULL);
+    assert(cj_journey_field_create(rows, 1, CJ_FIELD_BILINEAR) == NULL);
+    for (int i = 0; i <= 20; i++) {
+        float u = (float)i / 20.0f;
+        expect_rgb_near(cj_journey_field_sample(field, u, 0.0f), cj_journey_sample(rows[0], u), 2e-3f);
+        expect_rgb_near(cj_journey_field_sample(field, u, 1.0f), cj_journey_sample(rows[1], u), 2e-3f);
+    }
+    cj_journey_destroy(rows[0]);
+    cj_journey_destroy(rows[1]);
+
+    /* Batch matches single samples */
+    const float us[3] = {0.0f, 0.3f, 0.9f};
+    const float vs[3] = {0.5f, 0.1f, 1.0f};
+    CJ_RGB batch[3];
+    cj_journey_field_sample_batch(field, us, vs, 3, batch);
+    for (int i = 0; i < 3; i++) {
+        CJ_RGB single = cj_journey_field_sample(field, us[i], vs[i]);
+        assert(memcmp(&single, &batch[i], sizeof(CJ_RGB)) == 0);
+    }
+
+    /* Rasterization: pixel (x, y) shows (x / (W - 1), y / (H - 1)), sRGB-encoded; only the requested rows are written */
+    enum { W = 9, H = 5, STRIDE = W * 4 + 4 };
+    uint8_t rgba[H * STRIDE];
+    uint8_t bgra[H * STRIDE];
+    uint8_t rgb[H * W * 3];
+    memset(rgba, 0xAB, sizeof(rgba));
+    cj_journey_field_rasterize(field, rgba, W, H, STRIDE, CJ_PIXEL_RGBA8, 0, 2);
+    cj_journey_field_rasterize(field, rgba, W, H, STRIDE, CJ_PIXEL_RGBA8, 2, 99);
+    cj_journey_field_rasterize(field, bgra, W, H, STRIDE, CJ_PIXEL_BGRA8, 0, H);
+    cj_journey_field_rasterize(field, rgb, W, H, W * 3, CJ_PIXEL_RGB8, 0, H);
+    for (int y = 0; y < H; y++) {
+        for (int x = 0; x < W; x++) {
+            const uint8_t* p = rgba + y * STRIDE + x * 4;
+            const uint8_t* q = bgra + y * STRIDE + x * 4;
+            CJ_RGB c = cj_journey_field_sample(field, (float)x / (W - 1), (float)y / (H - 1));
+            assert(abs(p[0] - srgb8_encode(c.r)) <= 1);
+            assert(abs(p[1] - srgb8_encode(c.g)) <= 1);
+            assert(abs(p[2] - srgb8_encode(c.b)) <= 1);
+            assert(p[3] == 255);
+            assert(q[0] == p[2] && q[1] == p[1] && q[2] == p[0] && q[3] == 255);
+            assert(memcmp(rgb + (y * W + x) * 3, p, 3) == 0);
+        }
+        assert(rgba[y * STRIDE + W * 4] == 0xAB); /* Row padding untouched */
+    }
+    /* Rows wider than one internal column chunk */
+    enum { WIDE = 600 };
+    static uint8_t wide[2 * WIDE * 3];
+    cj_journey_field_rasterize(field, wide, WIDE, 2, WIDE * 3, CJ_PIXEL_RGB8, 1, 2);
+    for (int x = 0; x < WIDE; x += 7) {
+        const uint8_t* p = wide + (WIDE + x) * 3;
+        CJ_RGB c = cj_journey_field_sample(field, (float)x / (WIDE - 1), 1.0f);
+        assert(abs(p[0] - srgb8_encode(c.r)) <= 1);
+        assert(abs(p[2] - srgb8_encode(c.b)) <= 1);
+    }
+    memset(rgba, 0xAB, sizeof(rgba));
+    cj_journey_field_rasterize(field, rgba, W, H, STRIDE, CJ_PIXEL_RGBA8, 3, 4);
+    assert(rgba[2 * STRIDE] == 0xAB && rgba[3 * STRIDE + 3] == 255 && rgba[4 * STRIDE] == 0xAB);
+
+    /* Invalid arguments */
+    assert(cj_journey_field_create(NULL, 2, CJ_FIELD_BILINEAR) == NULL);
+    assert(cj_journey_field_create_grid(corners, 1, 4, CJ_FIELD_BILINEAR) == NULL);
+    CJ_RGB none = cj_journey_field_sample(NULL, 0.5f, 0.5f);
+    assert(none.r == 0.0f && none.g == 0.0f && none.b == 0.0f);
+    memset(rgba, 0xAB, sizeof(rgba));
+    cj_journey_field_rasterize(field, rgba, W, H, W * 4 - 1, CJ_PIXEL_RGBA8, 0, H);
+    cj_journey_field_rasterize(NULL, rgba, W, H, STRIDE, CJ_PIXEL_RGBA8, 0, H);
+    assert(rgba[0] == 0xAB);
+
+    cj_journey_field_destroy(field);
+    cj_journey_field_destroy(smooth);
+    cj_journey_field_destroy(bicubic);
+    cj_journey_field_destroy(bilinear);
+    cj_journey_field_destroy(NULL);
+}
+
 int main(void) {
     test_samples_in_range();
     test_discrete_contrast();
     test_discrete_index_and_range_access();
     test_discrete_range_contrast();
+    test_stats();
+    test_image_gradient_map();
+    test_palette_index();
+    test_extract_anchors();
+    test_cvd_simulation();
+    test_contrast_batch();
+    test_colormap_apply();
+    test_journey_inverse();
+    test_journey_field();
     printf("C core tests passed\n");
     return 0;
 }
@@ -0,0 +1,84 @@
+/**
+ * Allocation Tests for the Swift wrapper
+ *
+ * Counts heap allocations around `discrete(count:)` and `sample(at:)` using
+ * the counting allocator shim from Tests/Benchmarks/alloc_count.c. The shim
+ * is Linux/glibc only and must be preloaded, otherwise these tests skip:
+ *
+ *   cmake --build build --target colorjourney_alloc_shim
+ *   LD_PRELOAD=$PWD/build/libcolorjourney_alloc_shim.so swift test --filter AllocationTests
+ *
+ * The C core allocates nothing while generating colors, so the wrapper's
+ * allocation count must not grow with the palette size.
+ */
+
+import XCTest
+@testable import ColorJourney
+import Foundation
+
+final class AllocationTests: XCTestCase {
+
+    /// Mirrors BenchAllocStats: allocations, frees, bytes, live bytes, peak live bytes
+    private typealias SnapshotFn = @convention(c) (UnsafeMutablePointer<UInt64>) -> Void
+
+    private func allocationSnapshot() throws -> SnapshotFn {
+        guard let handle = dlopen(nil, RTLD_NOW),
+              let symbol = dlsym(handle, "bench_alloc_snapshot") else {
+            throw XCTSkip("Counting allocator shim not preloaded (see file header)")
+        }
+        return unsafeBitCast(symbol, to: SnapshotFn.self)
+    }
+
+    /// Allocations made while `body` runs; the counters are process-wide, so keep `body` single-threaded
+    private func allocations(_ snapshot: SnapshotFn, _ body: () -> Void) -> UInt64 {
+        var before = [UInt64](repeating: 0, count: 5)
+        var after = [UInt64](repeating: 0, count: 5)
+        before.withUnsafeMutableBufferPointer { snapshot($0.baseAddress!) }
+        body()
+        after.withUnsafeMutableBufferPointer { snapshot($0.baseAddress!) }
+        return after[0] - before[0]
+    }
+
+    private func makeJourney() -> ColorJourney {
+        ColorJourney(config: ColorJourneyConfig(
+            anchors: [
+                ColorJourneyRGB(red: 0.85, green: 0.35, blue: 0.25),
+                ColorJourneyRGB(red: 0.25, green: 0.45, blue: 0.85)
+            ],
+            contrast: .high
+        ))
+    }
+
+    func testDiscreteAllocationsIndependentOfCount() throws {
+        let snapshot = try allocationSnapshot()
+        let journey = makeJourney()
+        _ = journey.discrete(count: 8)
+
+        var small: [ColorJourneyRGB] = []
+        var large: [ColorJourneyRGB] = []
+        let smallAllocations = allocations(snapshot) { small = journey.discrete(count: 10) }
+        let largeAllocations = allocations(snapshot) { large = journey.discrete(count: 1000) }
+
+        XCTAssertEqual(small.count, 10)
+        XCTAssertEqual(large.count, 1000)
+        // The CJ_RGB scratch array and the mapped result; the core adds none.
+        XCTAssertLessThanOrEqual(largeAllocations, 4)
+        XCTAssertEqual(smallAllocations, largeAllocations)
+    }
+
+    func testSampleDoesNotAllocate() throws {
+        let snapshot = try allocationSnapshot()
+        let journey = makeJourney()
+        _ = journey.sample(at: 0.5)
+
+        var checksum: Float = 0
+        let count = allocations(snapshot) {
+            for i in 0..<1000 {
+                checksum += journey.sample(at: Float(i) / 999).red
+            }
+        }
+
+        XCTAssertGreaterThan(checksum, 0)
+        XCTAssertEqual(count, 0)
+    }
+}
@@ -0,0 +1,387 @@
+/**
+ * Palette Latency Fuzzer
+ *
+ * Searches the CJ_Config space for inputs that maximize the cost of each
+ * generated color. The objective is journey samples per color, counted by
+ * ColorJourney.c built with -DCJ_ENABLE_STATS, because delta enforcement
+ * (two binary-search attempts plus the last-resort step) multiplies samples
+ * per color by more than 10x on some configs. `--objective time` switches to
+ * monotonic wall time per color instead.
+ *
+ * Two entry points share one decoder:
+ * - libFuzzer (-DCJ_LIBFUZZER, -fsanitize=fuzzer): LLVMFuzzerTestOneInput
+ *   aborts when an input exceeds CJ_FUZZ_MAX_SAMPLES_PER_COLOR, so slow
+ *   inputs are saved as crash artifacts and -minimize_crash=1 shrinks them.
+ * - Standalone driver (default): a seeded mutation search that keeps the
+ *   slowest inputs, minimizes them and saves them with a budget file. The
+ *   same budget file is replayed by `--check` as a latency regression gate.
+ *
+ * Input layout (missing trailing bytes decode as zero):
+ *   [0] anchor count (1-8)  [1..24] anchor RGB bytes  [25] lightness bias
+ *   [26] lightness weight   [27] chroma bias          [28] chroma multiplier
+ *   [29] contrast level     [30] contrast threshold   [31] vibrancy
+ *   [32] temperature        [33] loop mode            [34] variation flags
+ *   [35] variation strength [36] variation magnitude  [37..44] variation seed
+ *   [45] API (range/discrete) [46..47] color count (1-256)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "ColorJourney.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#define FUZZ_INPUT_BYTES 48
+#define FUZZ_MAX_COLORS 256
+#define FUZZ_BUDGET_FILE "budget.txt"
+
+typedef struct {
+    CJ_Config config;
+    int use_range;
+    int count;
+} FuzzCase;
+
+typedef struct {
+    uint8_t bytes[FUZZ_INPUT_BYTES];
+    size_t size;
+    double cost;
+} FuzzInput;
+
+static int objective_is_time = 0;
+
+static uint8_t input_byte(const uint8_t* data, size_t size, size_t offset) {
+    return offset < size ? data[offset] : 0;
+}
+
+static float unit_byte(const uint8_t* data, size_t size, size_t offset) {
+    return (float)input_byte(data, size, offset) / 255.0f;
+}
+
+static void decode_case(const uint8_t* data, size_t size, FuzzCase* out) {
+    CJ_Config* config = &out->config;
+    cj_config_init(config);
+
+    config->anchor_count = 1 + input_byte(data, size, 0) % 8;
+    for (int i = 0; i < 8; i++) {
+        config->anchors[i].r = unit_byte(data, size, 1 + (size_t)i * 3);
+        config->anchors[i].g = unit_byte(data, size, 2 + (size_t)i * 3);
+        config->anchors[i].b = unit_byte(data, size, 3 + (size_t)i * 3);
+    }
+    config->lightness_bias = (CJ_LightnessBias)(input_byte(data, size, 25) % 4);
+    config->lightness_custom_weight = unit_byte(data, size, 26) * 2.0f - 1.0f;
+    config->chroma_bias = (CJ_ChromaBias)(input_byte(data, size, 27) % 4);
+    config->chroma_custom_multiplier = 0.5f + unit_byte(data, size, 28) * 1.5f;
+    config->contrast_level = (CJ_ContrastLevel)(input_byte(data, size, 29) % 4);
+    config->contrast_custom_threshold = unit_byte(data, size, 30) * 0.5f;
+    config->mid_journey_vibrancy = unit_byte(data, size, 31);
+    config->temperature_bias = (CJ_TemperatureBias)(input_byte(data, size, 32) % 3);
+    config->loop_mode = (CJ_LoopMode)(input_byte(data, size, 33) % 3);
+
+    const uint8_t variation = input_byte(data, size, 34);
+    config->variation_enabled = (variation & 0x08) != 0;
+    config->variation_dimensions = variation & 0x07;
+    config->variation_strength = (CJ_VariationStrength)(input_byte(data, size, 35) % 3);
+    config->variation_custom_magnitude = unit_byte(data, size, 36) * 0.2f;
+    config->variation_seed = 0;
+    for (size_t i = 0; i < 8; i++) {
+        config->variation_seed |= (uint64_t)input_byte(data, size, 37 + i) << (8 * i);
+    }
+
+    out->use_range = input_byte(data, size, 45) % 2 == 0;
+    out->count = 1 + ((input_byte(data, size, 46) | (input_byte(data, size, 47) << 8)) % FUZZ_MAX_COLORS);
+}
+
+static double monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/* Cost of one input: journey samples (or nanoseconds) per generated color. */
+static double measure_cost(const uint8_t* data, size_t size) {
+    FuzzCase fuzz_case;
+    decode_case(data, size, &fuzz_case);
+
+    CJ_RGB colors[FUZZ_MAX_COLORS];
+    CJ_Journey journey = cj_journey_create(&fuzz_case.config);
+    if (!journey) {
+        return 0.0;
+    }
+
+    cj_stats_reset();
+    const double start = monotonic_ns();
+    if (fuzz_case.use_range) {
+        cj_journey_discrete_range(journey, 0, fuzz_case.count, colors);
+    } else {
+        cj_journey_discrete(journey, fuzz_case.count, colors);
+    }
+    const double elapsed = monotonic_ns() - start;
+    cj_journey_destroy(journey);
+
+    CJ_Stats stats;
+    cj_stats_snapshot(&stats);
+    const double total = objective_is_time ? elapsed : (double)stats.samples;
+    return total / (double)fuzz_case.count;
+}
+
+#ifdef CJ_LIBFUZZER
+
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    static double budget = -1.0;
+    if (budget < 0.0) {
+        const char* env = getenv("CJ_FUZZ_MAX_SAMPLES_PER_COLOR");
+        budget = env ? atof(env) : 0.0;
+    }
+    const double cost = measure_cost(data, size);
+    if (budget > 0.0 && cost > budget) {
+        fprintf(stderr, "slow input: %.2f samples/color exceeds budget %.2f\n", cost, budget);
+        abort();
+    }
+    return 0;
+}
+
+#else
+
+static uint64_t rng_state = 0x9e3779b97f4a7c15ULL;
+
+static uint64_t rng_next(void) {
+    uint64_t z = (rng_state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+static void random_input(FuzzInput* input) {
+    for (size_t i = 0; i < FUZZ_INPUT_BYTES; i++) {
+        input->bytes[i] = (uint8_t)rng_next();
+    }
+    input->size = FUZZ_INPUT_BYTES;
+}
+
+static void mutate_input(FuzzInput* input) {
+    static const uint8_t extremes[] = {0x00, 0x01, 0x7f, 0x80, 0xfe, 0xff};
+    const int edits = 1 + (int)(rng_next() % 4);
+    input->size = FUZZ_INPUT_BYTES;
+    for (int e = 0; e < edits; e++) {
+        const size_t offset = (size_t)(rng_next() % FUZZ_INPUT_BYTES);
+        switch (rng_next() % 3) {
+            case 0: input->bytes[offset] ^= (uint8_t)(1u << (rng_next() % 8)); break;
+            case 1: input->bytes[offset] = extremes[rng_next() % sizeof(extremes)]; break;
+            default: input->bytes[offset] = (uint8_t)rng_next(); break;
+        }
+    }
+}
+
+/* Zero bytes and drop the zero tail while the input stays at least 95% as slow. */
+static void minimize_input(FuzzInput* input) {
+    const double floor_cost = input->cost * 0.95;
+    for (size_t i = 0; i < input->size; i++) {
+        if (input->bytes[i] == 0) {
+            continue;
+        }
+        const uint8_t saved = input->bytes[i];
+        input->bytes[i] = 0;
+        const double cost = measure_cost(input->bytes, input->size);
+        if (cost >= floor_cost) {
+            input->cost = cost > input->cost ? cost : input->cost;
+        } else {
+            input->bytes[i] = saved;
+        }
+    }
+    while (input->size > 0 && input->bytes[input->size - 1] == 0) {
+        input->size--;
+    }
+    input->cost = measure_cost(input->bytes, input->size);
+}
+
+static int compare_cost_desc(const void* a, const void* b) {
+    const double ca = ((const FuzzInput*)a)->cost;
+    const double cb = ((const FuzzInput*)b)->cost;
+    return (ca < cb) - (ca > cb);
+}
+
+static int read_input_file(const char* path, FuzzInput* input) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        return -1;
+    }
+    input->size = fread(input->bytes, 1, FUZZ_INPUT_BYTES, file);
+    fclose(file);
+    return 0;
+}
+
+static int run_search(unsigned long iterations, size_t keep, const char* out_dir) {
+    FuzzInput* population = (FuzzInput*)calloc(keep, sizeof(FuzzInput));
+    if (!population) {
+        return 1;
+    }
+    size_t population_count = 0;
+
+    for (unsigned long iter = 0; iter < iterations; iter++) {
+        FuzzInput candidate;
+        if (population_count == 0 || rng_next() % 4 == 0) {
+            random_input(&candidate);
+        } else {
+            candidate = population[rng_next() % population_count];
+            mutate_input(&candidate);
+        }
+        candidate.cost = measure_cost(candidate.bytes, candidate.size);
+
+        /* Equal cost almost always means the same slow path; keep the set diverse. */
+        int duplicate = 0;
+        for (size_t p = 0; p < population_count && !duplicate; p++) {
+            duplicate = population[p].cost == candidate.cost;
+        }
+        if (duplicate) {
+            continue;
+        }
+        if (population_count < keep) {
+            population[population_count++] = candidate;
+        } else if (candidate.cost > population[keep - 1].cost) {
+            population[keep - 1] = candidate;
+        } else {
+            continue;
+        }
+        qsort(population, population_count, sizeof(FuzzInput), compare_cost_desc);
+    }
+
+    char path[1024];
+    snprintf(path, sizeof(path), "%s/%s", out_dir, FUZZ_BUDGET_FILE);
+    if (out_dir) {
+        mkdir(out_dir, 0755);
+    }
+    FILE* budget = out_dir ? fopen(path, "w") : NULL;
+    if (out_dir && !budget) {
+        fprintf(stderr, "cannot write %s\n", path);
+        free(population);
+        return 1;
+    }
+    if (budget) {
+        fprintf(budget, "# <input> <samples per color> (replayed by --check)\n");
+    }
+
+    for (size_t i = 0; i < population_count; i++) {
+        minimize_input(&population[i]);
+        printf("slow-%02zu: %.2f %s/color, %zu bytes\n",
+               i, population[i].cost, objective_is_time ? "ns" : "samples", population[i].size);
+        if (!budget) {
+            continue;
+        }
+        snprintf(path, sizeof(path), "%s/slow-%02zu.bin", out_dir, i);
+        FILE* file = fopen(path, "wb");
+        if (file) {
+            fwrite(population[i].bytes, 1, population[i].size, file);
+            fclose(file);
+        }
+        /* Budgets are always recorded in samples, which are deterministic across machines. */
+        const int was_time = objective_is_time;
+        objective_is_time = 0;
+        fprintf(budget, "slow-%02zu.bin %.4f\n", i, measure_cost(population[i].bytes, population[i].size));
+        objective_is_time = was_time;
+    }
+    if (budget) {
+        fclose(budget);
+    }
+    free(population);
+    return 0;
+}
+
+/* Replays a saved corpus; fails when any input costs more than budget * (1 + slack). */
+static int run_check(const char* dir, double slack) {
+    char path[1024];
+    snprintf(path, sizeof(path), "%s/%s", dir, FUZZ_BUDGET_FILE);
+    FILE* budget = fopen(path, "r");
+    if (!budget) {
+        fprintf(stderr, "cannot read %s\n", path);
+        return 1;
+    }
+
+    char line[512];
+    int checked = 0;
+    int failures = 0;
+    while (fgets(line, sizeof(line), budget)) {
+        char name[256];
+        double limit = 0.0;
+        if (line[0] == '#' || sscanf(line, "%255s %lf", name, &limit) != 2) {
+            continue;
+        }
+        FuzzInput input;
+        snprintf(path, sizeof(path), "%s/%s", dir, name);
+        if (read_input_file(path, &input) != 0) {
+            fprintf(stderr, "FAIL %s: missing input\n", name);
+            failures++;
+            continue;
+        }
+        const double cost = measure_cost(input.bytes, input.size);
+        const int ok = cost <= limit * (1.0 + slack);
+        printf("%s %s: %.2f samples/color (budget %.2f)\n", ok ? "ok  " : "FAIL", name, cost, limit);
+        failures += ok ? 0 : 1;
+        checked++;
+    }
+    fclose(budget);
+    printf("%d inputs checked, %d over budget\n", checked, failures);
+    return failures == 0 && checked > 0 ? 0 : 1;
+}
+
+static void print_usage(void) {
+    printf("Usage: fuzz_palette_latency [--objective samples|time] [--seed <n>]\n");
+    printf("         [--iterations <n>] [--keep <n>] [--out <dir>]    search and save slow inputs\n");
+    printf("       fuzz_palette_latency --check <dir> [--slack <fraction>]  replay a latency corpus\n");
+    printf("       fuzz_palette_latency <input>...                       print cost of inputs\n");
+}
+
+int main(int argc, char** argv) {
+    unsigned long iterations = 5000;
+    size_t keep = 8;
+    const char* out_dir = NULL;
+    const char* check_dir = NULL;
+    double slack = 0.10;
+    int file_args = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            iterations = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            rng_state = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--keep") == 0 && i + 1 < argc) {
+            keep = (size_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            out_dir = argv[++i];
+        } else if (strcmp(argv[i], "--check") == 0 && i + 1 < argc) {
+            check_dir = argv[++i];
+        } else if (strcmp(argv[i], "--slack") == 0 && i + 1 < argc) {
+            slack = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--objective") == 0 && i + 1 < argc) {
+            objective_is_time = strcmp(argv[++i], "time") == 0;
+        } else if (strcmp(argv[i], "--help") == 0) {
+            print_usage();
+            return 0;
+        } else if (argv[i][0] != '-') {
+            FuzzInput input;
+            if (read_input_file(argv[i], &input) == 0) {
+                printf("%s: %.2f %s/color\n", argv[i], measure_cost(input.bytes, input.size),
+                       objective_is_time ? "ns" : "samples");
+            }
+            file_args++;
+        }
+    }
+
+    if (check_dir) {
+        objective_is_time = 0;
+        return run_check(check_dir, slack);
+    }
+    if (file_args > 0) {
+        return 0;
+    }
+    if (keep == 0) {
+        print_usage();
+        return 1;
+    }
+    return run_search(iterations, keep, out_dir);
+}
+
+#endif
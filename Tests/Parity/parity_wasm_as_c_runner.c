@@ -15,16 +15,6 @@ static void print_usage(void) {
     fprintf(stderr, "Usage: parity_wasm_as_c_runner --corpus <file> --case-id <id>\n");
 }
 
-static InputCase *find_case(Corpus *corpus, const char *case_id) {
-    if (!corpus || !case_id) return NULL;
-    for (size_t i = 0; i < corpus->case_count; ++i) {
-        if (strcmp(corpus->cases[i].id, case_id) == 0) {
-            return &corpus->cases[i];
-        }
-    }
-    return NULL;
-}
-
 static CJ_RGB anchor_to_rgb(const Anchor *anchor) {
     CJ_RGB rgb = {0.0f, 0.0f, 0.0f};
     if (anchor->has_srgb) {
@@ -131,20 +121,13 @@ int main(int argc, char **argv) {
     }
 
     ValidationError error = {.message = NULL};
-    Corpus corpus;
-    if (parse_corpus_file(corpus_path, &corpus, &error) != 0) {
-        fprintf(stderr, "Corpus validation failed: %s\n", error.message ? error.message : "unknown error");
-        free(error.message);
-        return 1;
-    }
-
-    InputCase *input_case = find_case(&corpus, case_id);
-    if (!input_case) {
-        fprintf(stderr, "Case %s not found in corpus.\n", case_id);
-        free_corpus(&corpus);
+    InputCase found_case;
+    if (find_corpus_case(corpus_path, case_id, &found_case, &error) != 0) {
+        fprintf(stderr, "Case %s not loaded from corpus: %s\n", case_id, error.message ? error.message : "unknown error");
         free(error.message);
         return 1;
     }
+    InputCase *input_case = &found_case;
 
     CJ_Config config;
     map_config(input_case, &config);
@@ -153,7 +136,7 @@ int main(int argc, char **argv) {
     CJ_RGB *palette = (CJ_RGB *)calloc(count, sizeof(CJ_RGB));
     if (!palette) {
         fprintf(stderr, "Failed to allocate palette.\n");
-        free_corpus(&corpus);
+        free_input_case(&found_case);
         free(error.message);
         return 1;
     }
@@ -163,7 +146,7 @@ int main(int argc, char **argv) {
     if (!journey) {
         fprintf(stderr, "Failed to create journey for %s.\n", case_id);
         free(palette);
-        free_corpus(&corpus);
+        free_input_case(&found_case);
         free(error.message);
         return 1;
     }
@@ -180,7 +163,7 @@ int main(int argc, char **argv) {
     cJSON_Delete(json);
     cj_journey_destroy(journey);
     free(palette);
-    free_corpus(&corpus);
+    free_input_case(&found_case);
     free(error.message);
     return 0;
 }
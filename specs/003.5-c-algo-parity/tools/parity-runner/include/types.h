@@ -4,14 +4,20 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <stdio.h>
 
 #define MAX_ID_LENGTH 128
 #define MAX_VERSION_LENGTH 32
 #define MAX_ERROR_MESSAGE 512
 #define MAX_ENGINE_NAME 32
 #define MAX_PATH_LENGTH 512
+#define COLUMNAR_ARTIFACT_NAME "run.cjcol"
+#define CASE_MANIFEST_NAME "case-hashes.tsv"
+#define SHARD_SUMMARY_NAME "shard.json"
+#define SHARD_CASES_NAME "shard-cases.jsonl"
 
 struct Contributor;
+struct MetricSketch;
 
 typedef struct {
     double l;
@@ -63,6 +69,22 @@ typedef struct {
     size_t case_count;
 } Corpus;
 
+// Incremental corpus reader: holds only the case currently being parsed.
+// Paths ending in .jsonl/.ndjson (and "-" for stdin) are read as JSON Lines.
+typedef struct {
+    FILE *file;
+    int owns_file;
+    int json_lines;
+    int finished;
+    int pending;
+    char corpus_version[MAX_VERSION_LENGTH];
+    char *description;
+    size_t cases_read;
+    char *text;
+    size_t text_length;
+    size_t text_capacity;
+} CorpusStream;
+
 typedef struct {
     double l;
     double a;
@@ -172,6 +194,8 @@ typedef struct {
     size_t failed;
     double duration_ms;
     double pass_rate;
+    size_t cache_hits;
+    size_t unchanged;
     RunStats stats;
 } RunSummary;
 
@@ -187,13 +211,50 @@ typedef struct {
     double max_duration_ms;
     double pass_gate;
     const char *artifact_policy;
+    const char *artifact_format;
 } RunProvenance;
 
 typedef struct {
-    ComparisonResult *results;
-    size_t result_count;
-    RunSummary summary;
-} RunResults;
+    char input_case_id[MAX_ID_LENGTH];
+    uint64_t offset;
+    int passed;
+    double max_delta_e;
+    size_t sample_count;
+} ColumnarIndexEntry;
+
+// Appends one case block per executed case, then an index on finish.
+// Index entries are staged in a temporary file until the index is written.
+typedef struct {
+    FILE *file;
+    FILE *index;
+    size_t entry_count;
+} ColumnarWriter;
+
+typedef struct {
+    FILE *file;
+    ColumnarIndexEntry *entries;
+    size_t entry_count;
+} ColumnarReader;
+
+typedef struct {
+    char id[MAX_ID_LENGTH];
+    uint64_t key;
+    int passed;
+} CaseManifestEntry;
+
+// Open-addressed case id -> content key table loaded from case-hashes.tsv.
+typedef struct {
+    CaseManifestEntry *entries;
+    size_t capacity;
+    size_t count;
+} CaseManifest;
+
+typedef struct {
+    uint64_t seed;
+    size_t first_case;
+    size_t case_count;
+    const char *corpus_version;
+} GeneratorOptions;
 
 typedef struct {
     const char *metric;
@@ -202,6 +263,21 @@ typedef struct {
     const char *parameter;
 } StageHint;
 
+#define CONTRIBUTOR_METRIC_COUNT 7
+
+// Per-metric extremes of one case; ranked once the run stats are final.
+typedef struct {
+    size_t sample_count;
+    double magnitude[CONTRIBUTOR_METRIC_COUNT];
+    double signed_value[CONTRIBUTOR_METRIC_COUNT];
+} ContributorExtremes;
+
+// Executed cases spilled to a temporary file, replayed into report.json.
+typedef struct {
+    FILE *file;
+    size_t case_count;
+} CaseSpill;
+
 typedef struct Contributor {
     char metric[32];
     double magnitude;
@@ -217,6 +293,13 @@ int validate_corpus_version(const char *version);
 int parse_corpus_file(const char *path, Corpus *out, ValidationError *error);
 int parse_tolerances_file(const char *path, ToleranceConfig *out, ValidationError *error);
 void free_corpus(Corpus *corpus);
+void free_input_case(InputCase *input_case);
+int open_corpus_stream(const char *path, CorpusStream *stream, ValidationError *error);
+// Returns 1 when a case was read, 0 at end of corpus, -1 on error.
+int next_corpus_case(CorpusStream *stream, InputCase *out, ValidationError *error);
+void close_corpus_stream(CorpusStream *stream);
+int find_corpus_case(const char *path, const char *case_id, InputCase *out, ValidationError *error);
+int write_current_case_file(const CorpusStream *stream, const char *path, ValidationError *error);
 void free_tolerances(ToleranceConfig *config);
 
 // Engine execution and parsing
@@ -253,6 +336,13 @@ void compute_metric_stats(const double *values, size_t count, MetricStats *out);
 
 // Analysis helpers
 const StageHint *lookup_stage_hint(const char *metric);
+void collect_contributor_extremes(const ComparisonResult *result, ContributorExtremes *out);
+int rank_contributors(const ContributorExtremes *extremes,
+                      const RunSummary *summary,
+                      size_t top_n,
+                      Contributor **out,
+                      size_t *out_count,
+                      ValidationError *error);
 int compute_contributors(const ComparisonResult *result,
                          const RunSummary *summary,
                          size_t top_n,
@@ -273,11 +363,96 @@ int write_case_metadata(const char *artifacts_root,
                         const ComparisonResult *result,
                         ValidationError *error);
 
-int write_run_report(const char *artifacts_root,
-                     const RunProvenance *provenance,
-                     const RunResults *results,
-                     const ToleranceConfig *tolerance,
-                     ValidationError *error);
+int open_case_spill(CaseSpill *spill, ValidationError *error);
+int spill_case(CaseSpill *spill,
+               const InputCase *input_case,
+               const ComparisonResult *result,
+               int include_samples,
+               int write_metadata,
+               ValidationError *error);
+// Replays the spill: ranks contributors, writes metadata.json and report.json.
+int write_spilled_run_report(const char *artifacts_root,
+                             const RunProvenance *provenance,
+                             const RunSummary *summary,
+                             CaseSpill *spill,
+                             const ToleranceConfig *tolerance,
+                             ValidationError *error);
+void close_case_spill(CaseSpill *spill);
+// Shard runs export the spill as one JSON line per case; merge spills those lines back.
+int export_case_spill(CaseSpill *spill, const char *path, ValidationError *error);
+int spill_case_line(CaseSpill *spill, const char *line, char *input_case_id, size_t id_capacity, ValidationError *error);
 int ensure_directory(const char *path, ValidationError *error);
+char *render_engine_output_json(const EngineOutput *output);
+char *render_comparison_json(const ComparisonResult *result);
+
+// Columnar artifacts
+int open_columnar_artifact(const char *artifacts_root, ColumnarWriter *writer, ValidationError *error);
+int append_columnar_case(ColumnarWriter *writer,
+                         const EngineOutput *canonical,
+                         const EngineOutput *alternate,
+                         const ComparisonResult *result,
+                         ValidationError *error);
+int finish_columnar_artifact(ColumnarWriter *writer, ValidationError *error);
+int open_columnar_reader(const char *path, ColumnarReader *reader, ValidationError *error);
+int read_columnar_case(ColumnarReader *reader,
+                       size_t entry_index,
+                       EngineOutput *canonical,
+                       EngineOutput *alternate,
+                       ComparisonResult *result,
+                       ValidationError *error);
+void close_columnar_reader(ColumnarReader *reader);
+int dump_columnar_artifact(const char *path,
+                           const char *case_id,
+                           const char *part,
+                           FILE *out,
+                           ValidationError *error);
+
+// Content-addressed result store
+uint64_t fnv1a64_update(uint64_t hash, const void *data, size_t length);
+int hash_file_contents(const char *path, uint64_t *out, ValidationError *error);
+uint64_t hash_tolerances(const ToleranceConfig *tolerance);
+uint64_t compute_case_key(const char *case_text, size_t case_length, uint64_t engine_hash, uint64_t tolerance_hash);
+// Returns 1 on a cache hit, 0 on a miss, -1 on invalid arguments.
+int load_cached_outputs(const char *store_root,
+                        uint64_t key,
+                        EngineOutput *canonical,
+                        EngineOutput *alternate,
+                        ValidationError *error);
+int store_cached_outputs(const char *store_root,
+                         uint64_t key,
+                         const EngineOutput *canonical,
+                         const EngineOutput *alternate,
+                         ValidationError *error);
+int load_case_manifest(const char *artifacts_root, CaseManifest *manifest, ValidationError *error);
+const CaseManifestEntry *find_case_manifest_entry(const CaseManifest *manifest, const char *id);
+void free_case_manifest(CaseManifest *manifest);
+void write_case_manifest_line(FILE *file, const char *id, uint64_t key, int passed);
+
+// Corpus generation
+int write_generated_corpus(FILE *out, const GeneratorOptions *options, ValidationError *error);
+
+// Sharded runs
+int parse_shard_spec(const char *spec, size_t *index, size_t *count);
+size_t shard_for_case(const char *case_id, size_t shard_count);
+int write_shard_summary(const char *artifacts_root,
+                        size_t shard_index,
+                        size_t shard_count,
+                        const RunProvenance *provenance,
+                        const ToleranceConfig *tolerance,
+                        uint64_t engine_hash,
+                        uint64_t tolerance_hash,
+                        const RunSummary *summary,
+                        const struct MetricSketch *sketches,
+                        ValidationError *error);
+// Fails when a shard of the run is missing unless allow_partial is set.
+int merge_shard_runs(const char *out_root,
+                     const char *const *shard_roots,
+                     size_t shard_root_count,
+                     const char *run_id,
+                     double pass_gate,
+                     double max_duration_ms,
+                     int allow_partial,
+                     RunSummary *summary_out,
+                     ValidationError *error);
 
 #endif // PARITY_TYPES_H
@@ -37,39 +37,26 @@ static const MetricStats *stats_for_metric(const char *metric, const RunSummary
     return NULL;
 }
 
-int compute_contributors(const ComparisonResult *result,
-                         const RunSummary *summary,
-                         size_t top_n,
-                         Contributor **out,
-                         size_t *out_count,
-                         ValidationError *error) {
-    if (!result || !summary || !out || !out_count) {
-        set_error(error, "invalid contributor arguments");
-        return -1;
-    }
-    if (result->sample_count == 0) {
-        *out = NULL;
-        *out_count = 0;
-        return 0;
+static const char *const contributor_metrics[CONTRIBUTOR_METRIC_COUNT] = {
+    "deltaE", "oklab.l", "oklab.a", "oklab.b", "srgb.r", "srgb.g", "srgb.b"
+};
+
+static void track_extreme(ContributorExtremes *out, size_t metric, double magnitude, double signed_value) {
+    if (magnitude > out->magnitude[metric]) {
+        out->magnitude[metric] = magnitude;
+        out->signed_value[metric] = signed_value;
     }
+}
 
-    const size_t metric_total = 7; /* deltaE, L, a, b, R, G, B */
-    typedef struct {
-        const char *metric;
-        double magnitude;
-        double signed_value;
-        double z_score;
-    } RawContributor;
-
-    RawContributor metrics[7] = {
-        {.metric = "deltaE", .magnitude = 0.0, .signed_value = 0.0, .z_score = 0.0},
-        {.metric = "oklab.l", .magnitude = 0.0, .signed_value = 0.0, .z_score = 0.0},
-        {.metric = "oklab.a", .magnitude = 0.0, .signed_value = 0.0, .z_score = 0.0},
-        {.metric = "oklab.b", .magnitude = 0.0, .signed_value = 0.0, .z_score = 0.0},
-        {.metric = "srgb.r", .magnitude = 0.0, .signed_value = 0.0, .z_score = 0.0},
-        {.metric = "srgb.g", .magnitude = 0.0, .signed_value = 0.0, .z_score = 0.0},
-        {.metric = "srgb.b", .magnitude = 0.0, .signed_value = 0.0, .z_score = 0.0},
-    };
+void collect_contributor_extremes(const ComparisonResult *result, ContributorExtremes *out) {
+    if (!out) {
+        return;
+    }
+    memset(out, 0, sizeof(ContributorExtremes));
+    if (!result) {
+        return;
+    }
+    out->sample_count = result->sample_count;
 
     for (size_t i = 0; i < result->sample_count; ++i) {
         const SampleDelta *sample = &result->samples[i];
@@ -81,50 +68,46 @@ int compute_contributors(const ComparisonResult *result,
         const double diff_g = sample->alternate.srgb.g - sample->canonical.srgb.g;
         const double diff_b_rgb = sample->alternate.srgb.b - sample->canonical.srgb.b;
 
-        const double mag_de = sample->delta.deltaE;
-        if (mag_de > metrics[0].magnitude) {
-            metrics[0].magnitude = mag_de;
-            metrics[0].signed_value = mag_de; /* deltaE is magnitude only */
-        }
-
-        const double mag_l = fabs(diff_l);
-        if (mag_l > metrics[1].magnitude) {
-            metrics[1].magnitude = mag_l;
-            metrics[1].signed_value = diff_l;
-        }
-
-        const double mag_a = fabs(diff_a);
-        if (mag_a > metrics[2].magnitude) {
-            metrics[2].magnitude = mag_a;
-            metrics[2].signed_value = diff_a;
-        }
-
-        const double mag_b = fabs(diff_b);
-        if (mag_b > metrics[3].magnitude) {
-            metrics[3].magnitude = mag_b;
-            metrics[3].signed_value = diff_b;
-        }
-
-        const double mag_r = fabs(diff_r);
-        if (mag_r > metrics[4].magnitude) {
-            metrics[4].magnitude = mag_r;
-            metrics[4].signed_value = diff_r;
-        }
-
-        const double mag_g = fabs(diff_g);
-        if (mag_g > metrics[5].magnitude) {
-            metrics[5].magnitude = mag_g;
-            metrics[5].signed_value = diff_g;
-        }
+        /* deltaE is magnitude only */
+        track_extreme(out, 0, sample->delta.deltaE, sample->delta.deltaE);
+        track_extreme(out, 1, fabs(diff_l), diff_l);
+        track_extreme(out, 2, fabs(diff_a), diff_a);
+        track_extreme(out, 3, fabs(diff_b), diff_b);
+        track_extreme(out, 4, fabs(diff_r), diff_r);
+        track_extreme(out, 5, fabs(diff_g), diff_g);
+        track_extreme(out, 6, fabs(diff_b_rgb), diff_b_rgb);
+    }
+}
 
-        const double mag_b_rgb = fabs(diff_b_rgb);
-        if (mag_b_rgb > metrics[6].magnitude) {
-            metrics[6].magnitude = mag_b_rgb;
-            metrics[6].signed_value = diff_b_rgb;
-        }
+int rank_contributors(const ContributorExtremes *extremes,
+                      const RunSummary *summary,
+                      size_t top_n,
+                      Contributor **out,
+                      size_t *out_count,
+                      ValidationError *error) {
+    if (!extremes || !summary || !out || !out_count) {
+        set_error(error, "invalid contributor arguments");
+        return -1;
+    }
+    if (extremes->sample_count == 0) {
+        *out = NULL;
+        *out_count = 0;
+        return 0;
     }
 
+    const size_t metric_total = CONTRIBUTOR_METRIC_COUNT;
+    typedef struct {
+        const char *metric;
+        double magnitude;
+        double signed_value;
+        double z_score;
+    } RawContributor;
+
+    RawContributor metrics[CONTRIBUTOR_METRIC_COUNT];
     for (size_t i = 0; i < metric_total; ++i) {
+        metrics[i].metric = contributor_metrics[i];
+        metrics[i].magnitude = extremes->magnitude[i];
+        metrics[i].signed_value = extremes->signed_value[i];
         metrics[i].z_score = compute_z_score(metrics[i].magnitude, stats_for_metric(metrics[i].metric, summary));
     }
 
@@ -180,3 +163,18 @@ int compute_contributors(const ComparisonResult *result,
     *out_count = placed;
     return 0;
 }
+
+int compute_contributors(const ComparisonResult *result,
+                         const RunSummary *summary,
+                         size_t top_n,
+                         Contributor **out,
+                         size_t *out_count,
+                         ValidationError *error) {
+    if (!result || !summary || !out || !out_count) {
+        set_error(error, "invalid contributor arguments");
+        return -1;
+    }
+    ContributorExtremes extremes;
+    collect_contributor_extremes(result, &extremes);
+    return rank_contributors(&extremes, summary, top_n, out, out_count, error);
+}
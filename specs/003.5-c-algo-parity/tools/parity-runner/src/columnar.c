@@ -0,0 +1,575 @@
+/*
+ * Columnar run artifact (run.cjcol).
+ *
+ * A single binary file per run replaces the per-case JSON artifacts when
+ * --artifact-format columnar is selected. All integers and doubles are
+ * little-endian; strings are a u32 byte length (0xFFFFFFFF for absent)
+ * followed by the bytes.
+ *
+ *   file     := "CJCOL001" case* index trailer
+ *   case     := str id, u8 passed, f64 max[7] (deltaE, l, a, b, r, g, b),
+ *               engine canonical, engine alternate,
+ *               u32 n, f64 column[7][n] (dl, da, db, deltaE, dr, dg, db_rgb)
+ *   engine   := str name, f64 durationMs, str commit, str buildFlags,
+ *               str platform, u32 n, f64 column[6][n] (l, a, b, r, g, b)
+ *   index    := u64 count, { str id, u64 offset, u8 passed, f64 maxDeltaE }*
+ *   trailer  := u64 index offset, "CJIDX001"
+ *
+ * Sample i always pairs colors[i] of both engines, so sample colors are not
+ * stored twice. `parity-runner dump` renders any case back to the same JSON
+ * that --artifact-format json writes.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cJSON.h"
+#include "types.h"
+
+#define COLUMNAR_MAGIC "CJCOL001"
+#define COLUMNAR_INDEX_MAGIC "CJIDX001"
+#define COLUMNAR_MAGIC_LENGTH 8
+#define COLUMNAR_NULL_STRING 0xFFFFFFFFu
+#define COLUMNAR_MAX_COLUMN_LENGTH (1u << 28)
+
+static void set_error(ValidationError *error, const char *message) {
+    if (!error || !message) {
+        return;
+    }
+    free(error->message);
+    size_t len = strlen(message);
+    error->message = (char *)malloc(len + 1);
+    if (error->message) {
+        memcpy(error->message, message, len + 1);
+    }
+}
+
+/* Writers return 0 or -1 like the readers below so a short write (e.g. a full
+ * disk) is reported instead of leaving a truncated artifact behind. */
+static int put_bytes(FILE *file, const void *value, size_t length) {
+    return fwrite(value, 1, length, file) == length ? 0 : -1;
+}
+
+static int put_u8(FILE *file, uint8_t value) {
+    return put_bytes(file, &value, 1);
+}
+
+static int put_u32(FILE *file, uint32_t value) {
+    unsigned char bytes[4];
+    for (int i = 0; i < 4; ++i) {
+        bytes[i] = (unsigned char)(value >> (8 * i));
+    }
+    return put_bytes(file, bytes, sizeof(bytes));
+}
+
+static int put_u64(FILE *file, uint64_t value) {
+    unsigned char bytes[8];
+    for (int i = 0; i < 8; ++i) {
+        bytes[i] = (unsigned char)(value >> (8 * i));
+    }
+    return put_bytes(file, bytes, sizeof(bytes));
+}
+
+static int put_f64(FILE *file, double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return put_u64(file, bits);
+}
+
+static int put_string(FILE *file, const char *value) {
+    if (!value) {
+        return put_u32(file, COLUMNAR_NULL_STRING);
+    }
+    const size_t length = strlen(value);
+    if (put_u32(file, (uint32_t)length) != 0) {
+        return -1;
+    }
+    return put_bytes(file, value, length);
+}
+
+static int get_bytes(FILE *file, void *out, size_t length) {
+    return fread(out, 1, length, file) == length ? 0 : -1;
+}
+
+static int get_u8(FILE *file, uint8_t *out) {
+    return get_bytes(file, out, 1);
+}
+
+static int get_u32(FILE *file, uint32_t *out) {
+    unsigned char bytes[4];
+    if (get_bytes(file, bytes, sizeof(bytes)) != 0) {
+        return -1;
+    }
+    *out = 0;
+    for (int i = 0; i < 4; ++i) {
+        *out |= (uint32_t)bytes[i] << (8 * i);
+    }
+    return 0;
+}
+
+static int get_u64(FILE *file, uint64_t *out) {
+    unsigned char bytes[8];
+    if (get_bytes(file, bytes, sizeof(bytes)) != 0) {
+        return -1;
+    }
+    *out = 0;
+    for (int i = 0; i < 8; ++i) {
+        *out |= (uint64_t)bytes[i] << (8 * i);
+    }
+    return 0;
+}
+
+static int get_f64(FILE *file, double *out) {
+    uint64_t bits;
+    if (get_u64(file, &bits) != 0) {
+        return -1;
+    }
+    memcpy(out, &bits, sizeof(bits));
+    return 0;
+}
+
+/* Reads a string into a malloc'd buffer; absent strings yield NULL. */
+static int get_string(FILE *file, char **out) {
+    uint32_t length;
+    *out = NULL;
+    if (get_u32(file, &length) != 0) {
+        return -1;
+    }
+    if (length == COLUMNAR_NULL_STRING) {
+        return 0;
+    }
+    if (length > COLUMNAR_MAX_COLUMN_LENGTH) {
+        return -1;
+    }
+    *out = (char *)malloc((size_t)length + 1);
+    if (!*out || get_bytes(file, *out, length) != 0) {
+        free(*out);
+        *out = NULL;
+        return -1;
+    }
+    (*out)[length] = '\0';
+    return 0;
+}
+
+static int get_string_into(FILE *file, char *out, size_t capacity) {
+    char *value = NULL;
+    if (get_string(file, &value) != 0) {
+        return -1;
+    }
+    memset(out, 0, capacity);
+    if (value) {
+        strncpy(out, value, capacity - 1);
+    }
+    free(value);
+    return 0;
+}
+
+static int write_engine_block(FILE *file, const EngineOutput *output) {
+    int status = 0;
+    status |= put_string(file, output->engine);
+    status |= put_f64(file, output->duration_ms);
+    status |= put_string(file, output->commit);
+    status |= put_string(file, output->build_flags);
+    status |= put_string(file, output->platform);
+
+    const size_t n = output->color_count;
+    status |= put_u32(file, (uint32_t)n);
+    for (size_t i = 0; i < n; ++i) status |= put_f64(file, output->colors[i].oklab.l);
+    for (size_t i = 0; i < n; ++i) status |= put_f64(file, output->colors[i].oklab.a);
+    for (size_t i = 0; i < n; ++i) status |= put_f64(file, output->colors[i].oklab.b);
+    for (size_t i = 0; i < n; ++i) status |= put_f64(file, output->colors[i].srgb.r);
+    for (size_t i = 0; i < n; ++i) status |= put_f64(file, output->colors[i].srgb.g);
+    for (size_t i = 0; i < n; ++i) status |= put_f64(file, output->colors[i].srgb.b);
+    return status == 0 ? 0 : -1;
+}
+
+static int read_engine_block(FILE *file, EngineOutput *output) {
+    memset(output, 0, sizeof(EngineOutput));
+    uint32_t n;
+    if (get_string_into(file, output->engine, sizeof(output->engine)) != 0 ||
+        get_f64(file, &output->duration_ms) != 0 ||
+        get_string(file, &output->commit) != 0 ||
+        get_string(file, &output->build_flags) != 0 ||
+        get_string(file, &output->platform) != 0 ||
+        get_u32(file, &n) != 0 || n > COLUMNAR_MAX_COLUMN_LENGTH) {
+        return -1;
+    }
+    output->color_count = n;
+    if (n == 0) {
+        return 0;
+    }
+    output->colors = (EngineColor *)calloc(n, sizeof(EngineColor));
+    if (!output->colors) {
+        return -1;
+    }
+    int status = 0;
+    for (uint32_t i = 0; i < n; ++i) status |= get_f64(file, &output->colors[i].oklab.l);
+    for (uint32_t i = 0; i < n; ++i) status |= get_f64(file, &output->colors[i].oklab.a);
+    for (uint32_t i = 0; i < n; ++i) status |= get_f64(file, &output->colors[i].oklab.b);
+    for (uint32_t i = 0; i < n; ++i) status |= get_f64(file, &output->colors[i].srgb.r);
+    for (uint32_t i = 0; i < n; ++i) status |= get_f64(file, &output->colors[i].srgb.g);
+    for (uint32_t i = 0; i < n; ++i) status |= get_f64(file, &output->colors[i].srgb.b);
+    return status == 0 ? 0 : -1;
+}
+
+int open_columnar_artifact(const char *artifacts_root, ColumnarWriter *writer, ValidationError *error) {
+    if (!artifacts_root || !writer) {
+        set_error(error, "invalid columnar artifact arguments");
+        return -1;
+    }
+    memset(writer, 0, sizeof(ColumnarWriter));
+    if (ensure_directory(artifacts_root, error) != 0) {
+        return -1;
+    }
+
+    char path[MAX_PATH_LENGTH + 16];
+    snprintf(path, sizeof(path), "%s/%s", artifacts_root, COLUMNAR_ARTIFACT_NAME);
+    writer->file = fopen(path, "wb");
+    if (!writer->file) {
+        set_error(error, "failed to create columnar artifact");
+        return -1;
+    }
+    /* The index is staged on disk so writer memory does not grow per case. */
+    writer->index = tmpfile();
+    if (!writer->index) {
+        fclose(writer->file);
+        writer->file = NULL;
+        set_error(error, "failed to create columnar index staging file");
+        return -1;
+    }
+    if (put_bytes(writer->file, COLUMNAR_MAGIC, COLUMNAR_MAGIC_LENGTH) != 0) {
+        fclose(writer->file);
+        fclose(writer->index);
+        writer->file = NULL;
+        writer->index = NULL;
+        set_error(error, "failed to write columnar artifact header");
+        return -1;
+    }
+    return 0;
+}
+
+int append_columnar_case(ColumnarWriter *writer,
+                         const EngineOutput *canonical,
+                         const EngineOutput *alternate,
+                         const ComparisonResult *result,
+                         ValidationError *error) {
+    if (!writer || !writer->file || !writer->index || !canonical || !alternate || !result) {
+        set_error(error, "invalid columnar case arguments");
+        return -1;
+    }
+
+    FILE *file = writer->file;
+    ColumnarIndexEntry entry;
+    memset(&entry, 0, sizeof(ColumnarIndexEntry));
+    strncpy(entry.input_case_id, result->input_case_id, sizeof(entry.input_case_id) - 1);
+    entry.offset = (uint64_t)ftell(file);
+    entry.passed = result->passed ? 1 : 0;
+    entry.max_delta_e = result->max_delta_e;
+    entry.sample_count = result->sample_count;
+
+    int status = 0;
+    status |= put_string(file, result->input_case_id);
+    status |= put_u8(file, (uint8_t)entry.passed);
+    status |= put_f64(file, result->max_delta_e);
+    status |= put_f64(file, result->max_l);
+    status |= put_f64(file, result->max_a);
+    status |= put_f64(file, result->max_b);
+    status |= put_f64(file, result->max_rgb_r);
+    status |= put_f64(file, result->max_rgb_g);
+    status |= put_f64(file, result->max_rgb_b);
+
+    status |= write_engine_block(file, canonical);
+    status |= write_engine_block(file, alternate);
+
+    const size_t n = result->sample_count;
+    status |= put_u32(file, (uint32_t)n);
+    for (size_t i = 0; i < n; ++i) status |= put_f64(file, result->samples[i].delta.l);
+    for (size_t i = 0; i < n; ++i) status |= put_f64(file, result->samples[i].delta.a);
+    for (size_t i = 0; i < n; ++i) status |= put_f64(file, result->samples[i].delta.b);
+    for (size_t i = 0; i < n; ++i) status |= put_f64(file, result->samples[i].delta.deltaE);
+    for (size_t i = 0; i < n; ++i) status |= put_f64(file, result->samples[i].rgb_delta.r);
+    for (size_t i = 0; i < n; ++i) status |= put_f64(file, result->samples[i].rgb_delta.g);
+    for (size_t i = 0; i < n; ++i) status |= put_f64(file, result->samples[i].rgb_delta.b);
+
+    if (status != 0 || ferror(file) || fwrite(&entry, sizeof(ColumnarIndexEntry), 1, writer->index) != 1) {
+        set_error(error, "failed to write columnar case");
+        return -1;
+    }
+    writer->entry_count++;
+    return 0;
+}
+
+int finish_columnar_artifact(ColumnarWriter *writer, ValidationError *error) {
+    if (!writer || !writer->file) {
+        set_error(error, "columnar artifact is not open");
+        return -1;
+    }
+
+    FILE *file = writer->file;
+    const uint64_t index_offset = (uint64_t)ftell(file);
+    int status = put_u64(file, (uint64_t)writer->entry_count);
+    if (writer->index) {
+        rewind(writer->index);
+    }
+    for (size_t i = 0; i < writer->entry_count; ++i) {
+        ColumnarIndexEntry entry;
+        if (!writer->index || fread(&entry, sizeof(ColumnarIndexEntry), 1, writer->index) != 1) {
+            status = -1;
+            break;
+        }
+        status |= put_string(file, entry.input_case_id);
+        status |= put_u64(file, entry.offset);
+        status |= put_u8(file, (uint8_t)entry.passed);
+        status |= put_f64(file, entry.max_delta_e);
+    }
+    status |= put_u64(file, index_offset);
+    status |= put_bytes(file, COLUMNAR_INDEX_MAGIC, COLUMNAR_MAGIC_LENGTH);
+
+    if (ferror(file)) {
+        status = -1;
+    }
+    if (fclose(file) != 0) {
+        status = -1;
+    }
+    writer->file = NULL;
+    if (writer->index) {
+        fclose(writer->index);
+        writer->index = NULL;
+    }
+    writer->entry_count = 0;
+
+    if (status != 0) {
+        set_error(error, "failed to finalize columnar artifact");
+    }
+    return status;
+}
+
+int open_columnar_reader(const char *path, ColumnarReader *reader, ValidationError *error) {
+    if (!path || !reader) {
+        set_error(error, "invalid columnar reader arguments");
+        return -1;
+    }
+    memset(reader, 0, sizeof(ColumnarReader));
+    reader->file = fopen(path, "rb");
+    if (!reader->file) {
+        set_error(error, "failed to open columnar artifact");
+        return -1;
+    }
+
+    char magic[COLUMNAR_MAGIC_LENGTH];
+    uint64_t index_offset = 0;
+    uint64_t count = 0;
+    if (get_bytes(reader->file, magic, sizeof(magic)) != 0 ||
+        memcmp(magic, COLUMNAR_MAGIC, COLUMNAR_MAGIC_LENGTH) != 0 ||
+        fseek(reader->file, -(long)(8 + COLUMNAR_MAGIC_LENGTH), SEEK_END) != 0 ||
+        get_u64(reader->file, &index_offset) != 0 ||
+        get_bytes(reader->file, magic, sizeof(magic)) != 0 ||
+        memcmp(magic, COLUMNAR_INDEX_MAGIC, COLUMNAR_MAGIC_LENGTH) != 0 ||
+        fseek(reader->file, (long)index_offset, SEEK_SET) != 0 ||
+        get_u64(reader->file, &count) != 0 ||
+        count > COLUMNAR_MAX_COLUMN_LENGTH) {
+        close_columnar_reader(reader);
+        set_error(error, "not a columnar parity artifact or truncated index");
+        return -1;
+    }
+
+    if (count > 0) {
+        reader->entries = (ColumnarIndexEntry *)calloc((size_t)count, sizeof(ColumnarIndexEntry));
+        if (!reader->entries) {
+            close_columnar_reader(reader);
+            set_error(error, "failed to allocate columnar index");
+            return -1;
+        }
+    }
+    for (uint64_t i = 0; i < count; ++i) {
+        ColumnarIndexEntry *entry = &reader->entries[i];
+        uint8_t passed;
+        if (get_string_into(reader->file, entry->input_case_id, sizeof(entry->input_case_id)) != 0 ||
+            get_u64(reader->file, &entry->offset) != 0 ||
+            get_u8(reader->file, &passed) != 0 ||
+            get_f64(reader->file, &entry->max_delta_e) != 0) {
+            close_columnar_reader(reader);
+            set_error(error, "truncated columnar index");
+            return -1;
+        }
+        entry->passed = passed;
+        reader->entry_count++;
+    }
+    return 0;
+}
+
+static int read_case_block(FILE *file,
+                           uint64_t offset,
+                           EngineOutput *canonical,
+                           EngineOutput *alternate,
+                           ComparisonResult *result) {
+    uint8_t passed;
+    uint32_t n;
+    if (fseek(file, (long)offset, SEEK_SET) != 0 ||
+        get_string_into(file, result->input_case_id, sizeof(result->input_case_id)) != 0 ||
+        get_u8(file, &passed) != 0 ||
+        get_f64(file, &result->max_delta_e) != 0 ||
+        get_f64(file, &result->max_l) != 0 ||
+        get_f64(file, &result->max_a) != 0 ||
+        get_f64(file, &result->max_b) != 0 ||
+        get_f64(file, &result->max_rgb_r) != 0 ||
+        get_f64(file, &result->max_rgb_g) != 0 ||
+        get_f64(file, &result->max_rgb_b) != 0 ||
+        read_engine_block(file, canonical) != 0 ||
+        read_engine_block(file, alternate) != 0 ||
+        get_u32(file, &n) != 0 ||
+        n > canonical->color_count || n > alternate->color_count) {
+        return -1;
+    }
+    result->passed = passed;
+    if (n == 0) {
+        return 0;
+    }
+
+    result->samples = (SampleDelta *)calloc(n, sizeof(SampleDelta));
+    if (!result->samples) {
+        return -1;
+    }
+    result->sample_count = n;
+    int status = 0;
+    for (uint32_t i = 0; i < n; ++i) {
+        result->samples[i].index = i;
+        result->samples[i].canonical = canonical->colors[i];
+        result->samples[i].alternate = alternate->colors[i];
+    }
+    for (uint32_t i = 0; i < n; ++i) status |= get_f64(file, &result->samples[i].delta.l);
+    for (uint32_t i = 0; i < n; ++i) status |= get_f64(file, &result->samples[i].delta.a);
+    for (uint32_t i = 0; i < n; ++i) status |= get_f64(file, &result->samples[i].delta.b);
+    for (uint32_t i = 0; i < n; ++i) status |= get_f64(file, &result->samples[i].delta.deltaE);
+    for (uint32_t i = 0; i < n; ++i) status |= get_f64(file, &result->samples[i].rgb_delta.r);
+    for (uint32_t i = 0; i < n; ++i) status |= get_f64(file, &result->samples[i].rgb_delta.g);
+    for (uint32_t i = 0; i < n; ++i) status |= get_f64(file, &result->samples[i].rgb_delta.b);
+    return status == 0 ? 0 : -1;
+}
+
+int read_columnar_case(ColumnarReader *reader,
+                       size_t entry_index,
+                       EngineOutput *canonical,
+                       EngineOutput *alternate,
+                       ComparisonResult *result,
+                       ValidationError *error) {
+    if (!reader || !reader->file || entry_index >= reader->entry_count ||
+        !canonical || !alternate || !result) {
+        set_error(error, "invalid columnar case lookup");
+        return -1;
+    }
+    memset(canonical, 0, sizeof(EngineOutput));
+    memset(alternate, 0, sizeof(EngineOutput));
+    memset(result, 0, sizeof(ComparisonResult));
+
+    if (read_case_block(reader->file, reader->entries[entry_index].offset, canonical, alternate, result) != 0) {
+        free_engine_output(canonical);
+        free_engine_output(alternate);
+        free_comparison_result(result);
+        set_error(error, "corrupt columnar case block");
+        return -1;
+    }
+    return 0;
+}
+
+void close_columnar_reader(ColumnarReader *reader) {
+    if (!reader) {
+        return;
+    }
+    if (reader->file) {
+        fclose(reader->file);
+    }
+    free(reader->entries);
+    memset(reader, 0, sizeof(ColumnarReader));
+}
+
+static int print_rendered(FILE *out, char *rendered) {
+    if (!rendered) {
+        return -1;
+    }
+    fprintf(out, "%s", rendered);
+    free(rendered);
+    return 0;
+}
+
+int dump_columnar_artifact(const char *path,
+                           const char *case_id,
+                           const char *part,
+                           FILE *out,
+                           ValidationError *error) {
+    ColumnarReader reader;
+    if (open_columnar_reader(path, &reader, error) != 0) {
+        return -1;
+    }
+
+    if (!case_id) {
+        cJSON *root = cJSON_CreateObject();
+        cJSON_AddStringToObject(root, "format", "cjcol");
+        cJSON *cases = cJSON_AddArrayToObject(root, "cases");
+        for (size_t i = 0; i < reader.entry_count; ++i) {
+            const ColumnarIndexEntry *entry = &reader.entries[i];
+            cJSON *node = cJSON_CreateObject();
+            cJSON_AddStringToObject(node, "inputCaseId", entry->input_case_id);
+            cJSON_AddBoolToObject(node, "passed", entry->passed ? 1 : 0);
+            cJSON_AddNumberToObject(node, "maxDeltaE", entry->max_delta_e);
+            cJSON_AddItemToArray(cases, node);
+        }
+        int status = print_rendered(out, cJSON_PrintUnformatted(root));
+        fprintf(out, "\n");
+        cJSON_Delete(root);
+        close_columnar_reader(&reader);
+        if (status != 0) {
+            set_error(error, "failed to render columnar index");
+        }
+        return status;
+    }
+
+    size_t entry_index = reader.entry_count;
+    for (size_t i = 0; i < reader.entry_count; ++i) {
+        if (strcmp(reader.entries[i].input_case_id, case_id) == 0) {
+            entry_index = i;
+            break;
+        }
+    }
+    if (entry_index == reader.entry_count) {
+        close_columnar_reader(&reader);
+        set_error(error, "case not found in columnar artifact");
+        return -1;
+    }
+
+    EngineOutput canonical;
+    EngineOutput alternate;
+    ComparisonResult result;
+    if (read_columnar_case(&reader, entry_index, &canonical, &alternate, &result, error) != 0) {
+        close_columnar_reader(&reader);
+        return -1;
+    }
+
+    int status = 0;
+    if (part && strcmp(part, "canonical") == 0) {
+        status = print_rendered(out, render_engine_output_json(&canonical));
+    } else if (part && strcmp(part, "alternate") == 0) {
+        status = print_rendered(out, render_engine_output_json(&alternate));
+    } else if (part && strcmp(part, "diff") == 0) {
+        status = print_rendered(out, render_comparison_json(&result));
+    } else {
+        fprintf(out, "{\"canonical\":");
+        status |= print_rendered(out, render_engine_output_json(&canonical));
+        fprintf(out, ",\"alternate\":");
+        status |= print_rendered(out, render_engine_output_json(&alternate));
+        fprintf(out, ",\"diff\":");
+        status |= print_rendered(out, render_comparison_json(&result));
+        fprintf(out, "}");
+    }
+    fprintf(out, "\n");
+    if (status != 0) {
+        set_error(error, "failed to render case JSON");
+    }
+
+    free_engine_output(&canonical);
+    free_engine_output(&alternate);
+    free_comparison_result(&result);
+    close_columnar_reader(&reader);
+    return status;
+}
@@ -0,0 +1,171 @@
+/*
+ * Seeded corpus generator for scale and performance runs.
+ *
+ * Emits a JSON Lines corpus (header line, then one case per line) that
+ * open_corpus_stream() reads incrementally, so `generate | parity-runner
+ * --corpus -` never holds more than one case in memory. Case i depends only
+ * on (seed, i): any slice can be regenerated on its own with --first.
+ *
+ * Coverage is structured rather than purely random: anchor counts cycle
+ * 1-8, loop modes advance every 8 cases, and each block of 24 cases takes
+ * the next profile (typical, contrast extremes, variation extremes, boundary
+ * anchors), so any 96 consecutive cases hit every combination.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "types.h"
+
+#define GENERATOR_MAX_ANCHORS 8
+#define GENERATOR_LOOP_MODES 3
+#define GENERATOR_PROFILES 4
+
+typedef enum {
+    GENERATOR_PROFILE_TYPICAL,
+    GENERATOR_PROFILE_CONTRAST,
+    GENERATOR_PROFILE_VARIATION,
+    GENERATOR_PROFILE_BOUNDARY
+} GeneratorProfile;
+
+static const char *const loop_modes[GENERATOR_LOOP_MODES] = {"open", "closed", "pingpong"};
+static const char *const profile_tags[GENERATOR_PROFILES] = {"typical", "contrast-extreme", "variation-extreme", "boundary"};
+
+static void set_error(ValidationError *error, const char *message) {
+    if (!error || !message) {
+        return;
+    }
+    free(error->message);
+    size_t len = strlen(message);
+    error->message = (char *)malloc(len + 1);
+    if (error->message) {
+        memcpy(error->message, message, len + 1);
+    }
+}
+
+static uint64_t splitmix64(uint64_t *state) {
+    uint64_t z = (*state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+static double uniform(uint64_t *state, double min_value, double max_value) {
+    const double unit = (double)(splitmix64(state) >> 11) * (1.0 / 9007199254740992.0);
+    return min_value + unit * (max_value - min_value);
+}
+
+static uint64_t below(uint64_t *state, uint64_t bound) {
+    return splitmix64(state) % bound;
+}
+
+/* Seeds stay below 2^53 so they survive the double round-trip through cJSON. */
+static uint64_t json_safe_seed(uint64_t *state) {
+    return splitmix64(state) & ((1ULL << 53) - 1);
+}
+
+static void write_anchor(FILE *out, uint64_t *state, GeneratorProfile profile) {
+    static const double rgb_edges[] = {0.0, 1.0, 1e-6, 0.999999, 0.5};
+    if (profile == GENERATOR_PROFILE_BOUNDARY) {
+        /* Gamut corners and near-black/near-white values stress clamping. */
+        fprintf(out, "{\"rgb\":{\"r\":%.17g,\"g\":%.17g,\"b\":%.17g}}",
+                rgb_edges[below(state, 5)], rgb_edges[below(state, 5)], rgb_edges[below(state, 5)]);
+    } else if (below(state, 2) == 0) {
+        fprintf(out, "{\"oklab\":{\"l\":%.17g,\"a\":%.17g,\"b\":%.17g}}",
+                uniform(state, 0.0, 1.0), uniform(state, -0.4, 0.4), uniform(state, -0.4, 0.4));
+    } else {
+        fprintf(out, "{\"rgb\":{\"r\":%.17g,\"g\":%.17g,\"b\":%.17g}}",
+                uniform(state, 0.0, 1.0), uniform(state, 0.0, 1.0), uniform(state, 0.0, 1.0));
+    }
+}
+
+static void write_case(FILE *out, const GeneratorOptions *options, uint64_t index) {
+    uint64_t state = options->seed ^ (index * 0xd1b54a32d192ed03ULL);
+    splitmix64(&state);
+
+    const size_t anchor_count = 1 + (size_t)(index % GENERATOR_MAX_ANCHORS);
+    const char *loop_mode = loop_modes[(index / GENERATOR_MAX_ANCHORS) % GENERATOR_LOOP_MODES];
+    const GeneratorProfile profile = (GeneratorProfile)((index / (GENERATOR_MAX_ANCHORS * GENERATOR_LOOP_MODES)) % GENERATOR_PROFILES);
+
+    uint32_t count = (uint32_t)(2 + below(&state, 31));
+    if (below(&state, 16) == 0) {
+        count = (uint32_t)(64 + below(&state, 193));
+    } else if (below(&state, 32) == 0) {
+        count = 1;
+    }
+
+    double lightness = uniform(&state, -1.0, 1.0);
+    double chroma = uniform(&state, 0.5, 2.0);
+    double contrast = uniform(&state, 0.02, 0.15);
+    double vibrancy = uniform(&state, 0.0, 1.0);
+    double temperature = uniform(&state, -1.0, 1.0);
+    int has_variation_seed = below(&state, 2) == 0;
+    uint64_t variation_seed = json_safe_seed(&state);
+
+    switch (profile) {
+    case GENERATOR_PROFILE_CONTRAST:
+        /* Thresholds high enough to exhaust enforce_delta_range's search. */
+        contrast = below(&state, 2) == 0 ? uniform(&state, 0.3, 0.6) : 0.001;
+        count = (uint32_t)(16 + below(&state, 241));
+        break;
+    case GENERATOR_PROFILE_VARIATION:
+        has_variation_seed = 1;
+        variation_seed = below(&state, 2) == 0 ? 0 : ((1ULL << 53) - 1);
+        vibrancy = below(&state, 2) == 0 ? 0.0 : 1.0;
+        chroma = below(&state, 2) == 0 ? 0.5 : 2.0;
+        break;
+    case GENERATOR_PROFILE_BOUNDARY:
+        lightness = below(&state, 2) == 0 ? -1.0 : 1.0;
+        temperature = below(&state, 3) == 0 ? 0.0 : temperature;
+        break;
+    case GENERATOR_PROFILE_TYPICAL:
+        break;
+    }
+
+    fprintf(out, "{\"id\":\"gen-%llu-%llu\",\"tags\":[\"generated\",\"anchors-%zu\",\"%s\",\"%s\"],\"anchors\":[",
+            (unsigned long long)options->seed, (unsigned long long)index, anchor_count, loop_mode, profile_tags[profile]);
+    for (size_t a = 0; a < anchor_count; ++a) {
+        if (a > 0) {
+            fputc(',', out);
+        }
+        write_anchor(out, &state, profile);
+    }
+    fprintf(out, "],\"config\":{\"count\":%u,\"lightness\":%.17g,\"chroma\":%.17g,\"contrast\":%.17g,"
+                 "\"vibrancy\":%.17g,\"temperature\":%.17g,\"loopMode\":\"%s\"",
+            count, lightness, chroma, contrast, vibrancy, temperature, loop_mode);
+    if (has_variation_seed) {
+        fprintf(out, ",\"variationSeed\":%llu", (unsigned long long)variation_seed);
+    }
+    fprintf(out, "},\"seed\":%llu,\"corpusVersion\":\"%s\"}\n",
+            (unsigned long long)json_safe_seed(&state), options->corpus_version);
+}
+
+int write_generated_corpus(FILE *out, const GeneratorOptions *options, ValidationError *error) {
+    if (!out || !options || !options->corpus_version) {
+        set_error(error, "invalid generator arguments");
+        return -1;
+    }
+    if (!validate_corpus_version(options->corpus_version)) {
+        set_error(error, "corpus version must match vYYYYMMDD.n");
+        return -1;
+    }
+
+    fprintf(out, "{\"corpusVersion\":\"%s\",\"description\":\"Generated corpus: seed %llu, %llu cases from index %llu\"}\n",
+            options->corpus_version,
+            (unsigned long long)options->seed,
+            (unsigned long long)options->case_count,
+            (unsigned long long)options->first_case);
+    for (size_t i = 0; i < options->case_count; ++i) {
+        write_case(out, options, (uint64_t)(options->first_case + i));
+        if (ferror(out)) {
+            set_error(error, "failed to write generated corpus");
+            return -1;
+        }
+    }
+    if (fflush(out) != 0) {
+        set_error(error, "failed to write generated corpus");
+        return -1;
+    }
+    return 0;
+}
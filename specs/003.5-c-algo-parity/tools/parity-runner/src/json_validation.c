@@ -211,7 +211,7 @@ static int parse_config(const cJSON *config_node, EngineConfig *config, Validati
     return 0;
 }
 
-static void free_input_case(InputCase *input_case) {
+void free_input_case(InputCase *input_case) {
     if (!input_case) {
         return;
     }
@@ -296,64 +296,394 @@ fail:
     return -1;
 }
 
-int parse_corpus_file(const char *path, Corpus *out, ValidationError *error) {
-    if (!path || !out) {
+/* Upper bound on the compacted JSON text of a single input case. */
+#define MAX_CASE_TEXT_BYTES (64u * 1024u * 1024u)
+
+static int is_json_whitespace(int ch) {
+    return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r';
+}
+
+static int stream_skip_whitespace(CorpusStream *stream) {
+    int ch;
+    do {
+        ch = getc(stream->file);
+    } while (ch != EOF && is_json_whitespace(ch));
+    return ch;
+}
+
+static int stream_append(CorpusStream *stream, char ch, ValidationError *error) {
+    if (stream->text_length + 2 > stream->text_capacity) {
+        if (stream->text_capacity >= MAX_CASE_TEXT_BYTES) {
+            set_error(error, "corpus case exceeds maximum size");
+            return -1;
+        }
+        size_t capacity = stream->text_capacity ? stream->text_capacity * 2 : 4096;
+        char *tmp = (char *)realloc(stream->text, capacity);
+        if (!tmp) {
+            set_error(error, "failed to grow corpus case buffer");
+            return -1;
+        }
+        stream->text = tmp;
+        stream->text_capacity = capacity;
+    }
+    stream->text[stream->text_length++] = ch;
+    stream->text[stream->text_length] = '\0';
+    return 0;
+}
+
+/*
+ * Capture one JSON value (starting with the already-consumed character
+ * `first`) into stream->text, dropping insignificant whitespace so the
+ * captured text is a single line. Only the bytes of the current value are
+ * ever held in memory.
+ */
+static int stream_capture_value(CorpusStream *stream, int first, ValidationError *error) {
+    stream->text_length = 0;
+    if (first == EOF) {
+        set_error(error, "unexpected end of corpus");
+        return -1;
+    }
+
+    if (first != '{' && first != '[' && first != '"') {
+        int ch = first;
+        while (ch != EOF && ch != ',' && ch != '}' && ch != ']' && !is_json_whitespace(ch)) {
+            if (stream_append(stream, (char)ch, error) != 0) {
+                return -1;
+            }
+            ch = getc(stream->file);
+        }
+        if (ch != EOF) {
+            ungetc(ch, stream->file);
+        }
+        return 0;
+    }
+
+    int depth = 0;
+    int in_string = 0;
+    int escaped = 0;
+    int ch = first;
+    for (;;) {
+        if (in_string) {
+            if (escaped) {
+                escaped = 0;
+            } else if (ch == '\\') {
+                escaped = 1;
+            } else if (ch == '"') {
+                in_string = 0;
+            }
+        } else if (ch == '"') {
+            in_string = 1;
+        } else if (ch == '{' || ch == '[') {
+            depth++;
+        } else if (ch == '}' || ch == ']') {
+            depth--;
+        } else if (is_json_whitespace(ch)) {
+            ch = getc(stream->file);
+            continue;
+        }
+
+        if (stream_append(stream, (char)ch, error) != 0) {
+            return -1;
+        }
+        if (!in_string && depth == 0) {
+            return 0;
+        }
+        ch = getc(stream->file);
+        if (ch == EOF) {
+            set_error(error, "unexpected end of corpus");
+            return -1;
+        }
+    }
+}
+
+/* Parse the captured value as a JSON string; returns a malloc'd copy. */
+static char *stream_text_as_string(const CorpusStream *stream) {
+    cJSON *node = cJSON_Parse(stream->text);
+    char *value = NULL;
+    if (cJSON_IsString(node) && node->valuestring) {
+        value = strdup(node->valuestring);
+    }
+    cJSON_Delete(node);
+    return value;
+}
+
+static int stream_set_corpus_version(CorpusStream *stream, const char *version, ValidationError *error) {
+    if (!validate_corpus_version(version)) {
+        set_error(error, "corpusVersion must match vYYYYMMDD.n");
+        return -1;
+    }
+    strncpy(stream->corpus_version, version, MAX_VERSION_LENGTH - 1);
+    return 0;
+}
+
+/* Consume the document header up to and including the opening '[' of "cases". */
+static int stream_open_document(CorpusStream *stream, ValidationError *error) {
+    if (stream_skip_whitespace(stream) != '{') {
+        set_error(error, "failed to parse corpus JSON");
+        return -1;
+    }
+    for (;;) {
+        int ch = stream_skip_whitespace(stream);
+        if (ch == ',') {
+            ch = stream_skip_whitespace(stream);
+        }
+        if (ch == '}' || ch == EOF) {
+            set_error(error, "cases must be a non-empty array");
+            return -1;
+        }
+        if (ch != '"' || stream_capture_value(stream, ch, error) != 0) {
+            set_error(error, "failed to parse corpus JSON");
+            return -1;
+        }
+        char *key = stream_text_as_string(stream);
+        if (!key || stream_skip_whitespace(stream) != ':') {
+            free(key);
+            set_error(error, "failed to parse corpus JSON");
+            return -1;
+        }
+
+        ch = stream_skip_whitespace(stream);
+        if (strcmp(key, "cases") == 0) {
+            free(key);
+            if (ch != '[') {
+                set_error(error, "cases must be a non-empty array");
+                return -1;
+            }
+            /* Cases are streamed, so the version has to be known up front. */
+            if (stream->corpus_version[0] == '\0') {
+                set_error(error, "corpusVersion must match vYYYYMMDD.n");
+                return -1;
+            }
+            return 0;
+        }
+
+        if (stream_capture_value(stream, ch, error) != 0) {
+            free(key);
+            return -1;
+        }
+        if (strcmp(key, "corpusVersion") == 0) {
+            char *version = stream_text_as_string(stream);
+            int status = stream_set_corpus_version(stream, version, error);
+            free(version);
+            if (status != 0) {
+                free(key);
+                return -1;
+            }
+        } else if (strcmp(key, "description") == 0) {
+            free(stream->description);
+            stream->description = stream_text_as_string(stream);
+        }
+        free(key);
+    }
+}
+
+/*
+ * JSON Lines corpora hold one input case per line, optionally preceded by a
+ * header object carrying corpusVersion/description (recognised by the
+ * absence of an "id"). Without a header the first case supplies the version.
+ */
+static int stream_open_json_lines(CorpusStream *stream, ValidationError *error) {
+    int ch = stream_skip_whitespace(stream);
+    if (ch == EOF) {
+        set_error(error, "cases must be a non-empty array");
+        return -1;
+    }
+    if (stream_capture_value(stream, ch, error) != 0) {
+        return -1;
+    }
+    cJSON *first = cJSON_Parse(stream->text);
+    if (!cJSON_IsObject(first)) {
+        cJSON_Delete(first);
+        set_error(error, "failed to parse corpus JSON");
+        return -1;
+    }
+    const cJSON *version = cJSON_GetObjectItemCaseSensitive(first, "corpusVersion");
+    const cJSON *description = cJSON_GetObjectItemCaseSensitive(first, "description");
+    const int is_header = cJSON_GetObjectItemCaseSensitive(first, "id") == NULL;
+
+    int status = stream_set_corpus_version(stream, cJSON_IsString(version) ? version->valuestring : NULL, error);
+    if (status == 0 && is_header && cJSON_IsString(description) && description->valuestring) {
+        stream->description = strdup(description->valuestring);
+    }
+    cJSON_Delete(first);
+
+    /* A leading case stays in the buffer and is yielded by the first next call. */
+    stream->pending = !is_header;
+    return status;
+}
+
+static int has_suffix(const char *value, const char *suffix) {
+    const size_t value_len = strlen(value);
+    const size_t suffix_len = strlen(suffix);
+    return value_len >= suffix_len && strcmp(value + value_len - suffix_len, suffix) == 0;
+}
+
+int open_corpus_stream(const char *path, CorpusStream *stream, ValidationError *error) {
+    if (!path || !stream) {
         set_error(error, "invalid corpus arguments");
         return -1;
     }
-    long length = 0;
-    char *buffer = read_file_into_buffer(path, &length);
-    if (!buffer) {
+    memset(stream, 0, sizeof(CorpusStream));
+
+    if (strcmp(path, "-") == 0) {
+        stream->file = stdin;
+        stream->json_lines = 1;
+    } else {
+        stream->file = fopen(path, "rb");
+        stream->owns_file = 1;
+        stream->json_lines = has_suffix(path, ".jsonl") || has_suffix(path, ".ndjson");
+    }
+    if (!stream->file) {
         set_error(error, "failed to read corpus file");
         return -1;
     }
-    cJSON *root = cJSON_Parse(buffer);
-    free(buffer);
-    if (!root) {
+
+    int status = stream->json_lines ? stream_open_json_lines(stream, error)
+                                    : stream_open_document(stream, error);
+    if (status != 0) {
+        close_corpus_stream(stream);
+        return -1;
+    }
+    return 0;
+}
+
+int next_corpus_case(CorpusStream *stream, InputCase *out, ValidationError *error) {
+    if (!stream || !stream->file || !out) {
+        set_error(error, "invalid corpus stream arguments");
+        return -1;
+    }
+    if (stream->finished) {
+        return 0;
+    }
+
+    if (stream->pending) {
+        stream->pending = 0;
+    } else {
+        int ch = stream_skip_whitespace(stream);
+        if (ch == ',' && !stream->json_lines) {
+            ch = stream_skip_whitespace(stream);
+        }
+        if ((stream->json_lines && ch == EOF) || (!stream->json_lines && ch == ']')) {
+            stream->finished = 1;
+            if (stream->cases_read == 0) {
+                set_error(error, "cases must be a non-empty array");
+                return -1;
+            }
+            return 0;
+        }
+        if (stream_capture_value(stream, ch, error) != 0) {
+            return -1;
+        }
+    }
+
+    cJSON *node = cJSON_Parse(stream->text);
+    if (!node) {
         set_error(error, "failed to parse corpus JSON");
         return -1;
     }
-    memset(out, 0, sizeof(Corpus));
+    int status = parse_input_case(node, out, error);
+    cJSON_Delete(node);
+    if (status != 0) {
+        return -1;
+    }
+    stream->cases_read++;
+    return 1;
+}
 
-    const cJSON *corpus_version = cJSON_GetObjectItemCaseSensitive(root, "corpusVersion");
-    const cJSON *description = cJSON_GetObjectItemCaseSensitive(root, "description");
-    const cJSON *cases = cJSON_GetObjectItemCaseSensitive(root, "cases");
+void close_corpus_stream(CorpusStream *stream) {
+    if (!stream) {
+        return;
+    }
+    if (stream->file && stream->owns_file) {
+        fclose(stream->file);
+    }
+    free(stream->description);
+    free(stream->text);
+    memset(stream, 0, sizeof(CorpusStream));
+}
 
-    if (!validate_corpus_version(corpus_version ? corpus_version->valuestring : NULL)) {
-        set_error(error, "corpusVersion must match vYYYYMMDD.n");
-        cJSON_Delete(root);
+int write_current_case_file(const CorpusStream *stream, const char *path, ValidationError *error) {
+    if (!stream || !stream->text || !path) {
+        set_error(error, "invalid case file arguments");
+        return -1;
+    }
+    FILE *file = fopen(path, "wb");
+    if (!file) {
+        set_error(error, "failed to write case input file");
         return -1;
     }
-    strncpy(out->corpus_version, corpus_version->valuestring, MAX_VERSION_LENGTH - 1);
+    fwrite(stream->text, 1, stream->text_length, file);
+    fputc('\n', file);
+    if (fclose(file) != 0) {
+        set_error(error, "failed to write case input file");
+        return -1;
+    }
+    return 0;
+}
 
-    if (description && cJSON_IsString(description) && description->valuestring) {
-        out->description = strdup(description->valuestring);
+int find_corpus_case(const char *path, const char *case_id, InputCase *out, ValidationError *error) {
+    if (!case_id || !out) {
+        set_error(error, "invalid corpus arguments");
+        return -1;
+    }
+    CorpusStream stream;
+    if (open_corpus_stream(path, &stream, error) != 0) {
+        return -1;
+    }
+    int status;
+    while ((status = next_corpus_case(&stream, out, error)) == 1) {
+        if (strcmp(out->id, case_id) == 0) {
+            close_corpus_stream(&stream);
+            return 0;
+        }
+        free_input_case(out);
+    }
+    close_corpus_stream(&stream);
+    if (status == 0) {
+        set_error(error, "case not found in corpus");
     }
+    return -1;
+}
 
-    if (!cJSON_IsArray(cases) || cJSON_GetArraySize(cases) == 0) {
-        set_error(error, "cases must be a non-empty array");
-        cJSON_Delete(root);
+int parse_corpus_file(const char *path, Corpus *out, ValidationError *error) {
+    if (!path || !out) {
+        set_error(error, "invalid corpus arguments");
         return -1;
     }
+    memset(out, 0, sizeof(Corpus));
 
-    out->case_count = (size_t)cJSON_GetArraySize(cases);
-    out->cases = (InputCase *)calloc(out->case_count, sizeof(InputCase));
-    if (!out->cases) {
-        set_error(error, "failed to allocate cases");
-        cJSON_Delete(root);
+    CorpusStream stream;
+    if (open_corpus_stream(path, &stream, error) != 0) {
         return -1;
     }
-    for (size_t i = 0; i < out->case_count; ++i) {
-        const cJSON *case_node = cJSON_GetArrayItem(cases, (int)i);
-        if (parse_input_case(case_node, &out->cases[i], error) != 0) {
-            out->case_count = i + 1;
-            free_corpus(out);
-            cJSON_Delete(root);
-            return -1;
+    strncpy(out->corpus_version, stream.corpus_version, MAX_VERSION_LENGTH - 1);
+    if (stream.description) {
+        out->description = strdup(stream.description);
+    }
+
+    size_t capacity = 0;
+    InputCase input_case;
+    int status;
+    while ((status = next_corpus_case(&stream, &input_case, error)) == 1) {
+        if (out->case_count == capacity) {
+            capacity = capacity ? capacity * 2 : 16;
+            InputCase *tmp = (InputCase *)realloc(out->cases, capacity * sizeof(InputCase));
+            if (!tmp) {
+                free_input_case(&input_case);
+                set_error(error, "failed to allocate cases");
+                status = -1;
+                break;
+            }
+            out->cases = tmp;
         }
+        out->cases[out->case_count++] = input_case;
     }
+    close_corpus_stream(&stream);
 
-    cJSON_Delete(root);
+    if (status != 0) {
+        free_corpus(out);
+        return -1;
+    }
     return 0;
 }
 
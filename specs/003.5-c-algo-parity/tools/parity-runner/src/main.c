@@ -22,6 +22,19 @@ static const char *artifact_policy_to_string(ArtifactPolicy policy) {
     }
 }
 
+typedef enum {
+    ARTIFACT_FORMAT_JSON,
+    ARTIFACT_FORMAT_COLUMNAR
+} ArtifactFormat;
+
+static const char *artifact_format_to_string(ArtifactFormat format) {
+    switch (format) {
+        case ARTIFACT_FORMAT_JSON: return "json";
+        case ARTIFACT_FORMAT_COLUMNAR: return "columnar";
+        default: return "unknown";
+    }
+}
+
 static int case_has_tag(const InputCase *input_case, const char **tags, size_t tag_count) {
     if (!input_case || !tags || tag_count == 0) {
         return 1;
@@ -37,12 +50,139 @@ static int case_has_tag(const InputCase *input_case, const char **tags, size_t t
 }
 
 static void print_usage(void) {
-    printf("Usage: parity-runner --corpus <file> --tolerances <file> [--artifacts <dir>]\\n");
-    printf("       [--cases <id1,id2>] [--tags <tag1,tag2>] [--c-runner <path>] [--alt-runner <path>]\\n");
-    printf("       [--run-id <id>] [--c-commit <hash>] [--wasm-commit <hash>]\\n");
-    printf("       [--pass-gate <0-1>] [--max-duration-ms <ms>] [--platform <name>]\\n");
-    printf("       [--tolerance-deltaE <val>] [--tolerance-l <val>] [--tolerance-a <val>] [--tolerance-b <val>]\\n");
-    printf("       [--artifact-policy all|failures|none]\\n");
+    printf("Usage: parity-runner --corpus <file> --tolerances <file> [--artifacts <dir>]\n");
+    printf("       [--cases <id1,id2>] [--tags <tag1,tag2>] [--c-runner <path>] [--alt-runner <path>]\n");
+    printf("       [--run-id <id>] [--c-commit <hash>] [--wasm-commit <hash>]\n");
+    printf("       [--pass-gate <0-1>] [--max-duration-ms <ms>] [--platform <name>]\n");
+    printf("       [--tolerance-deltaE <val>] [--tolerance-l <val>] [--tolerance-a <val>] [--tolerance-b <val>]\n");
+    printf("       [--artifact-policy all|failures|none] [--artifact-format json|columnar]\n");
+    printf("       [--result-store <dir>] [--since <previous artifacts dir>] [--shard <i>/<N>]\n");
+    printf("       parity-runner merge --out <dir> [--run-id <id>] [--pass-gate <0-1>] [--max-duration-ms <ms>] [--allow-partial] <shard dir>...\n");
+    printf("       parity-runner generate [--cases <n>] [--seed <n>] [--first <index>] [--corpus-version <v>] [--out <file>]\n");
+    printf("       parity-runner dump <run.cjcol> [--case <id>] [--part canonical|alternate|diff]\n");
+}
+
+static int run_dump(int argc, char **argv) {
+    const char *path = NULL;
+    const char *case_id = NULL;
+    const char *part = NULL;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--case") == 0 && i + 1 < argc) {
+            case_id = argv[++i];
+        } else if (strcmp(argv[i], "--part") == 0 && i + 1 < argc) {
+            part = argv[++i];
+        } else if (!path && argv[i][0] != '-') {
+            path = argv[i];
+        }
+    }
+    if (!path) {
+        print_usage();
+        return 1;
+    }
+    if (part && strcmp(part, "canonical") != 0 && strcmp(part, "alternate") != 0 && strcmp(part, "diff") != 0) {
+        fprintf(stderr, "--part must be canonical, alternate, or diff\n");
+        return 1;
+    }
+
+    ValidationError error = {.message = NULL};
+    if (dump_columnar_artifact(path, case_id, part, stdout, &error) != 0) {
+        fprintf(stderr, "Dump failed: %s\n", error.message ? error.message : "unknown error");
+        free(error.message);
+        return 1;
+    }
+    free(error.message);
+    return 0;
+}
+
+static int run_generate(int argc, char **argv) {
+    GeneratorOptions options = {
+        .seed = 1,
+        .first_case = 0,
+        .case_count = 1000,
+        .corpus_version = "v20251212.1"
+    };
+    const char *out_path = "-";
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--cases") == 0 && i + 1 < argc) {
+            options.case_count = (size_t)strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            options.seed = (uint64_t)strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--first") == 0 && i + 1 < argc) {
+            options.first_case = (size_t)strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--corpus-version") == 0 && i + 1 < argc) {
+            options.corpus_version = argv[++i];
+        } else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            out_path = argv[++i];
+        }
+    }
+
+    FILE *out = strcmp(out_path, "-") == 0 ? stdout : fopen(out_path, "w");
+    if (!out) {
+        fprintf(stderr, "Failed to open %s for writing\n", out_path);
+        return 1;
+    }
+    ValidationError error = {.message = NULL};
+    const int status = write_generated_corpus(out, &options, &error);
+    if (status != 0) {
+        fprintf(stderr, "Generate failed: %s\n", error.message ? error.message : "unknown error");
+    }
+    if (out != stdout) {
+        fclose(out);
+    }
+    free(error.message);
+    return status == 0 ? 0 : 1;
+}
+
+static int run_merge(int argc, char **argv) {
+    const char *out_root = NULL;
+    const char *run_id = NULL;
+    double pass_gate = 0.95;
+    double max_duration_ms = 600000.0;
+    int allow_partial = 0;
+    const char **shard_roots = (const char **)calloc((size_t)argc, sizeof(char *));
+    size_t shard_root_count = 0;
+    if (!shard_roots) {
+        return 1;
+    }
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            out_root = argv[++i];
+        } else if (strcmp(argv[i], "--run-id") == 0 && i + 1 < argc) {
+            run_id = argv[++i];
+        } else if (strcmp(argv[i], "--pass-gate") == 0 && i + 1 < argc) {
+            pass_gate = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--max-duration-ms") == 0 && i + 1 < argc) {
+            max_duration_ms = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--allow-partial") == 0) {
+            allow_partial = 1;
+        } else if (argv[i][0] != '-') {
+            shard_roots[shard_root_count++] = argv[i];
+        }
+    }
+    if (!out_root || shard_root_count == 0) {
+        free(shard_roots);
+        print_usage();
+        return 1;
+    }
+
+    ValidationError error = {.message = NULL};
+    RunSummary summary;
+    if (merge_shard_runs(out_root, shard_roots, shard_root_count, run_id, pass_gate, max_duration_ms, allow_partial, &summary, &error) != 0) {
+        fprintf(stderr, "Merge failed: %s\n", error.message ? error.message : "unknown error");
+        free(error.message);
+        free(shard_roots);
+        return 1;
+    }
+    printf("Report written to %s/report.json\n", out_root);
+    printf("Cases: %zu total, %zu passed, %zu failed | pass rate %.2f%% | duration %.1fms\n",
+           summary.total_cases,
+           summary.passed,
+           summary.failed,
+           summary.pass_rate * 100.0,
+           summary.duration_ms);
+    free(error.message);
+    free(shard_roots);
+    return summary.pass_rate < pass_gate || summary.duration_ms > max_duration_ms ? 1 : 0;
 }
 
 static const char *detect_platform(void) {
@@ -108,19 +248,27 @@ static void free_case_filters(char **filters, size_t count) {
     free(filters);
 }
 
-static InputCase *find_input_case(const Corpus *corpus, const char *id) {
-    if (!corpus || !id) {
-        return NULL;
+/* Runner binaries are part of every case key; fall back to the path if unreadable. */
+static uint64_t hash_runner_binary(const char *path) {
+    uint64_t hash = 0;
+    if (hash_file_contents(path, &hash, NULL) != 0) {
+        fprintf(stderr, "Warning: cannot read runner %s; cache keys use its path only.\n", path);
+        hash = fnv1a64_update(0xcbf29ce484222325ULL, path, strlen(path));
     }
-    for (size_t i = 0; i < corpus->case_count; ++i) {
-        if (strcmp(corpus->cases[i].id, id) == 0) {
-            return &corpus->cases[i];
-        }
-    }
-    return NULL;
+    return hash;
 }
 
 int main(int argc, char **argv) {
+    if (argc > 1 && strcmp(argv[1], "dump") == 0) {
+        return run_dump(argc - 1, argv + 1);
+    }
+    if (argc > 1 && strcmp(argv[1], "generate") == 0) {
+        return run_generate(argc - 1, argv + 1);
+    }
+    if (argc > 1 && strcmp(argv[1], "merge") == 0) {
+        return run_merge(argc - 1, argv + 1);
+    }
+
     const char *corpus_path = NULL;
     const char *tolerances_path = NULL;
     const char *artifacts_path = NULL;
@@ -139,6 +287,12 @@ int main(int argc, char **argv) {
     double tolerance_a_override = -1.0;
     double tolerance_b_override = -1.0;
     ArtifactPolicy artifact_policy = ARTIFACT_POLICY_ALL;
+    ArtifactFormat artifact_format = ARTIFACT_FORMAT_JSON;
+    const char *result_store = NULL;
+    const char *since_path = NULL;
+    const char *shard_spec = NULL;
+    size_t shard_index = 0;
+    size_t shard_count = 1;
 
     for (int i = 1; i < argc; ++i) {
         if (strcmp(argv[i], "--corpus") == 0 && i + 1 < argc) {
@@ -168,6 +322,19 @@ int main(int argc, char **argv) {
             } else if (strcmp(policy, "none") == 0) {
                 artifact_policy = ARTIFACT_POLICY_NONE;
             }
+        } else if (strcmp(argv[i], "--artifact-format") == 0 && i + 1 < argc) {
+            const char *format = argv[++i];
+            if (strcmp(format, "json") == 0) {
+                artifact_format = ARTIFACT_FORMAT_JSON;
+            } else if (strcmp(format, "columnar") == 0) {
+                artifact_format = ARTIFACT_FORMAT_COLUMNAR;
+            }
+        } else if (strcmp(argv[i], "--result-store") == 0 && i + 1 < argc) {
+            result_store = argv[++i];
+        } else if (strcmp(argv[i], "--since") == 0 && i + 1 < argc) {
+            since_path = argv[++i];
+        } else if (strcmp(argv[i], "--shard") == 0 && i + 1 < argc) {
+            shard_spec = argv[++i];
         } else if (strcmp(argv[i], "--c-runner") == 0 && i + 1 < argc) {
             c_runner = argv[++i];
         } else if (strcmp(argv[i], "--alt-runner") == 0 && i + 1 < argc) {
@@ -204,19 +371,30 @@ int main(int argc, char **argv) {
         print_usage();
         return 1;
     }
+    if (shard_spec && parse_shard_spec(shard_spec, &shard_index, &shard_count) != 0) {
+        fprintf(stderr, "--shard must be <i>/<N> with 0 <= i < N\n");
+        return 1;
+    }
+    if (since_path && !result_store) {
+        fprintf(stderr, "--since replays unchanged cases from the result store and requires --result-store\n");
+        return 1;
+    }
 
     ValidationError error = {.message = NULL};
-    Corpus corpus;
-    if (parse_corpus_file(corpus_path, &corpus, &error) != 0) {
+    CorpusStream corpus;
+    if (open_corpus_stream(corpus_path, &corpus, &error) != 0) {
         fprintf(stderr, "Corpus validation failed: %s\n", error.message ? error.message : "unknown error");
         free(error.message);
         return 1;
     }
+    char corpus_version[MAX_VERSION_LENGTH];
+    strncpy(corpus_version, corpus.corpus_version, sizeof(corpus_version) - 1);
+    corpus_version[sizeof(corpus_version) - 1] = '\0';
 
     ToleranceConfig tolerance;
     if (parse_tolerances_file(tolerances_path, &tolerance, &error) != 0) {
         fprintf(stderr, "Tolerance validation failed: %s\n", error.message ? error.message : "unknown error");
-        free_corpus(&corpus);
+        close_corpus_stream(&corpus);
         free(error.message);
         return 1;
     }
@@ -241,62 +419,16 @@ int main(int argc, char **argv) {
     size_t tag_filter_count = 0;
     char **tag_filters = split_cases(tags_filter, &tag_filter_count);
 
-    size_t selected_cases = 0;
-    for (size_t i = 0; i < corpus.case_count; ++i) {
-        if (is_selected_case(corpus.cases[i].id, filters, filter_count) &&
-            case_has_tag(&corpus.cases[i], (const char **)tag_filters, tag_filter_count)) {
-            selected_cases++;
-        }
-    }
-
-    if (selected_cases == 0) {
-        fprintf(stderr, "No cases selected for execution.\n");
-        free_case_filters(filters, filter_count);
-        free_tolerances(&tolerance);
-        free_corpus(&corpus);
-        free(error.message);
-        return 1;
-    }
+    /*
+     * Cases are streamed and spilled to disk once compared, so memory holds one
+     * case at a time; report.json and metadata are written from the spill.
+     */
+    RunSummary summary = {0};
+    CaseSpill spill = {0};
 
-    RunResults results = {0};
-    results.result_count = selected_cases;
-    results.results = (ComparisonResult *)calloc(selected_cases, sizeof(ComparisonResult));
-    if (!results.results) {
-        fprintf(stderr, "Failed to allocate comparison results.\n");
-        free_case_filters(filters, filter_count);
-        free_tolerances(&tolerance);
-        free_corpus(&corpus);
-        free(error.message);
-        return 1;
-    }
-
-    size_t delta_capacity = 128;
-    size_t delta_count = 0;
-    double *delta_e_values = (double *)malloc(delta_capacity * sizeof(double));
-    double *delta_l_values = (double *)malloc(delta_capacity * sizeof(double));
-    double *delta_a_values = (double *)malloc(delta_capacity * sizeof(double));
-    double *delta_b_values = (double *)malloc(delta_capacity * sizeof(double));
-    double *delta_r_values = (double *)malloc(delta_capacity * sizeof(double));
-    double *delta_g_values = (double *)malloc(delta_capacity * sizeof(double));
-    double *delta_b_rgb_values = (double *)malloc(delta_capacity * sizeof(double));
-
-    if (!delta_e_values || !delta_l_values || !delta_a_values || !delta_b_values ||
-        !delta_r_values || !delta_g_values || !delta_b_rgb_values) {
-        fprintf(stderr, "Failed to allocate delta buffers.\n");
-        free(delta_e_values);
-        free(delta_l_values);
-        free(delta_a_values);
-        free(delta_b_values);
-        free(delta_r_values);
-        free(delta_g_values);
-        free(delta_b_rgb_values);
-        free_case_filters(filters, filter_count);
-        free_tolerances(&tolerance);
-        free_corpus(&corpus);
-        free(results.results);
-        free(error.message);
-        return 1;
-    }
+    /* Streaming sketches keep stats memory independent of sample count. */
+    MetricSketch run_metrics[RUN_METRIC_COUNT];
+    init_run_metrics(run_metrics);
 
     char artifacts_root_buf[MAX_PATH_LENGTH];
     const char *resolved_root = artifacts_path;
@@ -310,7 +442,7 @@ int main(int argc, char **argv) {
         .c_commit = (char *)(c_commit ? c_commit : "unknown"),
         .wasm_commit = (char *)(wasm_commit ? wasm_commit : "unknown"),
         .platform = (char *)(platform_arg ? platform_arg : detect_platform()),
-        .corpus_version = corpus.corpus_version,
+        .corpus_version = corpus_version,
         .artifacts_root = (char *)resolved_root,
         .max_duration_ms = max_duration_ms,
         .pass_gate = pass_gate,
@@ -321,32 +453,103 @@ int main(int argc, char **argv) {
     int exit_code = 0;
     const clock_t start = clock();
 
+    /*
+     * Runners receive a one-case scratch corpus rather than the full corpus
+     * path, so each child parses a single case and stdin corpora work too.
+     */
+    char case_input_path[MAX_PATH_LENGTH + 32];
+    snprintf(case_input_path, sizeof(case_input_path), "%s/.case-input.jsonl", resolved_root);
+    if (ensure_directory(resolved_root, &error) != 0) {
+        fprintf(stderr, "Failed to create artifacts directory %s: %s\n", resolved_root, error.message ? error.message : "unknown error");
+        exit_code = 1;
+    }
+
+    if (exit_code == 0 && open_case_spill(&spill, &error) != 0) {
+        fprintf(stderr, "Failed to create case spill: %s\n", error.message ? error.message : "unknown error");
+        exit_code = 1;
+    }
+
+    ColumnarWriter columnar = {0};
+    if (exit_code == 0 && artifact_format == ARTIFACT_FORMAT_COLUMNAR &&
+        open_columnar_artifact(resolved_root, &columnar, &error) != 0) {
+        fprintf(stderr, "Failed to create columnar artifact: %s\n", error.message ? error.message : "unknown error");
+        exit_code = 1;
+    }
+
+    /* Content keys: case text + both runner builds + applied tolerances. */
+    uint64_t engine_hash = hash_runner_binary(c_runner);
+    engine_hash = fnv1a64_update(engine_hash, &(uint64_t){hash_runner_binary(alt_runner)}, sizeof(uint64_t));
+    const uint64_t tolerance_hash = hash_tolerances(&tolerance);
+
+    CaseManifest previous_manifest = {0};
+    if (exit_code == 0 && since_path && load_case_manifest(since_path, &previous_manifest, &error) != 0) {
+        fprintf(stderr, "Failed to load --since manifest from %s: %s\n", since_path, error.message ? error.message : "unknown error");
+        exit_code = 1;
+    }
+
+    char manifest_path[MAX_PATH_LENGTH + 32];
+    snprintf(manifest_path, sizeof(manifest_path), "%s/%s", resolved_root, CASE_MANIFEST_NAME);
+    FILE *manifest_file = exit_code == 0 ? fopen(manifest_path, "w") : NULL;
+    if (exit_code == 0 && !manifest_file) {
+        fprintf(stderr, "Warning: cannot write %s; --since will not be able to use this run.\n", manifest_path);
+    }
+
+    size_t unchanged_cases = 0;
     size_t output_index = 0;
-    for (size_t i = 0; i < corpus.case_count; ++i) {
-        InputCase *input_case = &corpus.cases[i];
+    InputCase current_case;
+    int stream_status = 0;
+    while (exit_code == 0 && (stream_status = next_corpus_case(&corpus, &current_case, &error)) == 1) {
+        InputCase *input_case = &current_case;
         if (!is_selected_case(input_case->id, filters, filter_count) ||
-            !case_has_tag(input_case, (const char **)tag_filters, tag_filter_count)) {
+            !case_has_tag(input_case, (const char **)tag_filters, tag_filter_count) ||
+            shard_for_case(input_case->id, shard_count) != shard_index) {
+            free_input_case(input_case);
             continue;
         }
 
+        const uint64_t case_key = compute_case_key(corpus.text, corpus.text_length, engine_hash, tolerance_hash);
+        const CaseManifestEntry *previous = find_case_manifest_entry(&previous_manifest, input_case->id);
+
+        /*
+         * Unchanged cases are replayed from the result store through the normal
+         * compare path so they still reach the stats, report and artifacts; one
+         * missing from the store is simply re-run.
+         */
+        ComparisonResult result = {0};
         EngineOutput canonical = {0};
         EngineOutput alternate = {0};
+        const int cached = result_store ? load_cached_outputs(result_store, case_key, &canonical, &alternate, &error) == 1 : 0;
+        if (cached) {
+            summary.cache_hits++;
+            unchanged_cases += previous && previous->key == case_key ? 1 : 0;
+        } else if (write_current_case_file(&corpus, case_input_path, &error) != 0) {
+            fprintf(stderr, "Failed to stage case %s: %s\n", input_case->id, error.message ? error.message : "unknown error");
+            free_input_case(input_case);
+            exit_code = 1;
+            break;
+        }
 
-        if (run_c_engine(c_runner, corpus_path, input_case->id, &canonical, &error) != 0) {
+        if (!cached && run_c_engine(c_runner, case_input_path, input_case->id, &canonical, &error) != 0) {
             fprintf(stderr, "Canonical runner failed for case %s: %s\n", input_case->id, error.message ? error.message : "unknown error");
             free_engine_output(&canonical);
             free_engine_output(&alternate);
+            free_input_case(input_case);
             exit_code = 1;
             break;
         }
-        if (run_alt_engine(alt_runner, corpus_path, input_case->id, &alternate, &error) != 0) {
+        if (!cached && run_alt_engine(alt_runner, case_input_path, input_case->id, &alternate, &error) != 0) {
             fprintf(stderr, "Alternate runner failed for case %s: %s\n", input_case->id, error.message ? error.message : "unknown error");
             free_engine_output(&canonical);
             free_engine_output(&alternate);
+            free_input_case(input_case);
             exit_code = 1;
             break;
         }
 
+        if (!cached && result_store && store_cached_outputs(result_store, case_key, &canonical, &alternate, &error) != 0) {
+            fprintf(stderr, "Warning: failed to cache case %s: %s\n", input_case->id, error.message ? error.message : "unknown error");
+        }
+
         if (!provenance.c_build_flags && canonical.build_flags) {
             provenance.c_build_flags = strdup(canonical.build_flags);
         }
@@ -354,159 +557,145 @@ int main(int argc, char **argv) {
             provenance.alt_build_flags = strdup(alternate.build_flags);
         }
 
-        if (compare_engine_outputs(&canonical, &alternate, &tolerance, input_case, &results.results[output_index]) != 0) {
+        if (compare_engine_outputs(&canonical, &alternate, &tolerance, input_case, &result) != 0) {
             fprintf(stderr, "Comparison failed for case %s\n", input_case->id);
         }
 
         /* Accumulate delta metrics */
-        for (size_t s = 0; s < results.results[output_index].sample_count; ++s) {
-            const ComparisonDelta *delta = &results.results[output_index].samples[s].delta;
-            if (delta_count + 1 >= delta_capacity) {
-                delta_capacity *= 2;
-                double *tmp_e = (double *)realloc(delta_e_values, delta_capacity * sizeof(double));
-                double *tmp_l = (double *)realloc(delta_l_values, delta_capacity * sizeof(double));
-                double *tmp_a = (double *)realloc(delta_a_values, delta_capacity * sizeof(double));
-                double *tmp_b = (double *)realloc(delta_b_values, delta_capacity * sizeof(double));
-                double *tmp_r = (double *)realloc(delta_r_values, delta_capacity * sizeof(double));
-                double *tmp_g = (double *)realloc(delta_g_values, delta_capacity * sizeof(double));
-                double *tmp_b_rgb = (double *)realloc(delta_b_rgb_values, delta_capacity * sizeof(double));
-                if (!tmp_e || !tmp_l || !tmp_a || !tmp_b || !tmp_r || !tmp_g || !tmp_b_rgb) {
-                    fprintf(stderr, "Failed to grow delta buffers.\n");
-                    free(tmp_e);
-                    free(tmp_l);
-                    free(tmp_a);
-                    free(tmp_b);
-                    free(tmp_r);
-                    free(tmp_g);
-                    free(tmp_b_rgb);
-                    exit_code = 1;
-                    break;
-                }
-                delta_e_values = tmp_e;
-                delta_l_values = tmp_l;
-                delta_a_values = tmp_a;
-                delta_b_values = tmp_b;
-                delta_r_values = tmp_r;
-                delta_g_values = tmp_g;
-                delta_b_rgb_values = tmp_b_rgb;
+        for (size_t s = 0; s < result.sample_count; ++s) {
+            if (record_run_metrics(run_metrics, &result.samples[s]) != 0) {
+                fprintf(stderr, "Failed to record delta metrics.\n");
+                exit_code = 1;
+                break;
             }
-            delta_e_values[delta_count] = fabs(delta->deltaE);
-            delta_l_values[delta_count] = fabs(delta->l);
-            delta_a_values[delta_count] = fabs(delta->a);
-            delta_b_values[delta_count] = fabs(delta->b);
-            delta_r_values[delta_count] = fabs(results.results[output_index].samples[s].rgb_delta.r);
-            delta_g_values[delta_count] = fabs(results.results[output_index].samples[s].rgb_delta.g);
-            delta_b_rgb_values[delta_count] = fabs(results.results[output_index].samples[s].rgb_delta.b);
-            delta_count++;
         }
 
         if (exit_code != 0) {
             free_engine_output(&canonical);
             free_engine_output(&alternate);
+            free_comparison_result(&result);
+            free_input_case(input_case);
             break;
         }
 
         /* Write artifacts based on retention policy */
         int should_write = (artifact_policy == ARTIFACT_POLICY_ALL) ||
-                          (artifact_policy == ARTIFACT_POLICY_FAILURES && !results.results[output_index].passed);
-        if (should_write && write_case_artifacts(resolved_root, input_case, &canonical, &alternate, &results.results[output_index], &error) != 0) {
+                          (artifact_policy == ARTIFACT_POLICY_FAILURES && !result.passed);
+        if (should_write && artifact_format == ARTIFACT_FORMAT_COLUMNAR) {
+            if (append_columnar_case(&columnar, &canonical, &alternate, &result, &error) != 0) {
+                fprintf(stderr, "Failed to append columnar artifact for case %s: %s\n", input_case->id, error.message ? error.message : "unknown error");
+                exit_code = 1;
+            }
+        } else if (should_write && write_case_artifacts(resolved_root, input_case, &canonical, &alternate, &result, &error) != 0) {
             fprintf(stderr, "Failed to write artifacts for case %s: %s\n", input_case->id, error.message ? error.message : "unknown error");
         }
 
+        /* Columnar runs carry case metadata in run.cjcol and report.json. */
+        const int should_write_metadata = should_write && artifact_format == ARTIFACT_FORMAT_JSON;
+        if (spill_case(&spill, input_case, &result, artifact_format != ARTIFACT_FORMAT_COLUMNAR, should_write_metadata, &error) != 0) {
+            fprintf(stderr, "Failed to record case %s: %s\n", input_case->id, error.message ? error.message : "unknown error");
+            exit_code = 1;
+        }
+        if (result.passed) {
+            summary.passed++;
+        } else {
+            summary.failed++;
+        }
+
+        write_case_manifest_line(manifest_file, input_case->id, case_key, result.passed);
         free_engine_output(&canonical);
         free_engine_output(&alternate);
+        free_comparison_result(&result);
+        free_input_case(input_case);
         output_index++;
     }
-
-    const clock_t end = clock();
-    results.result_count = output_index;
-    results.summary.total_cases = output_index;
-    results.summary.passed = 0;
-    results.summary.failed = 0;
-    for (size_t i = 0; i < results.result_count; ++i) {
-        if (results.results[i].passed) {
-            results.summary.passed++;
-        } else {
-            results.summary.failed++;
-        }
+    if (stream_status < 0) {
+        fprintf(stderr, "Corpus validation failed: %s\n", error.message ? error.message : "unknown error");
+        exit_code = 1;
+    }
+    remove(case_input_path);
+    if (manifest_file) {
+        fclose(manifest_file);
+    }
+    free_case_manifest(&previous_manifest);
+    if (columnar.file && finish_columnar_artifact(&columnar, &error) != 0) {
+        fprintf(stderr, "Failed to finalize columnar artifact: %s\n", error.message ? error.message : "unknown error");
+        exit_code = 1;
     }
-    results.summary.duration_ms = ((double)(end - start) / CLOCKS_PER_SEC) * 1000.0;
-    results.summary.pass_rate = results.summary.total_cases > 0 ? ((double)results.summary.passed / (double)results.summary.total_cases) : 0.0;
-
-    compute_metric_stats(delta_e_values, delta_count, &results.summary.stats.delta_e);
-    compute_metric_stats(delta_l_values, delta_count, &results.summary.stats.l);
-    compute_metric_stats(delta_a_values, delta_count, &results.summary.stats.a);
-    compute_metric_stats(delta_b_values, delta_count, &results.summary.stats.b);
-    compute_metric_stats(delta_r_values, delta_count, &results.summary.stats.rgb_r);
-    compute_metric_stats(delta_g_values, delta_count, &results.summary.stats.rgb_g);
-    compute_metric_stats(delta_b_rgb_values, delta_count, &results.summary.stats.rgb_b);
-
-    const double hist_max = results.summary.stats.delta_e.max > 0.0 ? results.summary.stats.delta_e.max : 1.0;
-    init_histogram(&results.summary.stats.delta_e_hist, 0.0, hist_max, 20);
-    for (size_t i = 0; i < delta_count; ++i) {
-        record_histogram(&results.summary.stats.delta_e_hist, delta_e_values[i]);
-    }
-
-    for (size_t i = 0; i < results.result_count; ++i) {
-        Contributor *contributors = NULL;
-        size_t contributor_count = 0;
-        if (compute_contributors(&results.results[i], &results.summary, 3, &contributors, &contributor_count, &error) != 0) {
-            fprintf(stderr, "Failed to compute contributors for case %s: %s\n",
-                    results.results[i].input_case_id,
-                    error.message ? error.message : "unknown error");
-        } else {
-            results.results[i].contributors = contributors;
-            results.results[i].contributor_count = contributor_count;
-        }
 
-        InputCase *matching_case = find_input_case(&corpus, results.results[i].input_case_id);
-        if (matching_case) {
-            int should_write_metadata = (artifact_policy == ARTIFACT_POLICY_ALL) ||
-                                       (artifact_policy == ARTIFACT_POLICY_FAILURES && !results.results[i].passed);
-            if (should_write_metadata && write_case_metadata(resolved_root, matching_case, &results.results[i], &error) != 0) {
-                fprintf(stderr, "Failed to write metadata for case %s: %s\n",
-                        results.results[i].input_case_id,
-                        error.message ? error.message : "unknown error");
-            }
-        }
+    if (exit_code == 0 && output_index == 0 && !shard_spec) {
+        fprintf(stderr, "No cases selected for execution.\n");
+        exit_code = 1;
+    }
+    if (exit_code != 0 && output_index == 0) {
+        close_case_spill(&spill);
+        free_case_filters(filters, filter_count);
+        free_case_filters(tag_filters, tag_filter_count);
+        free_tolerances(&tolerance);
+        close_corpus_stream(&corpus);
+        free(error.message);
+        free_run_metrics(run_metrics);
+        free(provenance.c_build_flags);
+        free(provenance.alt_build_flags);
+        return 1;
     }
 
+    const clock_t end = clock();
+    summary.total_cases = output_index;
+    summary.unchanged = unchanged_cases;
+    summary.duration_ms = ((double)(end - start) / CLOCKS_PER_SEC) * 1000.0;
+    summary.pass_rate = summary.total_cases > 0 ? ((double)summary.passed / (double)summary.total_cases) : 0.0;
+
+    finalize_run_metrics(run_metrics, &summary.stats);
+
     provenance.artifact_policy = artifact_policy_to_string(artifact_policy);
-    if (write_run_report(resolved_root, &provenance, &results, &tolerance, &error) != 0) {
+    provenance.artifact_format = artifact_format_to_string(artifact_format);
+
+    /* An empty shard is valid: small corpora may not reach every shard. */
+    if (shard_spec) {
+        char shard_cases_path[MAX_PATH_LENGTH + 32];
+        snprintf(shard_cases_path, sizeof(shard_cases_path), "%s/%s", resolved_root, SHARD_CASES_NAME);
+        if (write_shard_summary(resolved_root, shard_index, shard_count, &provenance, &tolerance,
+                                engine_hash, tolerance_hash, &summary, run_metrics, &error) != 0 ||
+            export_case_spill(&spill, shard_cases_path, &error) != 0) {
+            fprintf(stderr, "Failed to write shard summary: %s\n", error.message ? error.message : "unknown error");
+            exit_code = 1;
+        }
+    }
+    if (write_spilled_run_report(resolved_root, &provenance, &summary, &spill, &tolerance, &error) != 0) {
         fprintf(stderr, "Failed to write run report: %s\n", error.message ? error.message : "unknown error");
+        exit_code = 1;
     } else {
         printf("Report written to %s/report.json\n", resolved_root);
     }
 
     printf("Cases: %zu total, %zu passed, %zu failed | pass rate %.2f%% | duration %.1fms\n",
-           results.summary.total_cases,
-           results.summary.passed,
-           results.summary.failed,
-           results.summary.pass_rate * 100.0,
-           results.summary.duration_ms);
-
-    if (results.summary.pass_rate < pass_gate || results.summary.duration_ms > max_duration_ms) {
+           summary.total_cases,
+           summary.passed,
+           summary.failed,
+           summary.pass_rate * 100.0,
+           summary.duration_ms);
+    if (summary.unchanged > 0 || summary.cache_hits > 0) {
+        printf("Incremental: %zu unchanged since reference run, %zu served from result store\n",
+               summary.unchanged,
+               summary.cache_hits);
+    }
+
+    if (shard_spec) {
+        printf("Shard: %zu/%zu (merge shard directories with parity-runner merge)\n", shard_index, shard_count);
+    } else if (summary.pass_rate < pass_gate || summary.duration_ms > max_duration_ms) {
         exit_code = 1;
     }
 
     /* Cleanup */
-    for (size_t i = 0; i < results.result_count; ++i) {
-        free_comparison_result(&results.results[i]);
-    }
-    free(results.results);
+    close_case_spill(&spill);
     free_case_filters(filters, filter_count);
     free_case_filters(tag_filters, tag_filter_count);
     free_tolerances(&tolerance);
-    free_corpus(&corpus);
+    close_corpus_stream(&corpus);
     free(error.message);
-    free(delta_e_values);
-    free(delta_l_values);
-    free(delta_a_values);
-    free(delta_b_values);
-    free(delta_r_values);
-    free(delta_g_values);
-    free(delta_b_rgb_values);
-    free_histogram(&results.summary.stats.delta_e_hist);
+    free_run_metrics(run_metrics);
+    free_histogram(&summary.stats.delta_e_hist);
     free(provenance.c_build_flags);
     free(provenance.alt_build_flags);
 
@@ -52,14 +52,34 @@ static cJSON *engine_output_json(const EngineOutput *output) {
     return root;
 }
 
-static cJSON *comparison_json(const ComparisonResult *result) {
+static void add_contributors_json(cJSON *root, const Contributor *contributors, size_t count) {
+    if (!contributors || count == 0) {
+        return;
+    }
+    cJSON *array = cJSON_AddArrayToObject(root, "topContributors");
+    for (size_t i = 0; i < count; ++i) {
+        const Contributor *hint = &contributors[i];
+        cJSON *entry = cJSON_CreateObject();
+        cJSON_AddStringToObject(entry, "metric", hint->metric);
+        cJSON_AddNumberToObject(entry, "magnitude", hint->magnitude);
+        cJSON_AddStringToObject(entry, "direction", hint->direction);
+        if (hint->stage) cJSON_AddStringToObject(entry, "stage", hint->stage);
+        if (hint->parameter) cJSON_AddStringToObject(entry, "parameter", hint->parameter);
+        cJSON_AddNumberToObject(entry, "zScore", hint->z_score);
+        cJSON_AddBoolToObject(entry, "significant", hint->significant ? 1 : 0);
+        cJSON_AddItemToArray(array, entry);
+    }
+}
+
+static cJSON *comparison_json(const ComparisonResult *result, int include_samples) {
     cJSON *root = cJSON_CreateObject();
     cJSON_AddStringToObject(root, "inputCaseId", result->input_case_id);
     cJSON_AddBoolToObject(root, "passed", result->passed ? 1 : 0);
     cJSON_AddNumberToObject(root, "maxDeltaE", result->max_delta_e);
 
-    cJSON *samples = cJSON_AddArrayToObject(root, "samples");
-    for (size_t i = 0; i < result->sample_count; ++i) {
+    /* Columnar runs keep per-sample data in run.cjcol only. */
+    cJSON *samples = include_samples ? cJSON_AddArrayToObject(root, "samples") : NULL;
+    for (size_t i = 0; samples && i < result->sample_count; ++i) {
         const SampleDelta *sample = &result->samples[i];
         cJSON *entry = cJSON_CreateObject();
         cJSON_AddNumberToObject(entry, "index", (double)sample->index);
@@ -79,24 +99,30 @@ static cJSON *comparison_json(const ComparisonResult *result) {
         cJSON_AddItemToArray(samples, entry);
     }
 
-    if (result->contributors && result->contributor_count > 0) {
-        cJSON *contributors = cJSON_AddArrayToObject(root, "topContributors");
-        for (size_t i = 0; i < result->contributor_count; ++i) {
-            const Contributor *hint = &result->contributors[i];
-            cJSON *entry = cJSON_CreateObject();
-            cJSON_AddStringToObject(entry, "metric", hint->metric);
-            cJSON_AddNumberToObject(entry, "magnitude", hint->magnitude);
-            cJSON_AddStringToObject(entry, "direction", hint->direction);
-            if (hint->stage) cJSON_AddStringToObject(entry, "stage", hint->stage);
-            if (hint->parameter) cJSON_AddStringToObject(entry, "parameter", hint->parameter);
-            cJSON_AddNumberToObject(entry, "zScore", hint->z_score);
-            cJSON_AddBoolToObject(entry, "significant", hint->significant ? 1 : 0);
-            cJSON_AddItemToArray(contributors, entry);
-        }
-    }
+    add_contributors_json(root, result->contributors, result->contributor_count);
     return root;
 }
 
+char *render_engine_output_json(const EngineOutput *output) {
+    if (!output) {
+        return NULL;
+    }
+    cJSON *root = engine_output_json(output);
+    char *rendered = cJSON_PrintUnformatted(root);
+    cJSON_Delete(root);
+    return rendered;
+}
+
+char *render_comparison_json(const ComparisonResult *result) {
+    if (!result) {
+        return NULL;
+    }
+    cJSON *root = comparison_json(result, 1);
+    char *rendered = cJSON_PrintUnformatted(root);
+    cJSON_Delete(root);
+    return rendered;
+}
+
 static cJSON *histogram_json(const Histogram *hist) {
     cJSON *root = cJSON_CreateObject();
     if (!hist || !hist->counts) {
@@ -175,7 +201,7 @@ int write_case_artifacts(const char *artifacts_root,
         set_error(error, "failed to write diff artifact");
         return -1;
     }
-    cJSON *diff_json = comparison_json(result);
+    cJSON *diff_json = comparison_json(result, 1);
     char *diff_str = cJSON_PrintUnformatted(diff_json);
     fprintf(file, "%s", diff_str);
     fclose(file);
@@ -185,21 +211,7 @@ int write_case_artifacts(const char *artifacts_root,
     return 0;
 }
 
-int write_case_metadata(const char *artifacts_root,
-                        const InputCase *input_case,
-                        const ComparisonResult *result,
-                        ValidationError *error) {
-    if (!artifacts_root || !input_case || !result) {
-        set_error(error, "invalid metadata arguments");
-        return -1;
-    }
-
-    char case_dir[MAX_PATH_LENGTH];
-    snprintf(case_dir, sizeof(case_dir), "%s/cases/%s", artifacts_root, input_case->id);
-    if (ensure_directory(artifacts_root, error) != 0 || ensure_directory(case_dir, error) != 0) {
-        return -1;
-    }
-
+static cJSON *case_metadata_json(const InputCase *input_case, const ComparisonResult *result) {
     cJSON *root = cJSON_CreateObject();
     cJSON_AddStringToObject(root, "inputCaseId", input_case->id);
     cJSON_AddBoolToObject(root, "passed", result->passed ? 1 : 0);
@@ -222,28 +234,20 @@ int write_case_metadata(const char *artifacts_root,
     cJSON_AddStringToObject(artifacts, "alternate", "alternate.json");
     cJSON_AddStringToObject(artifacts, "diff", "diff.json");
     cJSON_AddItemToObject(root, "artifacts", artifacts);
+    return root;
+}
 
-    if (result->contributors && result->contributor_count > 0) {
-        cJSON *contributors = cJSON_AddArrayToObject(root, "topContributors");
-        for (size_t i = 0; i < result->contributor_count; ++i) {
-            const Contributor *hint = &result->contributors[i];
-            cJSON *entry = cJSON_CreateObject();
-            cJSON_AddStringToObject(entry, "metric", hint->metric);
-            cJSON_AddNumberToObject(entry, "magnitude", hint->magnitude);
-            cJSON_AddStringToObject(entry, "direction", hint->direction);
-            if (hint->stage) cJSON_AddStringToObject(entry, "stage", hint->stage);
-            if (hint->parameter) cJSON_AddStringToObject(entry, "parameter", hint->parameter);
-            cJSON_AddNumberToObject(entry, "zScore", hint->z_score);
-            cJSON_AddBoolToObject(entry, "significant", hint->significant ? 1 : 0);
-            cJSON_AddItemToArray(contributors, entry);
-        }
+static int write_metadata_file(const char *artifacts_root, const char *case_id, cJSON *root, ValidationError *error) {
+    char case_dir[MAX_PATH_LENGTH];
+    snprintf(case_dir, sizeof(case_dir), "%s/cases/%s", artifacts_root, case_id);
+    if (ensure_directory(artifacts_root, error) != 0 || ensure_directory(case_dir, error) != 0) {
+        return -1;
     }
 
     char path[MAX_PATH_LENGTH];
     snprintf(path, sizeof(path), "%s/metadata.json", case_dir);
     FILE *file = fopen(path, "w");
     if (!file) {
-        cJSON_Delete(root);
         set_error(error, "failed to write case metadata");
         return -1;
     }
@@ -252,33 +256,51 @@ int write_case_metadata(const char *artifacts_root,
     fprintf(file, "%s", rendered);
     fclose(file);
     free(rendered);
-    cJSON_Delete(root);
     return 0;
 }
 
-int write_run_report(const char *artifacts_root,
-                     const RunProvenance *provenance,
-                     const RunResults *results,
-                     const ToleranceConfig *tolerance,
-                     ValidationError *error) {
-    if (!artifacts_root || !provenance || !results) {
-        set_error(error, "invalid report arguments");
-        return -1;
-    }
-    if (ensure_directory(artifacts_root, error) != 0) {
+int write_case_metadata(const char *artifacts_root,
+                        const InputCase *input_case,
+                        const ComparisonResult *result,
+                        ValidationError *error) {
+    if (!artifacts_root || !input_case || !result) {
+        set_error(error, "invalid metadata arguments");
         return -1;
     }
 
+    cJSON *root = case_metadata_json(input_case, result);
+    add_contributors_json(root, result->contributors, result->contributor_count);
+    const int status = write_metadata_file(artifacts_root, input_case->id, root, error);
+    cJSON_Delete(root);
+    return status;
+}
+
+static int report_is_columnar(const RunProvenance *provenance) {
+    return provenance->artifact_format && strcmp(provenance->artifact_format, "columnar") == 0;
+}
+
+/* Everything in report.json except the per-case entries; "cases" is added last. */
+static cJSON *run_report_header_json(const char *artifacts_root,
+                                     const RunProvenance *provenance,
+                                     const RunSummary *summary,
+                                     const ToleranceConfig *tolerance) {
+    const int columnar = report_is_columnar(provenance);
     cJSON *root = cJSON_CreateObject();
     cJSON_AddStringToObject(root, "runId", provenance->run_id ? provenance->run_id : "local-run");
     cJSON_AddStringToObject(root, "corpusVersion", provenance->corpus_version ? provenance->corpus_version : "unknown");
-    cJSON_AddNumberToObject(root, "durationMs", results->summary.duration_ms);
-    cJSON_AddNumberToObject(root, "passRate", results->summary.pass_rate);
-    cJSON_AddBoolToObject(root, "withinPassGate", results->summary.pass_rate >= provenance->pass_gate ? 1 : 0);
-    cJSON_AddBoolToObject(root, "withinDuration", results->summary.duration_ms <= provenance->max_duration_ms ? 1 : 0);
+    cJSON_AddNumberToObject(root, "durationMs", summary->duration_ms);
+    cJSON_AddNumberToObject(root, "passRate", summary->pass_rate);
+    cJSON_AddBoolToObject(root, "withinPassGate", summary->pass_rate >= provenance->pass_gate ? 1 : 0);
+    cJSON_AddBoolToObject(root, "withinDuration", summary->duration_ms <= provenance->max_duration_ms ? 1 : 0);
     if (provenance->artifact_policy) {
         cJSON_AddStringToObject(root, "artifactPolicy", provenance->artifact_policy);
     }
+    if (provenance->artifact_format) {
+        cJSON_AddStringToObject(root, "artifactFormat", provenance->artifact_format);
+    }
+    if (columnar) {
+        cJSON_AddStringToObject(root, "columnarArtifact", COLUMNAR_ARTIFACT_NAME);
+    }
 
     cJSON *prov = cJSON_CreateObject();
     cJSON_AddStringToObject(prov, "cCommit", provenance->c_commit ? provenance->c_commit : "unknown");
@@ -308,47 +330,356 @@ int write_run_report(const char *artifacts_root,
     }
     cJSON_AddItemToObject(root, "provenance", prov);
 
-    cJSON *summary = cJSON_CreateObject();
-    cJSON_AddNumberToObject(summary, "totalCases", (double)results->summary.total_cases);
-    cJSON_AddNumberToObject(summary, "passed", (double)results->summary.passed);
-    cJSON_AddNumberToObject(summary, "failed", (double)results->summary.failed);
-    cJSON_AddItemToObject(summary, "deltaE", metric_stats_json(&results->summary.stats.delta_e));
-    cJSON_AddItemToObject(summary, "l", metric_stats_json(&results->summary.stats.l));
-    cJSON_AddItemToObject(summary, "a", metric_stats_json(&results->summary.stats.a));
-    cJSON_AddItemToObject(summary, "b", metric_stats_json(&results->summary.stats.b));
-    cJSON_AddItemToObject(summary, "rgbR", metric_stats_json(&results->summary.stats.rgb_r));
-    cJSON_AddItemToObject(summary, "rgbG", metric_stats_json(&results->summary.stats.rgb_g));
-    cJSON_AddItemToObject(summary, "rgbB", metric_stats_json(&results->summary.stats.rgb_b));
-    cJSON_AddItemToObject(summary, "deltaEHistogram", histogram_json(&results->summary.stats.delta_e_hist));
-    cJSON_AddItemToObject(root, "summary", summary);
-
-    cJSON *cases = cJSON_AddArrayToObject(root, "cases");
-    for (size_t i = 0; i < results->result_count; ++i) {
-        cJSON_AddItemToArray(cases, comparison_json(&results->results[i]));
+    cJSON *counts = cJSON_CreateObject();
+    cJSON_AddNumberToObject(counts, "totalCases", (double)summary->total_cases);
+    cJSON_AddNumberToObject(counts, "passed", (double)summary->passed);
+    cJSON_AddNumberToObject(counts, "failed", (double)summary->failed);
+    cJSON_AddNumberToObject(counts, "unchangedCases", (double)summary->unchanged);
+    cJSON_AddNumberToObject(counts, "cacheHits", (double)summary->cache_hits);
+    cJSON_AddItemToObject(counts, "deltaE", metric_stats_json(&summary->stats.delta_e));
+    cJSON_AddItemToObject(counts, "l", metric_stats_json(&summary->stats.l));
+    cJSON_AddItemToObject(counts, "a", metric_stats_json(&summary->stats.a));
+    cJSON_AddItemToObject(counts, "b", metric_stats_json(&summary->stats.b));
+    cJSON_AddItemToObject(counts, "rgbR", metric_stats_json(&summary->stats.rgb_r));
+    cJSON_AddItemToObject(counts, "rgbG", metric_stats_json(&summary->stats.rgb_g));
+    cJSON_AddItemToObject(counts, "rgbB", metric_stats_json(&summary->stats.rgb_b));
+    cJSON_AddItemToObject(counts, "deltaEHistogram", histogram_json(&summary->stats.delta_e_hist));
+    cJSON_AddItemToObject(root, "summary", counts);
+    return root;
+}
+
+/* Writes `rendered` with `depth` extra tabs after each newline, so a separately
+ * printed node lines up with cJSON_Print's formatting of its parent. */
+static void write_indented(FILE *file, const char *rendered, size_t depth) {
+    for (const char *p = rendered; p && *p; ++p) {
+        fputc(*p, file);
+        for (size_t d = 0; *p == '\n' && d < depth; ++d) {
+            fputc('\t', file);
+        }
     }
+}
 
+/* Opens report.json and writes the header members, leaving the cases array open. */
+static FILE *open_report_envelope(const char *artifacts_root, const cJSON *header, ValidationError *error) {
     char path[MAX_PATH_LENGTH];
     snprintf(path, sizeof(path), "%s/report.json", artifacts_root);
     FILE *file = fopen(path, "w");
     if (!file) {
-        cJSON_Delete(root);
         set_error(error, "failed to write run report");
+        return NULL;
+    }
+    fputs("{\n", file);
+    for (const cJSON *item = header->child; item; item = item->next) {
+        char *rendered = cJSON_Print(item);
+        fprintf(file, "\t\"%s\":\t", item->string);
+        write_indented(file, rendered, 1);
+        fputs(",\n", file);
+        free(rendered);
+    }
+    fputs("\t\"cases\":\t[", file);
+    return file;
+}
+
+/* Entries sit two levels deep and are separated the way cJSON_Print separates array items. */
+static void write_report_case(FILE *file, const cJSON *case_json, size_t index) {
+    char *rendered = cJSON_Print(case_json);
+    fputs(index > 0 ? ", " : "", file);
+    write_indented(file, rendered, 2);
+    free(rendered);
+}
+
+static int close_report_envelope(FILE *file, ValidationError *error) {
+    fputs("]\n}", file);
+    const int failed = ferror(file);
+    if (fclose(file) != 0 || failed) {
+        set_error(error, "failed to write run report");
+        return -1;
+    }
+    return 0;
+}
+
+/*
+ * Spill record: header, then the case entry and optional metadata.json body as
+ * unformatted JSON without topContributors. Contributor z-scores need the final
+ * run stats, so they are ranked from the extremes when the spill is replayed.
+ */
+typedef struct {
+    char input_case_id[MAX_ID_LENGTH];
+    ContributorExtremes extremes;
+    size_t case_length;
+    size_t metadata_length;
+} CaseSpillHeader;
+
+int open_case_spill(CaseSpill *spill, ValidationError *error) {
+    if (!spill) {
+        set_error(error, "invalid case spill arguments");
+        return -1;
+    }
+    spill->case_count = 0;
+    spill->file = tmpfile();
+    if (!spill->file) {
+        set_error(error, "failed to create case spill file");
         return -1;
     }
+    return 0;
+}
 
-    /* Pretty-print to keep summary fields visible to line-oriented test readers. */
-    char *rendered = cJSON_Print(root);
-    if (rendered) {
-        /* Normalize indentation so substring searches with spaces succeed. */
-        for (char *p = rendered; *p; ++p) {
-            if (*p == '\t') {
-                *p = ' ';
-            }
+static int write_spill_record(CaseSpill *spill,
+                              const char *input_case_id,
+                              const ContributorExtremes *extremes,
+                              const char *case_text,
+                              const char *metadata_text) {
+    CaseSpillHeader header;
+    memset(&header, 0, sizeof(header));
+    strncpy(header.input_case_id, input_case_id, sizeof(header.input_case_id) - 1);
+    header.extremes = *extremes;
+    header.case_length = strlen(case_text);
+    header.metadata_length = metadata_text ? strlen(metadata_text) : 0;
+    if (fwrite(&header, sizeof(header), 1, spill->file) != 1 ||
+        fwrite(case_text, 1, header.case_length, spill->file) != header.case_length ||
+        (metadata_text && fwrite(metadata_text, 1, header.metadata_length, spill->file) != header.metadata_length)) {
+        return -1;
+    }
+    spill->case_count++;
+    return 0;
+}
+
+int spill_case(CaseSpill *spill,
+               const InputCase *input_case,
+               const ComparisonResult *result,
+               int include_samples,
+               int write_metadata,
+               ValidationError *error) {
+    if (!spill || !spill->file || !input_case || !result) {
+        set_error(error, "invalid case spill arguments");
+        return -1;
+    }
+
+    ComparisonResult entry = *result;
+    entry.contributors = NULL;
+    entry.contributor_count = 0;
+    cJSON *case_json = comparison_json(&entry, include_samples);
+    char *case_text = cJSON_PrintUnformatted(case_json);
+    cJSON_Delete(case_json);
+
+    char *metadata_text = NULL;
+    if (write_metadata) {
+        cJSON *metadata_json = case_metadata_json(input_case, result);
+        metadata_text = cJSON_PrintUnformatted(metadata_json);
+        cJSON_Delete(metadata_json);
+    }
+
+    ContributorExtremes extremes;
+    collect_contributor_extremes(result, &extremes);
+    int status = case_text && (!write_metadata || metadata_text) ? 0 : -1;
+    if (status == 0) {
+        status = write_spill_record(spill, input_case->id, &extremes, case_text, metadata_text);
+    }
+    free(case_text);
+    free(metadata_text);
+    if (status != 0) {
+        set_error(error, "failed to spill case result");
+        return -1;
+    }
+    return 0;
+}
+
+static cJSON *read_spilled_json(FILE *file, size_t length) {
+    char *text = (char *)malloc(length + 1);
+    if (!text) {
+        return NULL;
+    }
+    cJSON *node = NULL;
+    if (fread(text, 1, length, file) == length) {
+        text[length] = '\0';
+        node = cJSON_Parse(text);
+    }
+    free(text);
+    return node;
+}
+
+static cJSON *extremes_json(const ContributorExtremes *extremes) {
+    cJSON *root = cJSON_CreateObject();
+    cJSON_AddNumberToObject(root, "sampleCount", (double)extremes->sample_count);
+    cJSON_AddItemToObject(root, "magnitude", cJSON_CreateDoubleArray(extremes->magnitude, CONTRIBUTOR_METRIC_COUNT));
+    cJSON_AddItemToObject(root, "signedValue", cJSON_CreateDoubleArray(extremes->signed_value, CONTRIBUTOR_METRIC_COUNT));
+    return root;
+}
+
+static int parse_extremes(const cJSON *node, ContributorExtremes *extremes) {
+    const cJSON *count = cJSON_GetObjectItemCaseSensitive(node, "sampleCount");
+    const cJSON *magnitude = cJSON_GetObjectItemCaseSensitive(node, "magnitude");
+    const cJSON *signed_value = cJSON_GetObjectItemCaseSensitive(node, "signedValue");
+    if (!cJSON_IsNumber(count) ||
+        cJSON_GetArraySize(magnitude) != CONTRIBUTOR_METRIC_COUNT ||
+        cJSON_GetArraySize(signed_value) != CONTRIBUTOR_METRIC_COUNT) {
+        return -1;
+    }
+    memset(extremes, 0, sizeof(ContributorExtremes));
+    extremes->sample_count = (size_t)count->valuedouble;
+    for (int i = 0; i < CONTRIBUTOR_METRIC_COUNT; ++i) {
+        extremes->magnitude[i] = cJSON_GetArrayItem(magnitude, i)->valuedouble;
+        extremes->signed_value[i] = cJSON_GetArrayItem(signed_value, i)->valuedouble;
+    }
+    return 0;
+}
+
+int export_case_spill(CaseSpill *spill, const char *path, ValidationError *error) {
+    if (!spill || !spill->file || !path) {
+        set_error(error, "invalid case spill arguments");
+        return -1;
+    }
+    FILE *out = fopen(path, "w");
+    if (!out) {
+        set_error(error, "failed to create shard case file");
+        return -1;
+    }
+
+    int status = 0;
+    rewind(spill->file);
+    for (size_t i = 0; i < spill->case_count && status == 0; ++i) {
+        CaseSpillHeader header;
+        cJSON *case_json = NULL;
+        cJSON *metadata_json = NULL;
+        if (fread(&header, sizeof(header), 1, spill->file) != 1 ||
+            !(case_json = read_spilled_json(spill->file, header.case_length)) ||
+            (header.metadata_length > 0 && !(metadata_json = read_spilled_json(spill->file, header.metadata_length)))) {
+            cJSON_Delete(case_json);
+            status = -1;
+            break;
         }
+        cJSON *line = cJSON_CreateObject();
+        cJSON_AddStringToObject(line, "inputCaseId", header.input_case_id);
+        cJSON_AddItemToObject(line, "extremes", extremes_json(&header.extremes));
+        cJSON_AddItemToObject(line, "case", case_json);
+        if (metadata_json) {
+            cJSON_AddItemToObject(line, "metadata", metadata_json);
+        }
+        char *rendered = cJSON_PrintUnformatted(line);
+        if (!rendered || fputs(rendered, out) == EOF || fputc('\n', out) == EOF) {
+            status = -1;
+        }
+        free(rendered);
+        cJSON_Delete(line);
     }
-    fprintf(file, "%s", rendered);
-    fclose(file);
-    free(rendered);
+    if (fclose(out) != 0) {
+        status = -1;
+    }
+    if (status != 0) {
+        set_error(error, "failed to write shard case file");
+    }
+    return status;
+}
+
+int spill_case_line(CaseSpill *spill, const char *line, char *input_case_id, size_t id_capacity, ValidationError *error) {
+    if (!spill || !spill->file || !line || !input_case_id || id_capacity == 0) {
+        set_error(error, "invalid case spill arguments");
+        return -1;
+    }
+    cJSON *root = cJSON_Parse(line);
+    const cJSON *id = cJSON_GetObjectItemCaseSensitive(root, "inputCaseId");
+    const cJSON *case_json = cJSON_GetObjectItemCaseSensitive(root, "case");
+    const cJSON *metadata_json = cJSON_GetObjectItemCaseSensitive(root, "metadata");
+    ContributorExtremes extremes;
+    if (!cJSON_IsString(id) || !cJSON_IsObject(case_json) ||
+        parse_extremes(cJSON_GetObjectItemCaseSensitive(root, "extremes"), &extremes) != 0) {
+        cJSON_Delete(root);
+        set_error(error, "malformed shard case entry");
+        return -1;
+    }
+    strncpy(input_case_id, id->valuestring, id_capacity - 1);
+    input_case_id[id_capacity - 1] = '\0';
+
+    char *case_text = cJSON_PrintUnformatted(case_json);
+    char *metadata_text = metadata_json ? cJSON_PrintUnformatted(metadata_json) : NULL;
+    int status = case_text && (!metadata_json || metadata_text) ? 0 : -1;
+    if (status == 0) {
+        status = write_spill_record(spill, input_case_id, &extremes, case_text, metadata_text);
+    }
+    free(case_text);
+    free(metadata_text);
     cJSON_Delete(root);
-    return 0;
+    if (status != 0) {
+        set_error(error, "failed to spill case result");
+    }
+    return status;
+}
+
+int write_spilled_run_report(const char *artifacts_root,
+                             const RunProvenance *provenance,
+                             const RunSummary *summary,
+                             CaseSpill *spill,
+                             const ToleranceConfig *tolerance,
+                             ValidationError *error) {
+    if (!artifacts_root || !provenance || !summary || !spill || !spill->file) {
+        set_error(error, "invalid report arguments");
+        return -1;
+    }
+    if (ensure_directory(artifacts_root, error) != 0) {
+        return -1;
+    }
+
+    cJSON *envelope = run_report_header_json(artifacts_root, provenance, summary, tolerance);
+    FILE *file = open_report_envelope(artifacts_root, envelope, error);
+    cJSON_Delete(envelope);
+    if (!file) {
+        return -1;
+    }
+
+    int status = 0;
+    rewind(spill->file);
+    for (size_t i = 0; i < spill->case_count && status == 0; ++i) {
+        CaseSpillHeader header;
+        cJSON *case_json = NULL;
+        cJSON *metadata_json = NULL;
+        if (fread(&header, sizeof(header), 1, spill->file) != 1 ||
+            !(case_json = read_spilled_json(spill->file, header.case_length)) ||
+            (header.metadata_length > 0 && !(metadata_json = read_spilled_json(spill->file, header.metadata_length)))) {
+            cJSON_Delete(case_json);
+            set_error(error, "failed to read spilled case result");
+            status = -1;
+            break;
+        }
+
+        Contributor *contributors = NULL;
+        size_t contributor_count = 0;
+        if (rank_contributors(&header.extremes, summary, 3, &contributors, &contributor_count, error) != 0) {
+            fprintf(stderr, "Failed to compute contributors for case %s: %s\n",
+                    header.input_case_id,
+                    error && error->message ? error->message : "unknown error");
+        }
+        add_contributors_json(case_json, contributors, contributor_count);
+
+        /* Columnar runs carry case metadata in run.cjcol and report.json. */
+        if (metadata_json) {
+            add_contributors_json(metadata_json, contributors, contributor_count);
+            if (write_metadata_file(artifacts_root, header.input_case_id, metadata_json, error) != 0) {
+                fprintf(stderr, "Failed to write metadata for case %s: %s\n",
+                        header.input_case_id,
+                        error && error->message ? error->message : "unknown error");
+            }
+        }
+        free(contributors);
+
+        write_report_case(file, case_json, i);
+        cJSON_Delete(case_json);
+        cJSON_Delete(metadata_json);
+    }
+
+    if (status != 0) {
+        fclose(file);
+        return -1;
+    }
+    return close_report_envelope(file, error);
+}
+
+void close_case_spill(CaseSpill *spill) {
+    if (!spill) {
+        return;
+    }
+    if (spill->file) {
+        fclose(spill->file);
+        spill->file = NULL;
+    }
+    spill->case_count = 0;
 }
@@ -0,0 +1,292 @@
+/*
+ * Content-addressed result store and case-hash manifests.
+ *
+ * A case key is the FNV-1a 64-bit hash of the case's compact JSON text,
+ * both runner binaries and the applied tolerances. Engine outputs for a key
+ * are cached as <store>/<hh>/<key>.json (canonical line, alternate line),
+ * so unchanged cases skip process execution entirely. Every run also
+ * writes <artifacts>/case-hashes.tsv ("key<TAB>passed<TAB>id" per case),
+ * which --since uses to re-run only cases whose key changed.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "types.h"
+
+#define FNV1A64_OFFSET 0xcbf29ce484222325ULL
+#define FNV1A64_PRIME 0x100000001b3ULL
+
+static void set_error(ValidationError *error, const char *message) {
+    if (!error || !message) {
+        return;
+    }
+    free(error->message);
+    size_t len = strlen(message);
+    error->message = (char *)malloc(len + 1);
+    if (error->message) {
+        memcpy(error->message, message, len + 1);
+    }
+}
+
+uint64_t fnv1a64_update(uint64_t hash, const void *data, size_t length) {
+    const unsigned char *bytes = (const unsigned char *)data;
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= bytes[i];
+        hash *= FNV1A64_PRIME;
+    }
+    return hash;
+}
+
+static uint64_t fnv1a64_update_u64(uint64_t hash, uint64_t value) {
+    unsigned char bytes[8];
+    for (int i = 0; i < 8; ++i) {
+        bytes[i] = (unsigned char)(value >> (8 * i));
+    }
+    return fnv1a64_update(hash, bytes, sizeof(bytes));
+}
+
+static uint64_t fnv1a64_update_double(uint64_t hash, double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return fnv1a64_update_u64(hash, bits);
+}
+
+int hash_file_contents(const char *path, uint64_t *out, ValidationError *error) {
+    if (!path || !out) {
+        set_error(error, "invalid hash arguments");
+        return -1;
+    }
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        set_error(error, "failed to open file for hashing");
+        return -1;
+    }
+    uint64_t hash = FNV1A64_OFFSET;
+    unsigned char buffer[65536];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        hash = fnv1a64_update(hash, buffer, read);
+    }
+    const int failed = ferror(file);
+    fclose(file);
+    if (failed) {
+        set_error(error, "failed to read file for hashing");
+        return -1;
+    }
+    *out = hash;
+    return 0;
+}
+
+uint64_t hash_tolerances(const ToleranceConfig *tolerance) {
+    uint64_t hash = FNV1A64_OFFSET;
+    if (!tolerance) {
+        return hash;
+    }
+    hash = fnv1a64_update_double(hash, tolerance->abs.l);
+    hash = fnv1a64_update_double(hash, tolerance->abs.a);
+    hash = fnv1a64_update_double(hash, tolerance->abs.b);
+    hash = fnv1a64_update_double(hash, tolerance->abs.deltaE);
+    hash = fnv1a64_update_double(hash, tolerance->rel.l);
+    hash = fnv1a64_update_double(hash, tolerance->rel.a);
+    hash = fnv1a64_update_double(hash, tolerance->rel.b);
+    return hash;
+}
+
+uint64_t compute_case_key(const char *case_text, size_t case_length, uint64_t engine_hash, uint64_t tolerance_hash) {
+    uint64_t hash = fnv1a64_update(FNV1A64_OFFSET, case_text, case_length);
+    hash = fnv1a64_update_u64(hash, engine_hash);
+    return fnv1a64_update_u64(hash, tolerance_hash);
+}
+
+static void store_entry_path(const char *store_root, uint64_t key, char *dir, size_t dir_size, char *path, size_t path_size) {
+    snprintf(dir, dir_size, "%s/%02x", store_root, (unsigned)(key >> 56));
+    snprintf(path, path_size, "%s/%016llx.json", dir, (unsigned long long)key);
+}
+
+int load_cached_outputs(const char *store_root,
+                        uint64_t key,
+                        EngineOutput *canonical,
+                        EngineOutput *alternate,
+                        ValidationError *error) {
+    if (!store_root || !canonical || !alternate) {
+        set_error(error, "invalid result store arguments");
+        return -1;
+    }
+    char dir[MAX_PATH_LENGTH];
+    char path[MAX_PATH_LENGTH + 32];
+    store_entry_path(store_root, key, dir, sizeof(dir), path, sizeof(path));
+
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return 0;
+    }
+    fseek(file, 0, SEEK_END);
+    const long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char *buffer = length > 0 ? (char *)malloc((size_t)length + 1) : NULL;
+    if (!buffer || fread(buffer, 1, (size_t)length, file) != (size_t)length) {
+        free(buffer);
+        fclose(file);
+        return 0;
+    }
+    fclose(file);
+    buffer[length] = '\0';
+
+    /* A damaged entry is treated as a miss and overwritten by the next store. */
+    char *separator = strchr(buffer, '\n');
+    int status = 0;
+    if (separator) {
+        *separator = '\0';
+        if (parse_engine_output(buffer, canonical, NULL) == 0) {
+            if (parse_engine_output(separator + 1, alternate, NULL) == 0) {
+                status = 1;
+            } else {
+                free_engine_output(canonical);
+            }
+        }
+    }
+    free(buffer);
+    return status;
+}
+
+int store_cached_outputs(const char *store_root,
+                         uint64_t key,
+                         const EngineOutput *canonical,
+                         const EngineOutput *alternate,
+                         ValidationError *error) {
+    if (!store_root || !canonical || !alternate) {
+        set_error(error, "invalid result store arguments");
+        return -1;
+    }
+    char dir[MAX_PATH_LENGTH];
+    char path[MAX_PATH_LENGTH + 32];
+    char temp_path[MAX_PATH_LENGTH + 48];
+    store_entry_path(store_root, key, dir, sizeof(dir), path, sizeof(path));
+    if (ensure_directory(store_root, error) != 0 || ensure_directory(dir, error) != 0) {
+        return -1;
+    }
+
+    char *canonical_json = render_engine_output_json(canonical);
+    char *alternate_json = render_engine_output_json(alternate);
+    if (!canonical_json || !alternate_json) {
+        free(canonical_json);
+        free(alternate_json);
+        set_error(error, "failed to render cached engine output");
+        return -1;
+    }
+
+    /* Write then rename so concurrent runs never observe a partial entry. */
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp", path);
+    FILE *file = fopen(temp_path, "wb");
+    int status = -1;
+    if (file) {
+        fprintf(file, "%s\n%s\n", canonical_json, alternate_json);
+        status = fclose(file) == 0 ? 0 : -1;
+    }
+    if (status == 0 && rename(temp_path, path) != 0) {
+        remove(temp_path);
+        status = -1;
+    }
+    free(canonical_json);
+    free(alternate_json);
+    if (status != 0) {
+        set_error(error, "failed to write result store entry");
+    }
+    return status;
+}
+
+static size_t manifest_slot(const CaseManifest *manifest, const char *id) {
+    const uint64_t hash = fnv1a64_update(FNV1A64_OFFSET, id, strlen(id));
+    size_t slot = (size_t)(hash & (manifest->capacity - 1));
+    while (manifest->entries[slot].id[0] != '\0' && strcmp(manifest->entries[slot].id, id) != 0) {
+        slot = (slot + 1) & (manifest->capacity - 1);
+    }
+    return slot;
+}
+
+static int manifest_insert(CaseManifest *manifest, const char *id, uint64_t key, int passed) {
+    if ((manifest->count + 1) * 2 > manifest->capacity) {
+        const size_t capacity = manifest->capacity ? manifest->capacity * 2 : 1024;
+        CaseManifestEntry *old_entries = manifest->entries;
+        const size_t old_capacity = manifest->capacity;
+        manifest->entries = (CaseManifestEntry *)calloc(capacity, sizeof(CaseManifestEntry));
+        if (!manifest->entries) {
+            manifest->entries = old_entries;
+            return -1;
+        }
+        manifest->capacity = capacity;
+        for (size_t i = 0; i < old_capacity; ++i) {
+            if (old_entries[i].id[0] != '\0') {
+                manifest->entries[manifest_slot(manifest, old_entries[i].id)] = old_entries[i];
+            }
+        }
+        free(old_entries);
+    }
+    CaseManifestEntry *entry = &manifest->entries[manifest_slot(manifest, id)];
+    if (entry->id[0] == '\0') {
+        strncpy(entry->id, id, sizeof(entry->id) - 1);
+        manifest->count++;
+    }
+    entry->key = key;
+    entry->passed = passed;
+    return 0;
+}
+
+int load_case_manifest(const char *artifacts_root, CaseManifest *manifest, ValidationError *error) {
+    if (!artifacts_root || !manifest) {
+        set_error(error, "invalid manifest arguments");
+        return -1;
+    }
+    memset(manifest, 0, sizeof(CaseManifest));
+
+    char path[MAX_PATH_LENGTH + 32];
+    snprintf(path, sizeof(path), "%s/%s", artifacts_root, CASE_MANIFEST_NAME);
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        set_error(error, "failed to open previous run case-hashes.tsv");
+        return -1;
+    }
+
+    char line[MAX_ID_LENGTH + 64];
+    while (fgets(line, sizeof(line), file)) {
+        unsigned long long key = 0;
+        int passed = 0;
+        int consumed = 0;
+        line[strcspn(line, "\r\n")] = '\0';
+        if (sscanf(line, "%16llx\t%d\t%n", &key, &passed, &consumed) != 2 || line[consumed] == '\0') {
+            continue;
+        }
+        if (manifest_insert(manifest, line + consumed, (uint64_t)key, passed) != 0) {
+            fclose(file);
+            free_case_manifest(manifest);
+            set_error(error, "failed to allocate case manifest");
+            return -1;
+        }
+    }
+    fclose(file);
+    return 0;
+}
+
+const CaseManifestEntry *find_case_manifest_entry(const CaseManifest *manifest, const char *id) {
+    if (!manifest || !manifest->entries || !id) {
+        return NULL;
+    }
+    const CaseManifestEntry *entry = &manifest->entries[manifest_slot(manifest, id)];
+    return entry->id[0] != '\0' ? entry : NULL;
+}
+
+void free_case_manifest(CaseManifest *manifest) {
+    if (!manifest) {
+        return;
+    }
+    free(manifest->entries);
+    memset(manifest, 0, sizeof(CaseManifest));
+}
+
+void write_case_manifest_line(FILE *file, const char *id, uint64_t key, int passed) {
+    if (file) {
+        fprintf(file, "%016llx\t%d\t%s\n", (unsigned long long)key, passed ? 1 : 0, id);
+    }
+}
@@ -0,0 +1,585 @@
+/*
+ * Sharded execution: deterministic case partitioning, per-shard summaries
+ * and merging shard artifact directories into a single run.
+ *
+ * A case belongs to shard FNV-1a(id) mod N, so membership depends only on
+ * the case id and shard count, never on corpus order or the machine.
+ * Each shard writes shard.json next to its report.json; the summary holds
+ * the shard's counts, provenance and its serialized MetricSketches, which
+ * merge into the same statistics a single unsharded run would report.
+ * shard-cases.jsonl carries one case entry per line so merge can stream
+ * cases shard by shard instead of loading every report.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cJSON.h"
+#include "types.h"
+#include "../stats/stats.h"
+
+static void set_error(ValidationError *error, const char *message) {
+    if (!error || !message) {
+        return;
+    }
+    free(error->message);
+    size_t len = strlen(message);
+    error->message = (char *)malloc(len + 1);
+    if (error->message) {
+        memcpy(error->message, message, len + 1);
+    }
+}
+
+int parse_shard_spec(const char *spec, size_t *index, size_t *count) {
+    if (!spec || !index || !count) {
+        return -1;
+    }
+    char *end = NULL;
+    const unsigned long i = strtoul(spec, &end, 10);
+    if (end == spec || *end != '/') {
+        return -1;
+    }
+    const char *count_start = end + 1;
+    const unsigned long n = strtoul(count_start, &end, 10);
+    if (end == count_start || *end != '\0' || n == 0 || i >= n) {
+        return -1;
+    }
+    *index = (size_t)i;
+    *count = (size_t)n;
+    return 0;
+}
+
+size_t shard_for_case(const char *case_id, size_t shard_count) {
+    if (!case_id || shard_count <= 1) {
+        return 0;
+    }
+    return (size_t)(fnv1a64_update(0xcbf29ce484222325ULL, case_id, strlen(case_id)) % shard_count);
+}
+
+static char *read_text_file(const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    const long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char *buffer = length >= 0 ? (char *)malloc((size_t)length + 1) : NULL;
+    if (buffer && fread(buffer, 1, (size_t)length, file) != (size_t)length) {
+        free(buffer);
+        buffer = NULL;
+    }
+    fclose(file);
+    if (buffer) {
+        buffer[length] = '\0';
+    }
+    return buffer;
+}
+
+static cJSON *read_json_file(const char *path) {
+    char *text = read_text_file(path);
+    if (!text) {
+        return NULL;
+    }
+    cJSON *root = cJSON_Parse(text);
+    free(text);
+    return root;
+}
+
+static int write_json_file(const char *path, const cJSON *root) {
+    FILE *file = fopen(path, "w");
+    if (!file) {
+        return -1;
+    }
+    char *rendered = cJSON_Print(root);
+    if (rendered) {
+        fprintf(file, "%s", rendered);
+    }
+    free(rendered);
+    return fclose(file) == 0 && rendered ? 0 : -1;
+}
+
+static int copy_file(const char *from, const char *to) {
+    FILE *in = fopen(from, "rb");
+    if (!in) {
+        return -1;
+    }
+    FILE *out = fopen(to, "wb");
+    if (!out) {
+        fclose(in);
+        return -1;
+    }
+    char buffer[65536];
+    size_t read;
+    int status = 0;
+    while ((read = fread(buffer, 1, sizeof(buffer), in)) > 0) {
+        if (fwrite(buffer, 1, read, out) != read) {
+            status = -1;
+            break;
+        }
+    }
+    fclose(in);
+    if (fclose(out) != 0) {
+        status = -1;
+    }
+    return status;
+}
+
+static double json_number(const cJSON *object, const char *key, double fallback) {
+    const cJSON *node = cJSON_GetObjectItemCaseSensitive(object, key);
+    return cJSON_IsNumber(node) ? node->valuedouble : fallback;
+}
+
+static const char *json_string(const cJSON *object, const char *key) {
+    const cJSON *node = cJSON_GetObjectItemCaseSensitive(object, key);
+    return cJSON_IsString(node) ? node->valuestring : NULL;
+}
+
+static cJSON *metric_sketch_json(const MetricSketch *sketch) {
+    cJSON *root = cJSON_CreateObject();
+    cJSON_AddNumberToObject(root, "count", (double)sketch->moments.count);
+    cJSON_AddNumberToObject(root, "mean", sketch->moments.mean);
+    cJSON_AddNumberToObject(root, "m2", sketch->moments.m2);
+    cJSON_AddNumberToObject(root, "min", sketch->moments.min);
+    cJSON_AddNumberToObject(root, "max", sketch->moments.max);
+    cJSON_AddNumberToObject(root, "alpha", sketch->quantiles.alpha);
+    cJSON_AddNumberToObject(root, "zeroCount", (double)sketch->quantiles.zero_count);
+    cJSON_AddNumberToObject(root, "minIndex", (double)sketch->quantiles.min_index);
+    cJSON *bins = cJSON_AddArrayToObject(root, "bins");
+    for (size_t i = 0; i < sketch->quantiles.bin_count; ++i) {
+        cJSON_AddItemToArray(bins, cJSON_CreateNumber((double)sketch->quantiles.bins[i]));
+    }
+    return root;
+}
+
+static int parse_metric_sketch(const cJSON *node, MetricSketch *sketch) {
+    const cJSON *bins = cJSON_GetObjectItemCaseSensitive(node, "bins");
+    if (!cJSON_IsObject(node) || !cJSON_IsArray(bins) ||
+        quantile_sketch_init(&sketch->quantiles, json_number(node, "alpha", 0.0)) != 0) {
+        return -1;
+    }
+    running_moments_init(&sketch->moments);
+    sketch->moments.count = (uint64_t)json_number(node, "count", 0.0);
+    sketch->moments.mean = json_number(node, "mean", 0.0);
+    sketch->moments.m2 = json_number(node, "m2", 0.0);
+    sketch->moments.min = json_number(node, "min", 0.0);
+    sketch->moments.max = json_number(node, "max", 0.0);
+
+    const uint64_t zero_count = (uint64_t)json_number(node, "zeroCount", 0.0);
+    sketch->quantiles.zero_count = zero_count;
+    sketch->quantiles.count = zero_count;
+    const int32_t min_index = (int32_t)json_number(node, "minIndex", 0.0);
+    int32_t offset = 0;
+    const cJSON *bin = NULL;
+    cJSON_ArrayForEach(bin, bins) {
+        if (!cJSON_IsNumber(bin) ||
+            quantile_sketch_add_bin(&sketch->quantiles, min_index + offset, (uint64_t)bin->valuedouble) != 0) {
+            quantile_sketch_free(&sketch->quantiles);
+            return -1;
+        }
+        offset++;
+    }
+    return 0;
+}
+
+static cJSON *tolerance_json(const ToleranceConfig *tolerance) {
+    cJSON *root = cJSON_CreateObject();
+    cJSON *abs = cJSON_AddObjectToObject(root, "abs");
+    cJSON_AddNumberToObject(abs, "l", tolerance->abs.l);
+    cJSON_AddNumberToObject(abs, "a", tolerance->abs.a);
+    cJSON_AddNumberToObject(abs, "b", tolerance->abs.b);
+    cJSON_AddNumberToObject(abs, "deltaE", tolerance->abs.deltaE);
+    cJSON *rel = cJSON_AddObjectToObject(root, "rel");
+    cJSON_AddNumberToObject(rel, "l", tolerance->rel.l);
+    cJSON_AddNumberToObject(rel, "a", tolerance->rel.a);
+    cJSON_AddNumberToObject(rel, "b", tolerance->rel.b);
+    return root;
+}
+
+static void parse_tolerance(const cJSON *node, ToleranceConfig *tolerance) {
+    const cJSON *abs = cJSON_GetObjectItemCaseSensitive(node, "abs");
+    const cJSON *rel = cJSON_GetObjectItemCaseSensitive(node, "rel");
+    tolerance->abs.l = json_number(abs, "l", 0.0);
+    tolerance->abs.a = json_number(abs, "a", 0.0);
+    tolerance->abs.b = json_number(abs, "b", 0.0);
+    tolerance->abs.deltaE = json_number(abs, "deltaE", 0.0);
+    tolerance->rel.l = json_number(rel, "l", 0.0);
+    tolerance->rel.a = json_number(rel, "a", 0.0);
+    tolerance->rel.b = json_number(rel, "b", 0.0);
+}
+
+/* 64-bit keys do not survive a JSON number, so hashes are stored as hex strings. */
+static void add_hash(cJSON *object, const char *key, uint64_t hash) {
+    char hex[17];
+    snprintf(hex, sizeof(hex), "%016llx", (unsigned long long)hash);
+    cJSON_AddStringToObject(object, key, hex);
+}
+
+static int json_strings_match(const cJSON *a, const cJSON *b, const char *key) {
+    const char *left = json_string(a, key);
+    const char *right = json_string(b, key);
+    return left && right ? strcmp(left, right) == 0 : left == right;
+}
+
+int write_shard_summary(const char *artifacts_root,
+                        size_t shard_index,
+                        size_t shard_count,
+                        const RunProvenance *provenance,
+                        const ToleranceConfig *tolerance,
+                        uint64_t engine_hash,
+                        uint64_t tolerance_hash,
+                        const RunSummary *summary,
+                        const MetricSketch *sketches,
+                        ValidationError *error) {
+    if (!artifacts_root || !provenance || !tolerance || !summary || !sketches) {
+        set_error(error, "invalid shard summary arguments");
+        return -1;
+    }
+
+    cJSON *root = cJSON_CreateObject();
+    cJSON_AddNumberToObject(root, "shardIndex", (double)shard_index);
+    cJSON_AddNumberToObject(root, "shardCount", (double)shard_count);
+    cJSON_AddStringToObject(root, "corpusVersion", provenance->corpus_version ? provenance->corpus_version : "unknown");
+    add_hash(root, "engineHash", engine_hash);
+    add_hash(root, "toleranceHash", tolerance_hash);
+    if (provenance->artifact_policy) {
+        cJSON_AddStringToObject(root, "artifactPolicy", provenance->artifact_policy);
+    }
+    if (provenance->artifact_format) {
+        cJSON_AddStringToObject(root, "artifactFormat", provenance->artifact_format);
+    }
+
+    cJSON *prov = cJSON_AddObjectToObject(root, "provenance");
+    cJSON_AddStringToObject(prov, "cCommit", provenance->c_commit ? provenance->c_commit : "unknown");
+    cJSON_AddStringToObject(prov, "wasmCommit", provenance->wasm_commit ? provenance->wasm_commit : "unknown");
+    cJSON_AddStringToObject(prov, "platform", provenance->platform ? provenance->platform : "unknown");
+    if (provenance->c_build_flags) {
+        cJSON_AddStringToObject(prov, "cBuildFlags", provenance->c_build_flags);
+    }
+    if (provenance->alt_build_flags) {
+        cJSON_AddStringToObject(prov, "altBuildFlags", provenance->alt_build_flags);
+    }
+    cJSON_AddItemToObject(prov, "appliedTolerances", tolerance_json(tolerance));
+
+    cJSON *counts = cJSON_CreateObject();
+    cJSON_AddNumberToObject(counts, "totalCases", (double)summary->total_cases);
+    cJSON_AddNumberToObject(counts, "passed", (double)summary->passed);
+    cJSON_AddNumberToObject(counts, "failed", (double)summary->failed);
+    cJSON_AddNumberToObject(counts, "unchangedCases", (double)summary->unchanged);
+    cJSON_AddNumberToObject(counts, "cacheHits", (double)summary->cache_hits);
+    cJSON_AddNumberToObject(counts, "durationMs", summary->duration_ms);
+    cJSON_AddItemToObject(root, "summary", counts);
+
+    cJSON *metrics = cJSON_CreateObject();
+    for (size_t i = 0; i < RUN_METRIC_COUNT; ++i) {
+        cJSON_AddItemToObject(metrics, run_metric_name(i), metric_sketch_json(&sketches[i]));
+    }
+    cJSON_AddItemToObject(root, "sketches", metrics);
+
+    char path[MAX_PATH_LENGTH + 32];
+    snprintf(path, sizeof(path), "%s/%s", artifacts_root, SHARD_SUMMARY_NAME);
+    const int status = write_json_file(path, root);
+    cJSON_Delete(root);
+    if (status != 0) {
+        set_error(error, "failed to write shard summary");
+    }
+    return status;
+}
+
+static int merge_columnar_artifact(const char *shard_root, ColumnarWriter *writer, ValidationError *error) {
+    char path[MAX_PATH_LENGTH + 32];
+    snprintf(path, sizeof(path), "%s/%s", shard_root, COLUMNAR_ARTIFACT_NAME);
+    ColumnarReader reader;
+    if (open_columnar_reader(path, &reader, NULL) != 0) {
+        return 0;
+    }
+    int status = 0;
+    for (size_t e = 0; e < reader.entry_count && status == 0; ++e) {
+        EngineOutput canonical;
+        EngineOutput alternate;
+        ComparisonResult result;
+        status = read_columnar_case(&reader, e, &canonical, &alternate, &result, error);
+        if (status == 0) {
+            status = append_columnar_case(writer, &canonical, &alternate, &result, error);
+            free_engine_output(&canonical);
+            free_engine_output(&alternate);
+            free_comparison_result(&result);
+        }
+    }
+    close_columnar_reader(&reader);
+    return status;
+}
+
+/* Copies a case's engine outputs and diff; metadata.json is rewritten from the spill. */
+static int copy_case_files(const char *shard_root, const char *out_root, const char *case_id, ValidationError *error) {
+    static const char *const files[] = {"canonical.json", "alternate.json", "diff.json"};
+    char from_dir[MAX_PATH_LENGTH];
+    char to_dir[MAX_PATH_LENGTH];
+    char from[MAX_PATH_LENGTH + 32];
+    char to[MAX_PATH_LENGTH + 32];
+    snprintf(from_dir, sizeof(from_dir), "%s/cases/%s", shard_root, case_id);
+    snprintf(to_dir, sizeof(to_dir), "%s/cases/%s", out_root, case_id);
+
+    snprintf(from, sizeof(from), "%s/%s", from_dir, files[0]);
+    FILE *probe = fopen(from, "rb");
+    if (!probe) {
+        return 0; /* Artifact policy skipped this case in the shard. */
+    }
+    fclose(probe);
+    if (ensure_directory(to_dir, error) != 0) {
+        return -1;
+    }
+    for (size_t i = 0; i < sizeof(files) / sizeof(files[0]); ++i) {
+        snprintf(from, sizeof(from), "%s/%s", from_dir, files[i]);
+        snprintf(to, sizeof(to), "%s/%s", to_dir, files[i]);
+        if (copy_file(from, to) != 0) {
+            set_error(error, "failed to copy shard case artifact");
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* Streams one shard's case lines into the merge spill, copying per-case files alongside. */
+static int spill_shard_cases(const char *shard_root, const char *out_root, int columnar, CaseSpill *spill, ValidationError *error) {
+    char path[MAX_PATH_LENGTH + 32];
+    snprintf(path, sizeof(path), "%s/%s", shard_root, SHARD_CASES_NAME);
+    FILE *in = fopen(path, "r");
+    if (!in) {
+        set_error(error, "shard directory is missing shard-cases.jsonl");
+        return -1;
+    }
+    char *line = NULL;
+    size_t capacity = 0;
+    int status = 0;
+    while (status == 0 && getline(&line, &capacity, in) != -1) {
+        char case_id[MAX_ID_LENGTH];
+        status = spill_case_line(spill, line, case_id, sizeof(case_id), error);
+        if (status == 0 && !columnar) {
+            status = copy_case_files(shard_root, out_root, case_id, error);
+        }
+    }
+    if (status == 0 && ferror(in)) {
+        set_error(error, "failed to read shard-cases.jsonl");
+        status = -1;
+    }
+    free(line);
+    fclose(in);
+    return status;
+}
+
+static int append_manifest(const char *shard_root, FILE *out) {
+    char path[MAX_PATH_LENGTH + 32];
+    snprintf(path, sizeof(path), "%s/%s", shard_root, CASE_MANIFEST_NAME);
+    FILE *in = fopen(path, "rb");
+    if (!in) {
+        return 0;
+    }
+    char buffer[65536];
+    size_t read;
+    int status = 0;
+    while (status == 0 && (read = fread(buffer, 1, sizeof(buffer), in)) > 0) {
+        status = fwrite(buffer, 1, read, out) == read ? 0 : -1;
+    }
+    fclose(in);
+    return status;
+}
+
+static char *dup_json_string(const cJSON *object, const char *key) {
+    const char *value = json_string(object, key);
+    return value ? strdup(value) : NULL;
+}
+
+int merge_shard_runs(const char *out_root,
+                     const char *const *shard_roots,
+                     size_t shard_root_count,
+                     const char *run_id,
+                     double pass_gate,
+                     double max_duration_ms,
+                     int allow_partial,
+                     RunSummary *summary_out,
+                     ValidationError *error) {
+    if (!out_root || !shard_roots || shard_root_count == 0) {
+        set_error(error, "merge requires --out and at least one shard directory");
+        return -1;
+    }
+    if (ensure_directory(out_root, error) != 0) {
+        return -1;
+    }
+
+    RunSummary summary = {0};
+    MetricSketch merged_metrics[RUN_METRIC_COUNT];
+    init_run_metrics(merged_metrics);
+    ToleranceConfig tolerance = {0};
+    RunProvenance provenance = {0};
+    cJSON *first = NULL;
+    char corpus_version[MAX_VERSION_LENGTH] = {0};
+    size_t expected_shards = 0;
+    unsigned char *seen_shards = NULL;
+    char *format_copy = NULL;
+    char *policy_copy = NULL;
+    CaseSpill spill = {0};
+    ColumnarWriter writer = {0};
+    int status = 0;
+
+    /* Pass 1: validate shard summaries and merge their counts and sketches. */
+    for (size_t s = 0; s < shard_root_count && status == 0; ++s) {
+        char path[MAX_PATH_LENGTH + 32];
+        snprintf(path, sizeof(path), "%s/%s", shard_roots[s], SHARD_SUMMARY_NAME);
+        cJSON *shard = read_json_file(path);
+        if (!shard) {
+            set_error(error, "shard directory is missing shard.json");
+            status = -1;
+            break;
+        }
+
+        const size_t shard_count = (size_t)json_number(shard, "shardCount", 0.0);
+        const size_t shard_index = (size_t)json_number(shard, "shardIndex", 0.0);
+        if (!first) {
+            expected_shards = shard_count;
+            seen_shards = (unsigned char *)calloc(shard_count ? shard_count : 1, 1);
+            const char *version = json_string(shard, "corpusVersion");
+            strncpy(corpus_version, version ? version : "unknown", sizeof(corpus_version) - 1);
+            parse_tolerance(cJSON_GetObjectItemCaseSensitive(cJSON_GetObjectItemCaseSensitive(shard, "provenance"), "appliedTolerances"), &tolerance);
+            policy_copy = dup_json_string(shard, "artifactPolicy");
+            format_copy = dup_json_string(shard, "artifactFormat");
+        }
+        if (!seen_shards || shard_count != expected_shards || shard_index >= expected_shards ||
+            (first && !json_strings_match(first, shard, "corpusVersion"))) {
+            set_error(error, "shards disagree on shard count or corpus version");
+            status = -1;
+        } else if (first && (!json_strings_match(first, shard, "engineHash") ||
+                             !json_strings_match(first, shard, "toleranceHash"))) {
+            set_error(error, "shards were run with different engine builds or tolerances");
+            status = -1;
+        } else if (first && !json_strings_match(first, shard, "artifactFormat")) {
+            set_error(error, "shards disagree on artifact format");
+            status = -1;
+        } else if (seen_shards[shard_index]) {
+            set_error(error, "shard index given more than once");
+            status = -1;
+        }
+
+        if (status == 0) {
+            seen_shards[shard_index] = 1;
+            const cJSON *counts = cJSON_GetObjectItemCaseSensitive(shard, "summary");
+            summary.total_cases += (size_t)json_number(counts, "totalCases", 0.0);
+            summary.passed += (size_t)json_number(counts, "passed", 0.0);
+            summary.failed += (size_t)json_number(counts, "failed", 0.0);
+            summary.unchanged += (size_t)json_number(counts, "unchangedCases", 0.0);
+            summary.cache_hits += (size_t)json_number(counts, "cacheHits", 0.0);
+            /* Shards run in parallel, so wall time is the slowest shard. */
+            const double duration = json_number(counts, "durationMs", 0.0);
+            if (duration > summary.duration_ms) {
+                summary.duration_ms = duration;
+            }
+
+            const cJSON *sketches = cJSON_GetObjectItemCaseSensitive(shard, "sketches");
+            for (size_t m = 0; m < RUN_METRIC_COUNT && status == 0; ++m) {
+                MetricSketch sketch;
+                if (parse_metric_sketch(cJSON_GetObjectItemCaseSensitive(sketches, run_metric_name(m)), &sketch) != 0) {
+                    set_error(error, "failed to parse shard sketches");
+                    status = -1;
+                    break;
+                }
+                if (metric_sketch_merge(&merged_metrics[m], &sketch) != 0) {
+                    set_error(error, "failed to merge shard sketches");
+                    status = -1;
+                }
+                metric_sketch_free(&sketch);
+            }
+
+            /* Empty shards carry no build flags, so take each field from the first shard that has it. */
+            const cJSON *prov = cJSON_GetObjectItemCaseSensitive(shard, "provenance");
+            if (!provenance.c_commit) provenance.c_commit = dup_json_string(prov, "cCommit");
+            if (!provenance.wasm_commit) provenance.wasm_commit = dup_json_string(prov, "wasmCommit");
+            if (!provenance.platform) provenance.platform = dup_json_string(prov, "platform");
+            if (!provenance.c_build_flags) provenance.c_build_flags = dup_json_string(prov, "cBuildFlags");
+            if (!provenance.alt_build_flags) provenance.alt_build_flags = dup_json_string(prov, "altBuildFlags");
+        }
+        if (!first) {
+            first = shard;
+        } else {
+            cJSON_Delete(shard);
+        }
+    }
+
+    for (size_t i = 0; status == 0 && i < expected_shards; ++i) {
+        if (seen_shards[i]) {
+            continue;
+        }
+        if (!allow_partial) {
+            char message[128];
+            snprintf(message, sizeof(message), "shard %zu/%zu is missing (pass --allow-partial to merge anyway)", i, expected_shards);
+            set_error(error, message);
+            status = -1;
+        } else {
+            fprintf(stderr, "Warning: shard %zu/%zu missing from merge; report covers a partial corpus.\n", i, expected_shards);
+        }
+    }
+
+    if (status == 0) {
+        finalize_run_metrics(merged_metrics, &summary.stats);
+        summary.pass_rate = summary.total_cases > 0 ? (double)summary.passed / (double)summary.total_cases : 0.0;
+    }
+
+    /* Pass 2: stream each shard's cases into one spill; contributors are ranked on replay. */
+    const int columnar = format_copy && strcmp(format_copy, "columnar") == 0;
+    if (status == 0) {
+        status = open_case_spill(&spill, error);
+    }
+    if (status == 0 && columnar) {
+        status = open_columnar_artifact(out_root, &writer, error);
+    }
+    for (size_t s = 0; s < shard_root_count && status == 0; ++s) {
+        status = spill_shard_cases(shard_roots[s], out_root, columnar, &spill, error);
+        if (status == 0 && columnar) {
+            status = merge_columnar_artifact(shard_roots[s], &writer, error);
+        }
+    }
+    if (writer.file && finish_columnar_artifact(&writer, status == 0 ? error : NULL) != 0) {
+        status = -1;
+    }
+
+    if (status == 0) {
+        char path[MAX_PATH_LENGTH + 32];
+        snprintf(path, sizeof(path), "%s/%s", out_root, CASE_MANIFEST_NAME);
+        FILE *manifest = fopen(path, "wb");
+        int manifest_status = manifest ? 0 : -1;
+        for (size_t s = 0; manifest && s < shard_root_count; ++s) {
+            manifest_status |= append_manifest(shard_roots[s], manifest);
+        }
+        if ((manifest && fclose(manifest) != 0) || manifest_status != 0) {
+            fprintf(stderr, "Warning: cannot write %s; --since will not be able to use this run.\n", path);
+        }
+
+        provenance.run_id = (char *)(run_id ? run_id : "merged-run");
+        provenance.corpus_version = corpus_version;
+        provenance.artifacts_root = (char *)out_root;
+        provenance.pass_gate = pass_gate;
+        provenance.max_duration_ms = max_duration_ms;
+        provenance.artifact_policy = policy_copy;
+        provenance.artifact_format = format_copy;
+        status = write_spilled_run_report(out_root, &provenance, &summary, &spill, &tolerance, error);
+    }
+
+    if (summary_out) {
+        *summary_out = summary;
+        memset(&summary_out->stats.delta_e_hist, 0, sizeof(Histogram));
+    }
+
+    close_case_spill(&spill);
+    free_histogram(&summary.stats.delta_e_hist);
+    free_run_metrics(merged_metrics);
+    cJSON_Delete(first);
+    free(seen_shards);
+    free(provenance.c_commit);
+    free(provenance.wasm_commit);
+    free(provenance.platform);
+    free(provenance.c_build_flags);
+    free(provenance.alt_build_flags);
+    free(policy_copy);
+    free(format_copy);
+    return status;
+}
@@ -1,8 +1,12 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/resource.h>
 #include <sys/stat.h>
 #include <sys/wait.h>
+#include <unistd.h>
+
+#include "cJSON.h"
 
 static int file_exists(const char *path) {
     struct stat st;
@@ -40,6 +44,132 @@ static int file_contains(const char *path, const char *needle) {
     return found;
 }
 
+static cJSON *load_json(const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char *text = (char *)malloc((size_t)length + 1);
+    cJSON *root = NULL;
+    if (text && length >= 0 && fread(text, 1, (size_t)length, file) == (size_t)length) {
+        text[length] = '\0';
+        root = cJSON_Parse(text);
+    }
+    free(text);
+    fclose(file);
+    return root;
+}
+
+/* Looks up a dotted member path such as "summary.deltaE.mean". */
+static const cJSON *json_at(const cJSON *root, const char *path) {
+    char key[128];
+    const cJSON *node = root;
+    while (node && *path) {
+        size_t length = strcspn(path, ".");
+        if (length >= sizeof(key)) {
+            return NULL;
+        }
+        memcpy(key, path, length);
+        key[length] = '\0';
+        node = cJSON_GetObjectItemCaseSensitive(node, key);
+        path += length + (path[length] == '.' ? 1 : 0);
+    }
+    return node;
+}
+
+static int report_number_is(const char *path, const char *member, double expected) {
+    cJSON *root = load_json(path);
+    const cJSON *node = json_at(root, member);
+    const int matches = cJSON_IsNumber(node) && node->valuedouble == expected;
+    cJSON_Delete(root);
+    return matches;
+}
+
+static int report_string_is(const char *path, const char *member, const char *expected) {
+    cJSON *root = load_json(path);
+    const cJSON *node = json_at(root, member);
+    const int matches = cJSON_IsString(node) && strcmp(node->valuestring, expected) == 0;
+    cJSON_Delete(root);
+    return matches;
+}
+
+static int reports_match(const char *path, const char *other_path, const char *member) {
+    cJSON *root = load_json(path);
+    cJSON *other = load_json(other_path);
+    const cJSON *node = json_at(root, member);
+    const cJSON *other_node = json_at(other, member);
+    const int matches = cJSON_IsNumber(node) && cJSON_IsNumber(other_node) && node->valuedouble == other_node->valuedouble;
+    cJSON_Delete(root);
+    cJSON_Delete(other);
+    return matches;
+}
+
+/* Samples that reached the run stats, summed over the deltaE histogram buckets. */
+static double report_sample_count(const char *path) {
+    cJSON *root = load_json(path);
+    const cJSON *counts = json_at(root, "summary.deltaEHistogram.counts");
+    double total = 0.0;
+    const cJSON *bucket = NULL;
+    cJSON_ArrayForEach(bucket, counts) {
+        total += bucket->valuedouble;
+    }
+    cJSON_Delete(root);
+    return total;
+}
+
+static int report_case_count(const char *path) {
+    cJSON *root = load_json(path);
+    const cJSON *cases = json_at(root, "cases");
+    const int count = cJSON_IsArray(cases) ? cJSON_GetArraySize(cases) : -1;
+    cJSON_Delete(root);
+    return count;
+}
+
+/* Retaining every case costs roughly 0.14 MB each, so 1000 cases would need ~140 MB;
+ * a spilling run stays near its ~11 MB baseline regardless of the case count. */
+#define RSS_CASES 1000
+#define RSS_CEILING_KB (48 * 1024)
+
+/* Peak RSS in KB of a shell command, measured in a forked child so earlier runs don't count. */
+static long peak_rss_of(const char *command) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return -1;
+    }
+    pid_t pid = fork();
+    if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return -1;
+    }
+    if (pid == 0) {
+        close(fds[0]);
+        long peak = -1;
+        int status = system(command);
+        struct rusage usage;
+        if (status != -1 && WEXITSTATUS(status) == 0 && getrusage(RUSAGE_CHILDREN, &usage) == 0) {
+#ifdef __APPLE__
+            peak = usage.ru_maxrss / 1024;
+#else
+            peak = usage.ru_maxrss;
+#endif
+        }
+        ssize_t written = write(fds[1], &peak, sizeof(peak));
+        _exit(written == (ssize_t)sizeof(peak) ? 0 : 1);
+    }
+    close(fds[1]);
+    long peak = -1;
+    if (read(fds[0], &peak, sizeof(peak)) != (ssize_t)sizeof(peak)) {
+        peak = -1;
+    }
+    close(fds[0]);
+    waitpid(pid, NULL, 0);
+    return peak;
+}
+
 int main(void) {
     const char *artifacts = "tests/output/integration";
     const char *report_path = "tests/output/integration/report.json";
@@ -65,7 +195,7 @@ int main(void) {
     failures += assert_true(exit_code == 0, "parity-runner should exit successfully");
     failures += assert_true(file_exists(report_path), "report.json should be created");
     failures += assert_true(file_contains(report_path, "v20251212.1"), "report should include corpus version");
-    failures += assert_true(file_contains(report_path, "totalCases\": 2"), "report should include summary totals");
+    failures += assert_true(report_number_is(report_path, "summary.totalCases", 2), "report should include summary totals");
     failures += assert_true(file_contains(report_path, "topContributors"), "report should include top contributors");
     failures += assert_true(file_exists(metadata_path), "metadata.json should exist for at least one case");
     failures += assert_true(file_contains(metadata_path, "topContributors"), "metadata should include contributors");
@@ -89,7 +219,7 @@ int main(void) {
     exit_code = WEXITSTATUS(result);
     failures += assert_true(exit_code == 0, "tag-filtered run should exit successfully");
     failures += assert_true(file_exists(tagged_report), "tag-filtered report should be created");
-    failures += assert_true(file_contains(tagged_report, "totalCases\": 1"), "tag-filtered report should include filtered totals");
+    failures += assert_true(report_number_is(tagged_report, "summary.totalCases", 1), "tag-filtered report should include filtered totals");
 
     /* Test tolerance override */
     const char *override_artifacts = "tests/output/integration-tolerance";
@@ -111,7 +241,185 @@ int main(void) {
     exit_code = WEXITSTATUS(result);
     failures += assert_true(exit_code == 0, "tolerance override run should exit successfully");
     failures += assert_true(file_exists(override_report), "tolerance override report should be created");
-    failures += assert_true(file_contains(override_report, "\"deltaE\": 0.123"), "report should include overridden deltaE");
+    failures += assert_true(report_number_is(override_report, "provenance.appliedTolerances.abs.deltaE", 0.123), "report should include overridden deltaE");
+
+    /* Test columnar artifact format and dump */
+    const char *columnar_artifacts = "tests/output/integration-columnar";
+    const char *columnar_file = "tests/output/integration-columnar/run.cjcol";
+    const char *columnar_report = "tests/output/integration-columnar/report.json";
+    const char *columnar_dump = "tests/output/integration-columnar/dump.json";
+    remove_path(columnar_artifacts);
+
+    snprintf(command, sizeof(command), "./parity-runner --corpus %s --tolerances %s --artifacts %s --artifact-format columnar",
+             "tests/fixtures/test-corpus.json",
+             "tests/fixtures/test-tolerances.json",
+             columnar_artifacts);
+    strncat(command, " --pass-gate 0", sizeof(command) - strlen(command) - 1);
+
+    result = system(command);
+    if (result == -1) {
+        fprintf(stderr, "Failed to spawn parity-runner for columnar format\n");
+        return 1;
+    }
+    exit_code = WEXITSTATUS(result);
+    failures += assert_true(exit_code == 0, "columnar run should exit successfully");
+    failures += assert_true(file_exists(columnar_file), "run.cjcol should be created");
+    failures += assert_true(!file_exists("tests/output/integration-columnar/cases"), "columnar run should not write per-case JSON");
+    failures += assert_true(report_string_is(columnar_report, "artifactFormat", "columnar"), "report should name the artifact format");
+
+    /* A columnar artifact that cannot be written in full must fail the run */
+    if (file_exists("/dev/full")) {
+        const char *full_artifacts = "tests/output/integration-columnar-full";
+        remove_path(full_artifacts);
+        mkdir(full_artifacts, 0755);
+        failures += assert_true(symlink("/dev/full", "tests/output/integration-columnar-full/run.cjcol") == 0, "should link run.cjcol to /dev/full");
+        snprintf(command, sizeof(command), "./parity-runner --corpus %s --tolerances %s --artifacts %s --artifact-format columnar --pass-gate 0 >/dev/null 2>&1",
+                 "tests/fixtures/test-corpus.json",
+                 "tests/fixtures/test-tolerances.json",
+                 full_artifacts);
+        result = system(command);
+        failures += assert_true(result != -1 && WEXITSTATUS(result) != 0, "columnar run on a full device should fail");
+    }
+
+    snprintf(command, sizeof(command), "./parity-runner dump %s --case case-edge --part diff > %s", columnar_file, columnar_dump);
+    result = system(command);
+    failures += assert_true(result != -1 && WEXITSTATUS(result) == 0, "dump should render a columnar case");
+    failures += assert_true(file_contains(columnar_dump, "\"inputCaseId\":\"case-edge\""), "dump should include case id");
+    failures += assert_true(file_contains(columnar_dump, "\"samples\""), "dump should include samples");
+
+    /* Test content-addressed result store and --since incremental runs */
+    const char *store_dir = "tests/output/integration-store";
+    const char *cached_artifacts = "tests/output/integration-cached";
+    const char *cached_report = "tests/output/integration-cached/report.json";
+    const char *since_artifacts = "tests/output/integration-since";
+    const char *since_report = "tests/output/integration-since/report.json";
+    remove_path(store_dir);
+    remove_path(cached_artifacts);
+    remove_path(since_artifacts);
+
+    for (int pass = 0; pass < 2; ++pass) {
+        snprintf(command, sizeof(command), "./parity-runner --corpus %s --tolerances %s --artifacts %s --result-store %s --pass-gate 0",
+                 "tests/fixtures/test-corpus.json",
+                 "tests/fixtures/test-tolerances.json",
+                 cached_artifacts,
+                 store_dir);
+        result = system(command);
+        failures += assert_true(result != -1 && WEXITSTATUS(result) == 0, "result-store run should exit successfully");
+    }
+    failures += assert_true(report_number_is(cached_report, "summary.cacheHits", 2), "second run should be served from the result store");
+    failures += assert_true(file_exists("tests/output/integration-cached/case-hashes.tsv"), "run should write a case hash manifest");
+
+    snprintf(command, sizeof(command), "./parity-runner --corpus %s --tolerances %s --artifacts %s --since %s --result-store %s --pass-gate 0",
+             "tests/fixtures/test-corpus.json",
+             "tests/fixtures/test-tolerances.json",
+             since_artifacts,
+             cached_artifacts,
+             store_dir);
+    result = system(command);
+    failures += assert_true(result != -1 && WEXITSTATUS(result) == 0, "--since run should exit successfully");
+    failures += assert_true(report_number_is(since_report, "summary.unchangedCases", 2), "--since should detect unchanged cases");
+    failures += assert_true(report_number_is(since_report, "summary.totalCases", 2), "--since should carry unchanged cases into totals");
+    failures += assert_true(report_sample_count(since_report) > 0 &&
+                            report_sample_count(since_report) == report_sample_count(cached_report),
+                            "--since stats should include unchanged cases' samples");
+    failures += assert_true(reports_match(since_report, cached_report, "summary.deltaE.mean") &&
+                            reports_match(since_report, cached_report, "summary.deltaE.max") &&
+                            reports_match(since_report, cached_report, "summary.rgbR.max"),
+                            "--since stats should match a full run");
+    failures += assert_true(report_case_count(since_report) == 2, "--since report should list unchanged cases");
+    failures += assert_true(file_exists("tests/output/integration-since/cases/case-edge/diff.json"), "--since should write artifacts for unchanged cases");
+
+    snprintf(command, sizeof(command), "./parity-runner --corpus %s --tolerances %s --artifacts %s --since %s --pass-gate 0 2>/dev/null",
+             "tests/fixtures/test-corpus.json",
+             "tests/fixtures/test-tolerances.json",
+             since_artifacts,
+             cached_artifacts);
+    result = system(command);
+    failures += assert_true(result != -1 && WEXITSTATUS(result) != 0, "--since without a result store should be rejected");
+
+    /* Test --shard partitioning and merge */
+    const char *shard_root = "tests/output/integration-shards";
+    const char *merged_report = "tests/output/integration-shards/merged/report.json";
+    remove_path(shard_root);
+    for (int shard = 0; shard < 2; ++shard) {
+        snprintf(command, sizeof(command), "./parity-runner --corpus %s --tolerances %s --artifacts %s/shard-%d --shard %d/2",
+                 "tests/fixtures/test-corpus.json",
+                 "tests/fixtures/test-tolerances.json",
+                 shard_root,
+                 shard,
+                 shard);
+        result = system(command);
+        failures += assert_true(result != -1 && WEXITSTATUS(result) == 0, "shard run should exit successfully");
+    }
+    failures += assert_true(file_exists("tests/output/integration-shards/shard-0/shard.json"), "shard run should write shard.json");
+
+    snprintf(command, sizeof(command), "./parity-runner merge --out %s/merged --pass-gate 0 %s/shard-0 %s/shard-1",
+             shard_root,
+             shard_root,
+             shard_root);
+    result = system(command);
+    failures += assert_true(result != -1 && WEXITSTATUS(result) == 0, "merge should exit successfully");
+    failures += assert_true(report_number_is(merged_report, "summary.totalCases", 2), "merged report should cover every shard");
+    failures += assert_true(file_exists("tests/output/integration-shards/merged/cases/case-edge/metadata.json"), "merge should carry case artifacts");
+    failures += assert_true(report_case_count(merged_report) == 2, "merged report should list every case");
+    failures += assert_true(report_sample_count(merged_report) == report_sample_count(report_path) &&
+                            reports_match(merged_report, report_path, "summary.deltaE.max"),
+                            "merged stats should match an unsharded run");
+
+    snprintf(command, sizeof(command), "./parity-runner merge --out %s/partial --pass-gate 0 %s/shard-0 2>/dev/null",
+             shard_root,
+             shard_root);
+    result = system(command);
+    failures += assert_true(result != -1 && WEXITSTATUS(result) != 0, "merge should reject a missing shard");
+    snprintf(command, sizeof(command), "./parity-runner merge --out %s/partial --pass-gate 0 --allow-partial %s/shard-0 2>/dev/null",
+             shard_root,
+             shard_root);
+    result = system(command);
+    failures += assert_true(result != -1 && WEXITSTATUS(result) == 0, "merge should accept a missing shard with --allow-partial");
+
+    snprintf(command, sizeof(command), "./parity-runner --corpus %s --tolerances %s --artifacts %s/shard-1-loose --shard 1/2 --tolerance-deltaE 0.9",
+             "tests/fixtures/test-corpus.json",
+             "tests/fixtures/test-tolerances.json",
+             shard_root);
+    result = system(command);
+    failures += assert_true(result != -1 && WEXITSTATUS(result) == 0, "shard run with other tolerances should exit successfully");
+    snprintf(command, sizeof(command), "./parity-runner merge --out %s/mixed %s/shard-0 %s/shard-1-loose 2>/dev/null",
+             shard_root,
+             shard_root,
+             shard_root);
+    result = system(command);
+    failures += assert_true(result != -1 && WEXITSTATUS(result) != 0, "merge should reject shards with different tolerances");
+
+    snprintf(command, sizeof(command), "./parity-runner merge --out %s/dup %s/shard-0 %s/shard-0 2>/dev/null",
+             shard_root,
+             shard_root,
+             shard_root);
+    result = system(command);
+    failures += assert_true(result != -1 && WEXITSTATUS(result) != 0, "merge should reject duplicate shards");
+
+    /* Test generated corpora streamed through stdin */
+    const char *generated_artifacts = "tests/output/integration-generated";
+    const char *generated_report = "tests/output/integration-generated/report.json";
+    remove_path(generated_artifacts);
+    snprintf(command, sizeof(command), "./parity-runner generate --cases 24 --seed 5 | ./parity-runner --corpus - --tolerances %s --artifacts %s --artifact-policy none --pass-gate 0",
+             "tests/fixtures/test-tolerances.json",
+             generated_artifacts);
+    result = system(command);
+    failures += assert_true(result != -1 && WEXITSTATUS(result) == 0, "generated corpus run should exit successfully");
+    failures += assert_true(report_number_is(generated_report, "summary.totalCases", 24), "generated corpus should run every case");
+
+    /* Test peak memory stays bounded on a large corpus (cases are spilled, not retained) */
+    remove_path(generated_artifacts);
+    snprintf(command, sizeof(command), "./parity-runner generate --cases %d --seed 7 | ./parity-runner --corpus - --tolerances %s --artifacts %s --artifact-policy none --pass-gate 0 >/dev/null",
+             RSS_CASES,
+             "tests/fixtures/test-tolerances.json",
+             generated_artifacts);
+    const long peak_rss_kb = peak_rss_of(command);
+    failures += assert_true(peak_rss_kb > 0, "peak RSS run should exit successfully");
+    if (peak_rss_kb > RSS_CEILING_KB) {
+        fprintf(stderr, "peak RSS of %ld KB for %d cases exceeds %d KB\n", peak_rss_kb, RSS_CASES, RSS_CEILING_KB);
+        failures += assert_true(0, "peak RSS should stay under a fixed ceiling");
+    }
 
     return failures == 0 ? 0 : 1;
 }
@@ -4,6 +4,7 @@
 #include <string.h>
 
 #include "types.h"
+#include "stats.h"
 
 static int assert_true(int condition, const char *message) {
     if (!condition) {
@@ -29,6 +30,45 @@ int main(void) {
         failures += assert_true(corpus.case_count == 2, "expected two cases in fixture");
     }
 
+    CorpusStream stream;
+    failures += assert_true(open_corpus_stream("tests/fixtures/test-corpus.jsonl", &stream, &error) == 0,
+                             error.message ? error.message : "jsonl corpus opened");
+    free(error.message);
+    error.message = NULL;
+
+    if (failures == 0) {
+        InputCase input_case;
+        size_t streamed = 0;
+        int status;
+        failures += assert_true(stream.json_lines == 1, "jsonl extension selects JSON Lines mode");
+        failures += assert_true(strcmp(stream.corpus_version, "v20251212.1") == 0,
+                                 "jsonl header supplies corpus version");
+        while ((status = next_corpus_case(&stream, &input_case, &error)) == 1) {
+            failures += assert_true(strcmp(input_case.id, corpus.cases[streamed].id) == 0,
+                                     "streamed case order matches document corpus");
+            failures += assert_true(input_case.config.count == corpus.cases[streamed].config.count,
+                                     "streamed case config matches document corpus");
+            free_input_case(&input_case);
+            streamed++;
+        }
+        failures += assert_true(status == 0 && streamed == 2, "jsonl corpus streams two cases");
+        close_corpus_stream(&stream);
+    }
+
+    InputCase found;
+    failures += assert_true(find_corpus_case("tests/fixtures/test-corpus.json", "case-edge", &found, &error) == 0,
+                             error.message ? error.message : "case found by streaming lookup");
+    free(error.message);
+    error.message = NULL;
+    if (failures == 0) {
+        failures += assert_true(found.anchor_count == 1 && found.seed == 9876, "streamed lookup returns full case");
+        free_input_case(&found);
+    }
+    failures += assert_true(find_corpus_case("tests/fixtures/test-corpus.json", "missing", &found, &error) != 0,
+                             "unknown case id rejected");
+    free(error.message);
+    error.message = NULL;
+
     ToleranceConfig tolerance;
     failures += assert_true(parse_tolerances_file("tests/fixtures/test-tolerances.json", &tolerance, &error) == 0,
                              error.message ? error.message : "tolerances parsed");
@@ -55,6 +95,95 @@ int main(void) {
     double delta = delta_e_oklab(&color_a, &color_b);
     failures += assert_true(delta > 0.0, "delta_e_oklab should compute positive distance");
 
+    /* Streaming sketches: split/merge must equal a single pass, quantiles within alpha */
+    enum { SKETCH_VALUES = 2000 };
+    double values[SKETCH_VALUES];
+    uint64_t lcg = 12345;
+    for (size_t i = 0; i < SKETCH_VALUES; ++i) {
+        lcg = lcg * 6364136223846793005ULL + 1442695040888963407ULL;
+        const double unit = (double)(lcg >> 11) / 9007199254740992.0;
+        values[i] = i % 10 == 0 ? 0.0 : pow(10.0, -6.0 + 6.0 * unit);
+    }
+    MetricSketch whole, left, right;
+    metric_sketch_init(&whole);
+    metric_sketch_init(&left);
+    metric_sketch_init(&right);
+    for (size_t i = 0; i < SKETCH_VALUES; ++i) {
+        metric_sketch_add(&whole, values[i]);
+        metric_sketch_add(i < SKETCH_VALUES / 3 ? &left : &right, values[i]);
+    }
+    failures += assert_true(metric_sketch_merge(&left, &right) == 0, "sketches should merge");
+    failures += assert_true(left.quantiles.count == whole.quantiles.count &&
+                             left.quantiles.zero_count == whole.quantiles.zero_count &&
+                             left.quantiles.bin_count == whole.quantiles.bin_count &&
+                             memcmp(left.quantiles.bins, whole.quantiles.bins,
+                                    whole.quantiles.bin_count * sizeof(uint64_t)) == 0,
+                             "merged quantile bins should equal single-pass bins");
+
+    MetricStats exact, merged;
+    compute_metric_stats(values, SKETCH_VALUES, &exact);
+    metric_sketch_to_stats(&left, &merged);
+    failures += assert_true(fabs(merged.mean - exact.mean) <= 1e-12 * exact.mean, "merged mean matches exact mean");
+    failures += assert_true(fabs(merged.stddev - exact.stddev) <= 1e-9 * exact.stddev, "merged stddev matches exact stddev");
+    failures += assert_true(merged.min == exact.min && merged.max == exact.max, "merged min/max are exact");
+    failures += assert_true(fabs(merged.p50 - exact.p50) <= QUANTILE_SKETCH_DEFAULT_ALPHA * exact.p50, "p50 within sketch accuracy");
+    failures += assert_true(fabs(merged.p95 - exact.p95) <= QUANTILE_SKETCH_DEFAULT_ALPHA * exact.p95, "p95 within sketch accuracy");
+    failures += assert_true(fabs(merged.p99 - exact.p99) <= QUANTILE_SKETCH_DEFAULT_ALPHA * exact.p99, "p99 within sketch accuracy");
+    metric_sketch_free(&whole);
+    metric_sketch_free(&left);
+    metric_sketch_free(&right);
+
+    /* Generated corpora: valid, covering anchor counts and loop modes, slice-reproducible */
+    GeneratorOptions generator = {.seed = 99, .first_case = 0, .case_count = 96, .corpus_version = "v20251212.1"};
+    FILE *generated = fopen("tests/output/generated.jsonl", "w");
+    failures += assert_true(generated && write_generated_corpus(generated, &generator, &error) == 0,
+                             "generator should write a corpus");
+    if (generated) {
+        fclose(generated);
+    }
+    generator.first_case = 50;
+    generator.case_count = 1;
+    generated = fopen("tests/output/generated-slice.jsonl", "w");
+    failures += assert_true(generated && write_generated_corpus(generated, &generator, &error) == 0,
+                             "generator should write a slice");
+    if (generated) {
+        fclose(generated);
+    }
+
+    CorpusStream generated_stream;
+    if (open_corpus_stream("tests/output/generated.jsonl", &generated_stream, &error) == 0) {
+        size_t generated_count = 0;
+        unsigned anchor_counts_seen = 0;
+        unsigned loop_modes_seen = 0;
+        char slice_text[4096] = {0};
+        InputCase input_case;
+        while (next_corpus_case(&generated_stream, &input_case, &error) == 1) {
+            anchor_counts_seen |= 1u << (input_case.anchor_count - 1);
+            loop_modes_seen |= strcmp(input_case.config.loop_mode, "open") == 0 ? 1u
+                             : strcmp(input_case.config.loop_mode, "closed") == 0 ? 2u : 4u;
+            if (generated_count == 50 && generated_stream.text_length < sizeof(slice_text)) {
+                memcpy(slice_text, generated_stream.text, generated_stream.text_length);
+            }
+            generated_count++;
+            free_input_case(&input_case);
+        }
+        close_corpus_stream(&generated_stream);
+        failures += assert_true(generated_count == 96, "generated corpus streams every case");
+        failures += assert_true(anchor_counts_seen == 0xffu, "generated corpus covers anchor counts 1-8");
+        failures += assert_true(loop_modes_seen == 7u, "generated corpus covers every loop mode");
+
+        CorpusStream slice_stream;
+        if (open_corpus_stream("tests/output/generated-slice.jsonl", &slice_stream, &error) == 0) {
+            failures += assert_true(next_corpus_case(&slice_stream, &input_case, &error) == 1 &&
+                                     strcmp(slice_stream.text, slice_text) == 0,
+                                     "generated slice reproduces the same case");
+            free_input_case(&input_case);
+            close_corpus_stream(&slice_stream);
+        }
+    } else {
+        failures += assert_true(0, "generated corpus should open");
+    }
+
     free_tolerances(&tolerance);
     free_corpus(&corpus);
     free(error.message);
@@ -91,3 +91,286 @@ void compute_metric_stats(const double *values, size_t count, MetricStats *out)
 
     free(sorted);
 }
+
+void running_moments_init(RunningMoments *moments) {
+    if (!moments) {
+        return;
+    }
+    memset(moments, 0, sizeof(RunningMoments));
+}
+
+void running_moments_add(RunningMoments *moments, double value) {
+    if (!moments) {
+        return;
+    }
+    if (moments->count == 0) {
+        moments->min = value;
+        moments->max = value;
+    } else {
+        if (value < moments->min) moments->min = value;
+        if (value > moments->max) moments->max = value;
+    }
+    moments->count++;
+    const double delta = value - moments->mean;
+    moments->mean += delta / (double)moments->count;
+    moments->m2 += delta * (value - moments->mean);
+}
+
+void running_moments_merge(RunningMoments *into, const RunningMoments *from) {
+    if (!into || !from || from->count == 0) {
+        return;
+    }
+    if (into->count == 0) {
+        *into = *from;
+        return;
+    }
+    const double n_a = (double)into->count;
+    const double n_b = (double)from->count;
+    const double n = n_a + n_b;
+    const double delta = from->mean - into->mean;
+    into->mean += delta * (n_b / n);
+    into->m2 += from->m2 + delta * delta * (n_a * n_b / n);
+    into->count += from->count;
+    if (from->min < into->min) into->min = from->min;
+    if (from->max > into->max) into->max = from->max;
+}
+
+int quantile_sketch_init(QuantileSketch *sketch, double alpha) {
+    if (!sketch || !(alpha > 0.0 && alpha < 1.0)) {
+        return -1;
+    }
+    memset(sketch, 0, sizeof(QuantileSketch));
+    sketch->alpha = alpha;
+    sketch->gamma = (1.0 + alpha) / (1.0 - alpha);
+    sketch->log_gamma = log(sketch->gamma);
+    return 0;
+}
+
+/* Grow the dense bin array so that `index` is addressable. */
+static int quantile_sketch_reserve(QuantileSketch *sketch, int32_t index) {
+    if (sketch->bin_count == 0) {
+        sketch->bins = (uint64_t *)calloc(1, sizeof(uint64_t));
+        if (!sketch->bins) {
+            return -1;
+        }
+        sketch->bin_count = 1;
+        sketch->min_index = index;
+        return 0;
+    }
+
+    const int32_t max_index = sketch->min_index + (int32_t)sketch->bin_count - 1;
+    if (index >= sketch->min_index && index <= max_index) {
+        return 0;
+    }
+    const int32_t new_min = index < sketch->min_index ? index : sketch->min_index;
+    const int32_t new_max = index > max_index ? index : max_index;
+    const size_t new_count = (size_t)(new_max - new_min) + 1;
+    uint64_t *bins = (uint64_t *)calloc(new_count, sizeof(uint64_t));
+    if (!bins) {
+        return -1;
+    }
+    memcpy(bins + (sketch->min_index - new_min), sketch->bins, sketch->bin_count * sizeof(uint64_t));
+    free(sketch->bins);
+    sketch->bins = bins;
+    sketch->bin_count = new_count;
+    sketch->min_index = new_min;
+    return 0;
+}
+
+int quantile_sketch_add_bin(QuantileSketch *sketch, int32_t index, uint64_t count) {
+    if (!sketch || count == 0) {
+        return sketch ? 0 : -1;
+    }
+    if (quantile_sketch_reserve(sketch, index) != 0) {
+        return -1;
+    }
+    sketch->bins[index - sketch->min_index] += count;
+    sketch->count += count;
+    return 0;
+}
+
+int quantile_sketch_add(QuantileSketch *sketch, double value) {
+    if (!sketch || sketch->gamma <= 1.0 || value < 0.0 || isnan(value)) {
+        return -1;
+    }
+    if (value < QUANTILE_SKETCH_MIN_VALUE) {
+        sketch->zero_count++;
+        sketch->count++;
+        return 0;
+    }
+    const int32_t index = (int32_t)ceil(log(value) / sketch->log_gamma);
+    return quantile_sketch_add_bin(sketch, index, 1);
+}
+
+int quantile_sketch_merge(QuantileSketch *into, const QuantileSketch *from) {
+    if (!into || !from || into->gamma != from->gamma) {
+        return -1;
+    }
+    for (size_t i = 0; i < from->bin_count; ++i) {
+        if (quantile_sketch_add_bin(into, from->min_index + (int32_t)i, from->bins[i]) != 0) {
+            return -1;
+        }
+    }
+    into->zero_count += from->zero_count;
+    into->count += from->zero_count;
+    return 0;
+}
+
+double quantile_sketch_bin_value(const QuantileSketch *sketch, int32_t index) {
+    /* Midpoint in relative terms: within alpha of every value in the bin. */
+    return 2.0 * pow(sketch->gamma, (double)index) / (sketch->gamma + 1.0);
+}
+
+double quantile_sketch_quantile(const QuantileSketch *sketch, double q) {
+    if (!sketch || sketch->count == 0) {
+        return 0.0;
+    }
+    if (q < 0.0) q = 0.0;
+    if (q > 1.0) q = 1.0;
+
+    /* Same nearest-rank convention as compute_metric_stats. */
+    const uint64_t rank = (uint64_t)floor(q * (double)(sketch->count - 1) + 0.5);
+    if (rank < sketch->zero_count) {
+        return 0.0;
+    }
+    uint64_t seen = sketch->zero_count;
+    for (size_t i = 0; i < sketch->bin_count; ++i) {
+        seen += sketch->bins[i];
+        if (rank < seen) {
+            return quantile_sketch_bin_value(sketch, sketch->min_index + (int32_t)i);
+        }
+    }
+    return quantile_sketch_bin_value(sketch, sketch->min_index + (int32_t)sketch->bin_count - 1);
+}
+
+void quantile_sketch_free(QuantileSketch *sketch) {
+    if (!sketch) {
+        return;
+    }
+    free(sketch->bins);
+    sketch->bins = NULL;
+    sketch->bin_count = 0;
+    sketch->min_index = 0;
+    sketch->zero_count = 0;
+    sketch->count = 0;
+}
+
+int metric_sketch_init(MetricSketch *sketch) {
+    if (!sketch) {
+        return -1;
+    }
+    running_moments_init(&sketch->moments);
+    return quantile_sketch_init(&sketch->quantiles, QUANTILE_SKETCH_DEFAULT_ALPHA);
+}
+
+int metric_sketch_add(MetricSketch *sketch, double value) {
+    if (!sketch) {
+        return -1;
+    }
+    running_moments_add(&sketch->moments, value);
+    return quantile_sketch_add(&sketch->quantiles, value);
+}
+
+int metric_sketch_merge(MetricSketch *into, const MetricSketch *from) {
+    if (!into || !from) {
+        return -1;
+    }
+    running_moments_merge(&into->moments, &from->moments);
+    return quantile_sketch_merge(&into->quantiles, &from->quantiles);
+}
+
+static double clamp_to_range(double value, double min_value, double max_value) {
+    if (value < min_value) return min_value;
+    if (value > max_value) return max_value;
+    return value;
+}
+
+void metric_sketch_to_stats(const MetricSketch *sketch, MetricStats *out) {
+    if (!out) {
+        return;
+    }
+    memset(out, 0, sizeof(MetricStats));
+    if (!sketch || sketch->moments.count == 0) {
+        return;
+    }
+    const RunningMoments *m = &sketch->moments;
+    out->mean = m->mean;
+    out->stddev = m->count > 1 ? sqrt(m->m2 / (double)(m->count - 1)) : 0.0;
+    out->min = m->min;
+    out->max = m->max;
+    out->p50 = clamp_to_range(quantile_sketch_quantile(&sketch->quantiles, 0.50), m->min, m->max);
+    out->p95 = clamp_to_range(quantile_sketch_quantile(&sketch->quantiles, 0.95), m->min, m->max);
+    out->p99 = clamp_to_range(quantile_sketch_quantile(&sketch->quantiles, 0.99), m->min, m->max);
+}
+
+int metric_sketch_to_histogram(const MetricSketch *sketch, double min_value, double max_value, size_t bucket_count, Histogram *hist) {
+    if (!sketch || init_histogram(hist, min_value, max_value, bucket_count) != 0) {
+        return -1;
+    }
+    const QuantileSketch *q = &sketch->quantiles;
+    hist->counts[0] += (size_t)q->zero_count;
+    for (size_t i = 0; i < q->bin_count; ++i) {
+        if (q->bins[i] == 0) {
+            continue;
+        }
+        const double value = clamp_to_range(quantile_sketch_bin_value(q, q->min_index + (int32_t)i),
+                                            sketch->moments.min, sketch->moments.max);
+        size_t index = (size_t)((clamp_to_range(value, min_value, max_value) - min_value) / hist->bucket_size);
+        if (index >= hist->bucket_count) {
+            index = hist->bucket_count - 1;
+        }
+        hist->counts[index] += (size_t)q->bins[i];
+    }
+    return 0;
+}
+
+void metric_sketch_free(MetricSketch *sketch) {
+    if (!sketch) {
+        return;
+    }
+    quantile_sketch_free(&sketch->quantiles);
+    running_moments_init(&sketch->moments);
+}
+
+const char *run_metric_name(size_t metric) {
+    /* Matches the summary keys in report.json. */
+    static const char *const names[RUN_METRIC_COUNT] = {"deltaE", "l", "a", "b", "rgbR", "rgbG", "rgbB"};
+    return metric < RUN_METRIC_COUNT ? names[metric] : "unknown";
+}
+
+void init_run_metrics(MetricSketch *sketches) {
+    for (size_t i = 0; i < RUN_METRIC_COUNT; ++i) {
+        metric_sketch_init(&sketches[i]);
+    }
+}
+
+int record_run_metrics(MetricSketch *sketches, const SampleDelta *sample) {
+    int status = 0;
+    status |= metric_sketch_add(&sketches[RUN_METRIC_DELTA_E], fabs(sample->delta.deltaE));
+    status |= metric_sketch_add(&sketches[RUN_METRIC_L], fabs(sample->delta.l));
+    status |= metric_sketch_add(&sketches[RUN_METRIC_A], fabs(sample->delta.a));
+    status |= metric_sketch_add(&sketches[RUN_METRIC_B], fabs(sample->delta.b));
+    status |= metric_sketch_add(&sketches[RUN_METRIC_RGB_R], fabs(sample->rgb_delta.r));
+    status |= metric_sketch_add(&sketches[RUN_METRIC_RGB_G], fabs(sample->rgb_delta.g));
+    status |= metric_sketch_add(&sketches[RUN_METRIC_RGB_B], fabs(sample->rgb_delta.b));
+    return status;
+}
+
+void finalize_run_metrics(const MetricSketch *sketches, RunStats *stats) {
+    metric_sketch_to_stats(&sketches[RUN_METRIC_DELTA_E], &stats->delta_e);
+    metric_sketch_to_stats(&sketches[RUN_METRIC_L], &stats->l);
+    metric_sketch_to_stats(&sketches[RUN_METRIC_A], &stats->a);
+    metric_sketch_to_stats(&sketches[RUN_METRIC_B], &stats->b);
+    metric_sketch_to_stats(&sketches[RUN_METRIC_RGB_R], &stats->rgb_r);
+    metric_sketch_to_stats(&sketches[RUN_METRIC_RGB_G], &stats->rgb_g);
+    metric_sketch_to_stats(&sketches[RUN_METRIC_RGB_B], &stats->rgb_b);
+
+    const double hist_max = stats->delta_e.max > 0.0 ? stats->delta_e.max : 1.0;
+    metric_sketch_to_histogram(&sketches[RUN_METRIC_DELTA_E], 0.0, hist_max, 20, &stats->delta_e_hist);
+}
+
+void free_run_metrics(MetricSketch *sketches) {
+    for (size_t i = 0; i < RUN_METRIC_COUNT; ++i) {
+        metric_sketch_free(&sketches[i]);
+    }
+}
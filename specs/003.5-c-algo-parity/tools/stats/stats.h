@@ -3,9 +3,81 @@
 
 #include "types.h"
 
+// Default relative accuracy for quantile sketches (1%).
+#define QUANTILE_SKETCH_DEFAULT_ALPHA 0.01
+// Magnitudes below this are counted in the sketch's zero bucket.
+#define QUANTILE_SKETCH_MIN_VALUE 1e-12
+
+// Welford running moments; merge() combines partitions exactly (Chan et al.).
+typedef struct {
+    uint64_t count;
+    double mean;
+    double m2;
+    double min;
+    double max;
+} RunningMoments;
+
+// DDSketch over non-negative values: bin i holds values in (gamma^(i-1), gamma^i].
+// Bins are fixed by alpha alone, so sketches with equal alpha merge exactly.
+typedef struct {
+    double alpha;
+    double gamma;
+    double log_gamma;
+    int32_t min_index;
+    uint64_t *bins;
+    size_t bin_count;
+    uint64_t zero_count;
+    uint64_t count;
+} QuantileSketch;
+
+// Mergeable summary of one metric: exact moments plus sketched quantiles.
+typedef struct MetricSketch {
+    RunningMoments moments;
+    QuantileSketch quantiles;
+} MetricSketch;
+
+// Per-run sketches, in RunStats field order.
+enum {
+    RUN_METRIC_DELTA_E,
+    RUN_METRIC_L,
+    RUN_METRIC_A,
+    RUN_METRIC_B,
+    RUN_METRIC_RGB_R,
+    RUN_METRIC_RGB_G,
+    RUN_METRIC_RGB_B,
+    RUN_METRIC_COUNT
+};
+
 int init_histogram(Histogram *hist, double min_value, double max_value, size_t bucket_count);
 void record_histogram(Histogram *hist, double value);
 void free_histogram(Histogram *hist);
 void compute_metric_stats(const double *values, size_t count, MetricStats *out);
 
+void running_moments_init(RunningMoments *moments);
+void running_moments_add(RunningMoments *moments, double value);
+void running_moments_merge(RunningMoments *into, const RunningMoments *from);
+
+int quantile_sketch_init(QuantileSketch *sketch, double alpha);
+int quantile_sketch_add(QuantileSketch *sketch, double value);
+int quantile_sketch_add_bin(QuantileSketch *sketch, int32_t index, uint64_t count);
+int quantile_sketch_merge(QuantileSketch *into, const QuantileSketch *from);
+double quantile_sketch_quantile(const QuantileSketch *sketch, double q);
+double quantile_sketch_bin_value(const QuantileSketch *sketch, int32_t index);
+void quantile_sketch_free(QuantileSketch *sketch);
+
+int metric_sketch_init(MetricSketch *sketch);
+int metric_sketch_add(MetricSketch *sketch, double value);
+int metric_sketch_merge(MetricSketch *into, const MetricSketch *from);
+void metric_sketch_to_stats(const MetricSketch *sketch, MetricStats *out);
+// Fills a fixed-bound histogram from sketch bins (bin representatives, alpha-accurate).
+int metric_sketch_to_histogram(const MetricSketch *sketch, double min_value, double max_value, size_t bucket_count, Histogram *hist);
+void metric_sketch_free(MetricSketch *sketch);
+
+// Helpers over MetricSketch[RUN_METRIC_COUNT]
+const char *run_metric_name(size_t metric);
+void init_run_metrics(MetricSketch *sketches);
+int record_run_metrics(MetricSketch *sketches, const SampleDelta *sample);
+void finalize_run_metrics(const MetricSketch *sketches, RunStats *stats);
+void free_run_metrics(MetricSketch *sketches);
+
 #endif